@@ -0,0 +1,41 @@
+/**
+ * @file boot_trace.h
+ * @brief Timestamps of the boot phases
+ *
+ * Boot code marks the end of each phase with a fixed phase name. Nothing is
+ * printed while booting, since the USB CDC host may not be connected yet;
+ * the trace is printed once the UI is complete and on the "boot" serial
+ * command.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef BOOT_TRACE_H
+#define BOOT_TRACE_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// CONSTANTS AND CONFIGURATION
+// ============================================================================
+
+#define BOOT_TRACE_MAX_MARKS 16  ///< Phases recorded (later marks are dropped)
+
+// ============================================================================
+// BOOT TRACE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Record that a boot phase has ended
+ * @param phase Phase name (must stay valid, e.g. a string literal)
+ */
+void boot_trace_mark(const char *phase);
+
+/**
+ * @brief Print all marks with their time since reset and the phase duration
+ * @param out Output stream (usually Serial)
+ */
+void boot_trace_print(Print &out);
+
+#endif // BOOT_TRACE_H
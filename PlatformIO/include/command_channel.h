@@ -0,0 +1,60 @@
+/**
+ * @file command_channel.h
+ * @brief Serial commands multiplexed with the sample stream
+ *
+ * The serial link hands every text line that does not start with '{' to
+ * command_channel_dispatch() (see serial_link.h), so samples pay nothing for
+ * the extra channel. Commands are looked up in a static table in the ingest
+ * task; anything that touches LVGL or render-owned state is posted to the
+ * render task as a request bit and carried out by command_channel_process().
+ *
+ * Replies are formatted with snprintf into a static buffer, or sent as a
+ * binary telemetry frame (see sample_protocol.h); no heap is used.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef COMMAND_CHANNEL_H
+#define COMMAND_CHANNEL_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// CONSTANTS AND CONFIGURATION
+// ============================================================================
+
+#ifndef COMMAND_RESPONSE_SIZE
+#define COMMAND_RESPONSE_SIZE 1024  ///< Static reply buffer for text responses
+#endif
+
+// ============================================================================
+// COMMAND CHANNEL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Set the task that carries out posted requests
+ * @param render_task Render task handle (woken for every request)
+ */
+void command_channel_init(TaskHandle_t render_task);
+
+/**
+ * @brief Execute one command line (serial link command handler)
+ * @param command NUL-terminated command text
+ * @note Runs in the ingest task
+ */
+void command_channel_dispatch(const char *command);
+
+/**
+ * @brief Send a credit ack to a streaming host if one is due
+ * @note Ingest task only, after serial_link_poll()
+ */
+void command_channel_send_ack();
+
+/**
+ * @brief Carry out requests posted by commands
+ * @note Render task only
+ */
+void command_channel_process();
+
+#endif // COMMAND_CHANNEL_H
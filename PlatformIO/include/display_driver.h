@@ -5,6 +5,10 @@
  * Hardware abstraction for GC9A01 240x240 round LCD display connected
  * via SPI to ESP32-S3. Integrates with LVGL for graphics rendering.
  * 
+ * With DISPLAY_SIMULATOR the same functions are implemented by the native
+ * simulator (src/sim/display_sim.cpp) on an in-memory framebuffer, and the
+ * LovyanGFX device is not declared.
+ * 
  * @author ESP32-S3 Display Project
  * @date 2025
  */
@@ -12,13 +16,20 @@
 #ifndef DISPLAY_DRIVER_H
 #define DISPLAY_DRIVER_H
 
+#ifndef DISPLAY_SIMULATOR
+#define DISPLAY_SIMULATOR 0  ///< 1 = native build without display hardware
+#endif
+
+#if !DISPLAY_SIMULATOR
 #include <LovyanGFX.hpp>
+#endif
 #ifndef LV_CONF_INCLUDE_SIMPLE
 #define LV_CONF_INCLUDE_SIMPLE
 #endif
 #include "lv_conf.h"
 #include <lvgl.h>
 
+#if !DISPLAY_SIMULATOR
 /**
  * @class DisplayDriver
  * @brief Hardware abstraction class for GC9A01 round LCD display
@@ -35,14 +46,63 @@ public:
    * @brief Constructor - configures hardware parameters for ESP32-S3 + GC9A01
    */
   DisplayDriver(void);
+
+  /**
+   * @brief Change the SPI write clock (applied from the next transaction)
+   * @param freq_write_hz New write frequency in Hz
+   * @note No SPI transaction may be open while calling this
+   */
+  void set_write_frequency(uint32_t freq_write_hz);
+
+  /**
+   * @brief Current SPI write clock
+   * @return Write frequency in Hz
+   */
+  uint32_t get_write_frequency();
 };
 
+/**
+ * @brief Pixel type of LVGL's buffers as handed to LovyanGFX
+ * 
+ * The GC9A01 takes big-endian RGB565. With LV_COLOR_16_SWAP LVGL renders
+ * in that order, swap565_t matches the panel's write format and buffers go
+ * out by DMA unchanged. Without it, LovyanGFX byte-swaps every pixel on
+ * the CPU while sending.
+ */
+#if LV_COLOR_16_SWAP
+typedef lgfx::swap565_t display_pixel_t;
+#else
+typedef lgfx::rgb565_t display_pixel_t;
+#endif
+#endif // !DISPLAY_SIMULATOR
+
+/**
+ * @struct display_refresh_stats_t
+ * @brief Per-frame refresh counters reported by LVGL's monitor callback
+ */
+typedef struct {
+  uint32_t frames;         ///< Number of completed screen refreshes
+  uint32_t last_frame_px;  ///< Pixels rendered and flushed by the last refresh
+  uint32_t last_frame_ms;  ///< Duration of the last refresh in milliseconds
+  uint32_t max_frame_px;   ///< Largest single-refresh pixel count seen
+  uint64_t total_px;       ///< Pixels rendered and flushed since boot
+} display_refresh_stats_t;
+
+/**
+ * @brief Observer called after every refresh that flushed pixels
+ * @param frame_us Complete refresh time including flushes (µs)
+ * @param flush_us Time spent inside the flush callback (µs)
+ * @param px Pixels pushed to the panel
+ */
+typedef void (*display_frame_hook_t)(uint32_t frame_us, uint32_t flush_us, uint32_t px);
+
 // ============================================================================
 // GLOBAL FUNCTIONS
 // ============================================================================
 
 /**
  * @brief Initialize the display hardware and LVGL graphics library
+ * @note The boot splash is on the panel before LVGL is initialized
  */
 void display_init();
 
@@ -66,6 +126,28 @@ void backlight_off();
  */
 void lvgl_timer_init();
 
+/**
+ * @brief Enter the blanked low-power mode
+ * 
+ * Stops the LVGL tick interrupt, puts the panel into sleep-in, lowers the
+ * CPU clock and (when the SDK supports it) enables automatic light sleep.
+ * 
+ * @note Render task only; flush the blank frame and turn off the backlight first
+ */
+void display_enter_low_power();
+
+/**
+ * @brief Leave the blanked low-power mode (restores clock, tick and panel)
+ * @note Render task only; redraw before turning the backlight back on
+ */
+void display_exit_low_power();
+
+/**
+ * @brief Whether the low-power mode is active
+ * @return true while LVGL processing is suspended
+ */
+bool display_low_power_active();
+
 /**
  * @brief LVGL display flush callback function
  * @param display_driver Pointer to LVGL display driver structure
@@ -74,12 +156,109 @@ void lvgl_timer_init();
  */
 void display_flush_callback(lv_disp_drv_t *display_driver, const lv_area_t *update_area, lv_color_t *color_buffer);
 
+/**
+ * @brief Reallocate the LVGL draw buffers at runtime
+ * @param buffer_lines Height of each draw buffer in display lines
+ * @param double_buffer true = two DMA buffers with overlapped flush
+ * @return true on success (on allocation failure the previous setup is kept)
+ * @note Must be called from the task that owns LVGL, between refreshes
+ */
+bool display_configure_buffers(uint16_t buffer_lines, bool double_buffer);
+
+/**
+ * @brief Switch to full-frame direct mode with tile diffing
+ * @param use_psram true = framebuffer in PSRAM, false = internal SRAM
+ * @return true on success (on allocation failure the previous setup is kept)
+ * @note Must be called from the task that owns LVGL, between refreshes;
+ *       display_configure_buffers() switches back to partial stripes
+ */
+bool display_configure_full_frame(bool use_psram);
+
+/**
+ * @brief Select how double-buffered stripes are sent with DISPLAY_ROUND_MASK
+ * @param per_span false (default) = one DMA of the whole trimmed stripe,
+ *                 true = one DMA per visible row span (for benchmarking)
+ * @note Blocking single-buffer flushes always send visible spans only
+ */
+void display_set_dma_spans(bool per_span);
+
+/**
+ * @brief Change the SPI write clock at runtime
+ * @param freq_write_hz New write frequency in Hz
+ */
+void display_set_spi_frequency(uint32_t freq_write_hz);
+
+/**
+ * @brief Change the LVGL display refresh period at runtime
+ * @param period_ms Refresh period in milliseconds (LV_DISP_DEF_REFR_PERIOD at boot)
+ */
+void display_set_refresh_period(uint32_t period_ms);
+
+/**
+ * @brief Set the refresh periods used while animating and while idle
+ * @param active_ms Period while animations run (high frame rate)
+ * @param idle_ms Period with nothing animating (single updates, e.g. time text)
+ */
+void display_set_refresh_policy(uint32_t active_ms, uint32_t idle_ms);
+
+/**
+ * @brief Switch between the active and idle refresh period
+ * @param active true while any animation runs
+ * @note Called by the UI when animations start and finish
+ */
+void display_set_refresh_active(bool active);
+
+/**
+ * @brief Register an observer for completed refreshes (NULL to remove)
+ * @param hook Callback invoked in the render task after each refresh
+ */
+void display_set_frame_hook(display_frame_hook_t hook);
+
 // ============================================================================
 // CONSTANTS
 // ============================================================================
 
 #define BACKLIGHT_PIN 6  ///< GPIO pin for display backlight control
 
+#ifndef DISPLAY_SPI_WRITE_HZ
+#define DISPLAY_SPI_WRITE_HZ 27000000  ///< SPI write clock at boot (safe maximum)
+#endif
+
+#ifndef DISPLAY_BUFFER_LINES
+#define DISPLAY_BUFFER_LINES 20  ///< Height of each LVGL draw buffer in display lines
+#endif
+
+#ifndef DISPLAY_DOUBLE_BUFFER
+#define DISPLAY_DOUBLE_BUFFER 1  ///< 1 = two DMA buffers with overlapped flush, 0 = one blocking buffer
+#endif
+
+#ifndef DISPLAY_FULL_FRAME
+#define DISPLAY_FULL_FRAME 0  ///< 0 = partial stripes, 1 = full frame in SRAM, 2 = full frame in PSRAM
+#endif
+
+#ifndef DISPLAY_ROUND_MASK
+#define DISPLAY_ROUND_MASK 1  ///< 1 = render and send only what the round panel shows
+#endif
+
+#define DISPLAY_SPLASH_COLOR 0xFF8203  ///< Boot spinner color (RGB888, METER_GOLDEN_AMBER)
+#define DISPLAY_SPLASH_SIZE  130       ///< Boot spinner diameter in pixels
+#define DISPLAY_SPLASH_WIDTH 8         ///< Boot spinner arc width in pixels
+#define DISPLAY_SPLASH_ARC   120       ///< Boot spinner arc length in degrees
+
+#define DISPLAY_TILE_SIZE 16  ///< Full-frame mode diff granularity (pixels, divides 240)
+
+#ifndef DISPLAY_LOW_POWER_CPU_MHZ
+#define DISPLAY_LOW_POWER_CPU_MHZ 80  ///< CPU clock while blanked (lowest that keeps the PLL/USB happy)
+#endif
+
+#ifndef DISPLAY_REFR_ACTIVE_MS
+#define DISPLAY_REFR_ACTIVE_MS 16   ///< Refresh period while animations run (~60 fps)
+#endif
+
+#ifndef DISPLAY_REFR_IDLE_MS
+#define DISPLAY_REFR_IDLE_MS   100  ///< Refresh period with nothing animating
+#endif
+
 extern const uint16_t SCREEN_WIDTH;   ///< Display width in pixels (240)
 extern const uint16_t SCREEN_HEIGHT;  ///< Display height in pixels (240)
 
@@ -87,6 +266,10 @@ extern const uint16_t SCREEN_HEIGHT;  ///< Display height in pixels (240)
 // GLOBAL INSTANCES
 // ============================================================================
 
+#if !DISPLAY_SIMULATOR
 extern DisplayDriver display;  ///< Global display driver instance
+#endif
+
+extern display_refresh_stats_t display_refresh_stats;  ///< Refresh counters (render task only)
 
 #endif // DISPLAY_DRIVER_H
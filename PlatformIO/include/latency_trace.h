@@ -0,0 +1,127 @@
+/**
+ * @file latency_trace.h
+ * @brief Sample-to-photon latency histograms
+ *
+ * Every decoded sample carries the micros() time its last byte was read
+ * from the serial port. The pipeline stages measure against that stamp:
+ *
+ *   received -> parsed -> applied to the UI -> first area of the next
+ *   frame flushed (rendered) -> last flush of that frame done (photon)
+ *
+ * Each stage keeps a log-scale histogram since the last reset, so p50 and
+ * p99 are available at any time without storing samples. The render and
+ * flush stages only follow samples that moved a visible needle; a sample
+ * without visible change has no photon.
+ *
+ * Hosts can stamp JSON updates with a "ts" field. Once the frame showing a
+ * stamped update is flushed, the display answers "photon: ts=T us=D" with
+ * the host's stamp and the on-device latency D, so the host can measure
+ * the whole path from its own clock.
+ *
+ * Compiled out together with the pipeline statistics (PERF_STATS_ENABLE).
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <Arduino.h>
+#include "perf_stats.h"
+#include "serial_link.h"
+
+// ============================================================================
+// CONSTANTS AND CONFIGURATION
+// ============================================================================
+
+#define LATENCY_SUB_BITS     3    ///< 2^3 buckets per power of two (<= 12.5 % resolution)
+#define LATENCY_SUB_BUCKETS  (1 << LATENCY_SUB_BITS)
+#define LATENCY_MAX_OCTAVE   24   ///< Values from 2^24 µs (16.7 s) share the last bucket
+
+/// Buckets per stage: exact below LATENCY_SUB_BUCKETS µs, then LATENCY_SUB_BUCKETS per octave
+#define LATENCY_BUCKETS      (LATENCY_SUB_BUCKETS * (1 + LATENCY_MAX_OCTAVE - LATENCY_SUB_BITS))
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Measured pipeline stages, each from the sample's receive stamp
+ */
+typedef enum {
+    LATENCY_PARSE = 0,  ///< Decoded and queued (ingest task)
+    LATENCY_APPLY,      ///< Taken from the queue and applied to the UI (render task)
+    LATENCY_RENDER,     ///< First area of the following frame flushed
+    LATENCY_FLUSH,      ///< Last flush of that frame done: pixels on the panel
+    LATENCY_STAGE_COUNT
+} latency_stage_t;
+
+/**
+ * @struct latency_summary_t
+ * @brief Histogram summary of one stage
+ */
+typedef struct {
+    uint32_t count;   ///< Samples recorded since reset
+    uint32_t p50_us;  ///< Median (bucket upper bound)
+    uint32_t p99_us;  ///< 99th percentile (bucket upper bound)
+    uint32_t max_us;  ///< Largest value since reset
+} latency_summary_t;
+
+// ============================================================================
+// LATENCY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Clear all histograms and the pending frame trace
+ */
+void latency_trace_reset();
+
+/**
+ * @brief Record one stage latency
+ * @param stage Stage reached
+ * @param rx_us Receive stamp of the sample (sensor_sample_t::rx_us)
+ * @note Each stage has a single writer task
+ */
+void latency_trace_record(latency_stage_t stage, uint32_t rx_us);
+
+/**
+ * @brief Record that the render task applied a sample (render task)
+ *
+ * A sample that moved a visible needle is followed to the next flushed
+ * frame; if one is already being followed, the older one is kept, so a
+ * frame that shows several samples counts from the oldest.
+ *
+ * @param sample Applied sample
+ * @param visible true if it changed what the next frame shows
+ */
+void latency_trace_applied(const sensor_sample_t *sample, bool visible);
+
+/**
+ * @brief Complete the followed sample after a frame flushed pixels
+ * @param first_flush_us micros() when the frame's first flush started
+ * @param last_flush_us micros() when its last flush returned
+ * @note Called by the display driver from the refresh timer (render task)
+ */
+void latency_trace_frame_flushed(uint32_t first_flush_us, uint32_t last_flush_us);
+
+/**
+ * @brief Send the pending "photon:" echo of a host-stamped sample
+ * @note Render task, outside the refresh so printing never delays a frame
+ */
+void latency_trace_send_echo();
+
+/**
+ * @brief Summarize one stage
+ * @param stage Stage to summarize
+ * @param summary Output summary
+ */
+void latency_trace_get(latency_stage_t stage, latency_summary_t *summary);
+
+/**
+ * @brief Print the summary of every stage
+ * @param out Output stream (usually Serial)
+ */
+void latency_trace_print(Print &out);
+
+#endif // LATENCY_TRACE_H
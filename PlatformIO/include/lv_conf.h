@@ -7,14 +7,19 @@
    COLOR SETTINGS
  *====================*/
 #define LV_COLOR_DEPTH           16
-#define LV_COLOR_16_SWAP         0
+#ifndef LV_COLOR_16_SWAP
+#define LV_COLOR_16_SWAP         1  /*Render in GC9A01 byte order: flush is a straight DMA copy*/
+#endif
 #define LV_COLOR_SCREEN_TRANSP   0
+#define LV_COLOR_CHROMA_KEY      lv_color_hex(0x000000)  /*Black = transparent in cached meter layers*/
 
 /*=========================
    MEMORY SETTINGS
  *=========================*/
 #define LV_MEM_CUSTOM            0
+#ifndef LV_MEM_SIZE
 #define LV_MEM_SIZE              (48U * 1024U)
+#endif
 #define LV_MEM_BUF_MAX_NUM       16
 
 /*====================
@@ -42,28 +47,38 @@
 /*==================
  *   FONT USAGE
  *==================*/
+/* Only the sizes the UI references (include/ui_fonts.h). With
+ * UI_USE_SUBSET_FONTS (set by scripts/font_subset.py) they are replaced by
+ * generated subsets containing just the glyphs the UI draws. */
+#if UI_USE_SUBSET_FONTS
+#define LV_FONT_MONTSERRAT_14    0
+#define LV_FONT_MONTSERRAT_32    0
+#define LV_FONT_CUSTOM_DECLARE   LV_FONT_DECLARE(ui_font_text_14) LV_FONT_DECLARE(ui_font_time_32)
+#define LV_FONT_DEFAULT          &ui_font_text_14
+#else
+#define LV_FONT_MONTSERRAT_14    1
+#define LV_FONT_MONTSERRAT_32    1
+#define LV_FONT_DEFAULT          &lv_font_montserrat_14
+#endif
 #define LV_FONT_MONTSERRAT_8     0
 #define LV_FONT_MONTSERRAT_10    0
 #define LV_FONT_MONTSERRAT_12    0
-#define LV_FONT_MONTSERRAT_14    1
-#define LV_FONT_MONTSERRAT_16    1
-#define LV_FONT_MONTSERRAT_18    1
-#define LV_FONT_MONTSERRAT_20    1  /*<-- Enable this font*/
-#define LV_FONT_MONTSERRAT_22    1
-#define LV_FONT_MONTSERRAT_24    1
-#define LV_FONT_MONTSERRAT_26    1
+#define LV_FONT_MONTSERRAT_16    0
+#define LV_FONT_MONTSERRAT_18    0
+#define LV_FONT_MONTSERRAT_20    0
+#define LV_FONT_MONTSERRAT_22    0
+#define LV_FONT_MONTSERRAT_24    0
+#define LV_FONT_MONTSERRAT_26    0
 #define LV_FONT_MONTSERRAT_28    0
 #define LV_FONT_MONTSERRAT_30    0
-#define LV_FONT_MONTSERRAT_32    1
 #define LV_FONT_MONTSERRAT_34    0
 #define LV_FONT_MONTSERRAT_36    0
-#define LV_FONT_MONTSERRAT_38    1
+#define LV_FONT_MONTSERRAT_38    0
 #define LV_FONT_MONTSERRAT_40    0
 #define LV_FONT_MONTSERRAT_42    0
 #define LV_FONT_MONTSERRAT_44    0
 #define LV_FONT_MONTSERRAT_46    0
 #define LV_FONT_MONTSERRAT_48    0
-#define LV_FONT_DEFAULT          &lv_font_montserrat_14
 #define LV_USE_FONT_PLACEHOLDER  1
 
 /*=================
@@ -122,6 +137,11 @@
 #define LV_USE_TILEVIEW   0
 #define LV_USE_WIN        0
 
+/*-----------
+ * Others
+ *----------*/
+#define LV_USE_SNAPSHOT   1  /*Used to pre-render static meter layers*/
+
 /*-----------
  * Themes
  *----------*/
@@ -0,0 +1,103 @@
+/**
+ * @file metric_history.h
+ * @brief Statically allocated sample history with decimation tiers
+ *
+ * Every metric keeps one ring of points per tier. A point summarizes all
+ * samples received during one tier period (min, max and average); tiers are
+ * 1 s, 10 s and 1 min, so the 1 min tier covers the last few hours in a few
+ * kilobytes. Periods without samples are stored as gap points, unless the
+ * caller knows the values were held (a change-driven host only sends what
+ * moved, and keep-alives while nothing does).
+ *
+ * Points are addressed by absolute index (0 = first point ever stored); a
+ * ring retains the newest HISTORY_CAPACITY of them. Consumers remember the
+ * last index they have seen and only fetch what was added since.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef METRIC_HISTORY_H
+#define METRIC_HISTORY_H
+
+#include <stdint.h>
+#include "metric_registry.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#ifndef HISTORY_CAPACITY
+#define HISTORY_CAPACITY 180  ///< Points retained per metric and tier
+#endif
+
+#define HISTORY_GAP INT16_MIN  ///< avg value of a point without samples
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Decimation tiers
+ */
+typedef enum {
+    HISTORY_TIER_1S = 0,  ///< 1 second points
+    HISTORY_TIER_10S,     ///< 10 second points
+    HISTORY_TIER_1M,      ///< 1 minute points
+    HISTORY_TIER_COUNT
+} history_tier_t;
+
+/**
+ * @struct history_point_t
+ * @brief Summary of the samples of one tier period
+ */
+typedef struct {
+    int16_t min;  ///< Lowest sample
+    int16_t max;  ///< Highest sample
+    int16_t avg;  ///< Average of the samples, HISTORY_GAP if there were none
+} history_point_t;
+
+// ============================================================================
+// HISTORY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Clear all history
+ */
+void metric_history_init();
+
+/**
+ * @brief Add one sample of every metric
+ * @param now_ms Sample time (millis())
+ * @param values Metric values indexed by metric_id_t
+ * @param held Values held since the previous sample (periods without
+ *             samples repeat them), or NULL to store those periods as gaps
+ * @note Render task only; a tier point is stored once its period has ended
+ */
+void metric_history_add(uint32_t now_ms, const int32_t *values, const int32_t *held);
+
+/**
+ * @brief Number of points stored since boot (next absolute index)
+ */
+uint32_t metric_history_total(metric_id_t metric, history_tier_t tier);
+
+/**
+ * @brief Read a point by absolute index
+ * @param index Absolute point index
+ * @param point Receives the point
+ * @return false if the point was not stored yet or already overwritten
+ */
+bool metric_history_get(metric_id_t metric, history_tier_t tier, uint32_t index, history_point_t *point);
+
+/**
+ * @brief Short tier name for display ("1 s", "10 s", "1 min")
+ */
+const char *metric_history_tier_name(history_tier_t tier);
+
+/**
+ * @brief Map a command argument ("1s", "10s", "1m") to its tier
+ * @return Tier, or -1 if unknown
+ */
+int metric_history_find_tier(const char *key);
+
+#endif // METRIC_HISTORY_H
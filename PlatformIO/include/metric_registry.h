@@ -0,0 +1,89 @@
+/**
+ * @file metric_registry.h
+ * @brief Table-driven registry of the metrics shown on the display
+ *
+ * Every metric (CPU temperature, CPU load, ...) is identified by a
+ * metric_id_t and described by one row of metric_descriptors[]. All runtime
+ * state lives in metric_table, a struct-of-arrays indexed by metric ID, so
+ * per-sample processing is a single pass over contiguous arrays.
+ *
+ * Adding a metric:
+ * 1. Add an ID before METRIC_COUNT
+ * 2. Add its meter_config_t in ui_components.h
+ * 3. Add its descriptor row in metric_registry.cpp
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef METRIC_REGISTRY_H
+#define METRIC_REGISTRY_H
+
+#include <lvgl.h>
+
+struct meter_config_t;  // Defined in ui_components.h
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Metric identifiers (index into all registry arrays)
+ */
+typedef enum {
+    METRIC_CPU_TEMP = 0,  ///< CPU temperature in °C
+    METRIC_CPU_LOAD,      ///< CPU load percentage
+    METRIC_COUNT
+} metric_id_t;
+
+#define METRIC_UNKNOWN  -1  ///< metric_lookup_key() result for unknown keys
+
+/**
+ * @struct metric_descriptor_t
+ * @brief Static description of one metric
+ */
+typedef struct {
+    const char *key;                  ///< JSON field name
+    const char *name;                 ///< Name used in log and status output
+    const meter_config_t *config;     ///< Meter appearance and layout
+    uint16_t anim_duration_ms;        ///< Needle animation duration
+} metric_descriptor_t;
+
+/**
+ * @struct metric_table_t
+ * @brief Runtime state of all metrics (struct-of-arrays, render task only)
+ */
+typedef struct {
+    int32_t last_value[METRIC_COUNT];              ///< Last received value (-1 = uninitialized)
+    unsigned long zero_start_time[METRIC_COUNT];   ///< Timestamp when the value became 0
+    bool hidden[METRIC_COUNT];                     ///< Meter hidden by the zero-value rule
+    int32_t needle_value[METRIC_COUNT];            ///< Needle target (motion state in needle_spring)
+    lv_obj_t *meter[METRIC_COUNT];                 ///< Meter widget
+    const meter_config_t *config[METRIC_COUNT];    ///< Active meter configuration
+} metric_table_t;
+
+// ============================================================================
+// GLOBAL STATE
+// ============================================================================
+
+extern const metric_descriptor_t metric_descriptors[METRIC_COUNT];  ///< Metric definitions
+extern metric_table_t metric_table;                                 ///< Metric runtime state
+
+// ============================================================================
+// REGISTRY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Reset runtime state and precompute the key lookup table
+ * @note Must run before the ingest task starts decoding samples
+ */
+void metric_registry_init();
+
+/**
+ * @brief Map a JSON field name to its metric
+ * @param key NUL-terminated field name
+ * @return Metric ID, or METRIC_UNKNOWN
+ */
+int metric_lookup_key(const char *key);
+
+#endif // METRIC_REGISTRY_H
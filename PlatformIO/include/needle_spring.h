@@ -0,0 +1,84 @@
+/**
+ * @file needle_spring.h
+ * @brief Allocation-free, retargetable needle animation
+ *
+ * Every needle is a critically damped spring pulled towards its target:
+ * a new target only changes where the spring pulls, so a needle in motion
+ * keeps its position and velocity and curves smoothly onto the new value
+ * instead of restarting from the previous target. Settling time follows
+ * the requested duration.
+ *
+ * State lives in a static slot per needle, in Q16 fixed point. One LVGL
+ * timer, created at init, advances all moving needles and pauses itself
+ * once every needle has settled; nothing is allocated after that.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef NEEDLE_SPRING_H
+#define NEEDLE_SPRING_H
+
+#include <lvgl.h>
+#include "metric_registry.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#ifndef NEEDLE_SPRING_SLOTS
+#define NEEDLE_SPRING_SLOTS METRIC_COUNT  ///< Needles (slot = metric ID)
+#endif
+
+#define NEEDLE_SPRING_STEP_MS 4  ///< Integration step; ticks are split into steps of this length
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Called with the rounded position whenever a needle moved
+ * @param slot Needle slot
+ * @param value New displayed value
+ */
+typedef void (*needle_spring_apply_t)(uint8_t slot, int32_t value);
+
+/**
+ * @brief Called when the last moving needle has settled
+ */
+typedef void (*needle_spring_idle_t)(void);
+
+// ============================================================================
+// NEEDLE SPRING FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Create the tick timer and reset all slots
+ * @param apply Callback that moves a needle on screen
+ * @param idle Callback when all needles are at rest (may be NULL)
+ * @param period_ms Tick period (the active display refresh period)
+ * @note Call once, after lv_init(), from the task that owns LVGL
+ */
+void needle_spring_init(needle_spring_apply_t apply, needle_spring_idle_t idle, uint32_t period_ms);
+
+/**
+ * @brief Place a needle at a value without animating (stops its motion)
+ * @param slot Needle slot
+ * @param value Position (applied immediately)
+ */
+void needle_spring_set(uint8_t slot, int32_t value);
+
+/**
+ * @brief Pull a needle towards a new target from wherever it is now
+ * @param slot Needle slot
+ * @param target New target value
+ * @param duration_ms Time to settle within 2 % of the distance
+ */
+void needle_spring_retarget(uint8_t slot, int32_t target, uint32_t duration_ms);
+
+/**
+ * @brief Whether any needle is still moving
+ */
+bool needle_spring_running();
+
+#endif // NEEDLE_SPRING_H
@@ -0,0 +1,136 @@
+/**
+ * @file perf_stats.h
+ * @brief Low-overhead frame pipeline instrumentation
+ *
+ * Records timings of the rendering pipeline with the CPU cycle counter into
+ * small rolling windows, so production units can be profiled in place via
+ * the "stats" serial command. Recording costs a few cycles per event; the
+ * whole facility compiles out with -D PERF_STATS_ENABLE=0.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// CONSTANTS AND CONFIGURATION
+// ============================================================================
+
+#ifndef PERF_STATS_ENABLE
+#define PERF_STATS_ENABLE  1   ///< 1 = record pipeline statistics, 0 = compile out
+#endif
+
+#define PERF_WINDOW_SIZE   64  ///< Samples kept per metric (rolling window)
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Instrumented pipeline metrics
+ */
+typedef enum {
+    PERF_FRAME_RENDER = 0,  ///< Frame render time without flushes (µs)
+    PERF_FRAME_TOTAL,       ///< Complete refresh incl. flushes (µs)
+    PERF_FLUSH,             ///< Single flush callback / SPI push (µs)
+    PERF_FRAME_PIXELS,      ///< Pixels flushed per frame
+    PERF_FPS,               ///< Achieved frames per second (per 1 s window)
+    PERF_LVGL_HANDLER,      ///< lv_timer_handler() duration (µs)
+    PERF_LOOP_JITTER,       ///< Render task wake-up lateness (µs)
+    PERF_JSON_PARSE,        ///< JSON line decode time (µs)
+    PERF_METRIC_COUNT
+} perf_metric_t;
+
+/**
+ * @struct perf_summary_t
+ * @brief Summary of one metric over its rolling window
+ */
+typedef struct {
+    uint32_t count;   ///< Total samples recorded since reset
+    uint32_t last;    ///< Most recent sample
+    uint32_t min;     ///< Window minimum
+    uint32_t avg;     ///< Window average
+    uint32_t max;     ///< Window maximum
+    uint32_t peak;    ///< Maximum since reset
+} perf_summary_t;
+
+// ============================================================================
+// RECORDING MACROS
+// ============================================================================
+
+#if PERF_STATS_ENABLE
+#define PERF_TIMESTAMP()              perf_stats_cycles()
+#define PERF_RECORD(metric, start)    perf_stats_record_cycles((metric), perf_stats_cycles() - (start))
+#define PERF_RECORD_VALUE(metric, v)  perf_stats_record_value((metric), (v))
+#define PERF_RECORD_CYCLES(metric, c) perf_stats_record_cycles((metric), (c))
+#else
+#define PERF_TIMESTAMP()              0
+#define PERF_RECORD(metric, start)    ((void)(start))
+#define PERF_RECORD_VALUE(metric, v)  ((void)(v))
+#define PERF_RECORD_CYCLES(metric, c) ((void)(c))
+#endif
+
+// ============================================================================
+// STATISTICS FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Clear all windows and capture the current CPU frequency
+ */
+void perf_stats_init();
+
+/**
+ * @brief Clear all recorded statistics
+ */
+void perf_stats_reset();
+
+/**
+ * @brief Update the cycle-to-microsecond conversion after a CPU clock change
+ * @param mhz New CPU frequency in MHz
+ */
+void perf_stats_set_cpu_mhz(uint32_t mhz);
+
+/**
+ * @brief Read the CPU cycle counter
+ * @return Current cycle count of the calling core
+ */
+uint32_t perf_stats_cycles();
+
+/**
+ * @brief Record a duration measured in CPU cycles (stored in µs)
+ * @param metric Metric to record
+ * @param cycles Elapsed cycles
+ */
+void perf_stats_record_cycles(perf_metric_t metric, uint32_t cycles);
+
+/**
+ * @brief Record a plain value (pixels, FPS, µs)
+ * @param metric Metric to record
+ * @param value Value to store
+ */
+void perf_stats_record_value(perf_metric_t metric, uint32_t value);
+
+/**
+ * @brief Count one completed frame for the FPS metric
+ */
+void perf_stats_frame_done();
+
+/**
+ * @brief Summarize a metric over its rolling window
+ * @param metric Metric to summarize
+ * @param summary Output summary
+ */
+void perf_stats_get(perf_metric_t metric, perf_summary_t *summary);
+
+/**
+ * @brief Print a statistics table including LVGL memory usage
+ * @param out Output stream (usually Serial)
+ * @note Must run in the task that owns LVGL (uses lv_mem_monitor())
+ */
+void perf_stats_print(Print &out);
+
+#endif // PERF_STATS_H
@@ -0,0 +1,47 @@
+/**
+ * @file sample_apply.h
+ * @brief Application of decoded samples to system state and UI
+ * 
+ * The render-task half of the sample pipeline, shared by the firmware
+ * (main.cpp) and the native simulator (sim/sim_main.cpp) so both run the
+ * same steps on every sample taken from the queue.
+ * 
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SAMPLE_APPLY_H
+#define SAMPLE_APPLY_H
+
+#include <Arduino.h>
+#include "serial_link.h"
+
+// ============================================================================
+// SAMPLE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Apply one decoded sample to system state and UI
+ * 
+ * Only the metrics present in the sample are updated; in a partial update
+ * the others hold their last value. A sample that moves a needle is
+ * followed to the frame that shows it (see latency_trace.h).
+ * 
+ * @param sample Decoded sample
+ * @note Render task only (touches LVGL)
+ */
+void sample_apply(const sensor_sample_t *sample);
+
+/**
+ * @brief Apply a keep-alive: the host is alive and every value is unchanged
+ * 
+ * Refreshes the data timeout and, while the display is active, records
+ * the held values into the history, so an idle machine on a change-driven
+ * link keeps a continuous trend. The UI is not touched: the trend view
+ * draws the filled points when the next sample arrives.
+ * 
+ * @note Render task only (touches LVGL)
+ */
+void sample_apply_keepalive();
+
+#endif // SAMPLE_APPLY_H
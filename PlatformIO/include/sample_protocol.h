@@ -0,0 +1,183 @@
+/**
+ * @file sample_protocol.h
+ * @brief Compact binary framed sample protocol shared by firmware and host
+ *
+ * Alternative to the JSON text lines for high update rates. Every frame is
+ * self-delimiting and carries a CRC, so the firmware can auto-detect it per
+ * frame and still accept JSON lines on the same link.
+ *
+ * Frame layout (all multi-byte fields little-endian):
+ *
+ *   +------+--------+------+-------------------+---------+
+ *   | SYNC | LENGTH | TYPE | PAYLOAD (LENGTH)  | CRC16   |
+ *   | 0xA5 | 1 byte | 1 B  | 0..MAX_PAYLOAD B  | 2 bytes |
+ *   +------+--------+------+-------------------+---------+
+ *
+ * The CRC (CRC-16/CCITT-FALSE) covers LENGTH, TYPE and PAYLOAD. The sync
+ * byte is not valid ASCII, so it can never start a JSON line. Types with
+ * the top bit set travel from the display to the host.
+ *
+ * A delta frame carries a sequence number and only the fields that
+ * changed; the display keeps the last value of every other field.
+ *
+ * This header only depends on the C standard library so that host tools
+ * can include it directly.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SAMPLE_PROTOCOL_H
+#define SAMPLE_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// FRAME CONSTANTS
+// ============================================================================
+
+#define SAMPLE_FRAME_SYNC         0xA5  ///< First byte of every binary frame
+#define SAMPLE_FRAME_HEADER_SIZE  3     ///< SYNC + LENGTH + TYPE
+#define SAMPLE_FRAME_CRC_SIZE     2     ///< Trailing CRC16
+#define SAMPLE_FRAME_MAX_PAYLOAD  64    ///< Largest accepted payload in bytes
+#define SAMPLE_FRAME_MAX_SIZE     (SAMPLE_FRAME_HEADER_SIZE + SAMPLE_FRAME_MAX_PAYLOAD + SAMPLE_FRAME_CRC_SIZE)
+
+#define SAMPLE_FRAME_NO_TIME      0xFF  ///< Hour value meaning "time not sent"
+#define SAMPLE_FRAME_NO_SECONDS   0xFF  ///< Second value meaning "show HH:MM"
+
+/**
+ * @brief Binary frame types
+ */
+typedef enum {
+    SAMPLE_FRAME_TYPE_SAMPLE    = 0x01,  ///< Full sample (sample_frame_payload_t)
+    SAMPLE_FRAME_TYPE_KEEPALIVE = 0x02,  ///< No payload: host alive, values unchanged
+    SAMPLE_FRAME_TYPE_DELTA     = 0x03,  ///< Changed fields only (delta_frame_header_t + fields)
+    SAMPLE_FRAME_TYPE_TELEMETRY = 0x81,  ///< Device health, display to host (telemetry_frame_payload_t)
+} sample_frame_type_t;
+
+/**
+ * @brief Metric numbers on the wire (same order as the firmware's metric_id_t)
+ */
+typedef enum {
+    SAMPLE_METRIC_CPU_TEMP = 0,  ///< CPU temperature in °C
+    SAMPLE_METRIC_CPU_LOAD = 1,  ///< CPU load percentage
+} sample_metric_t;
+
+#define SAMPLE_DELTA_TIME           0x0001u               ///< Delta carries hour, minute, second
+#define SAMPLE_DELTA_METRIC(metric) (0x0002u << (metric)) ///< Delta carries this metric
+#define SAMPLE_DELTA_MAX_METRICS    15                    ///< Metric bits in delta_frame_header_t
+
+// ============================================================================
+// PAYLOAD LAYOUTS
+// ============================================================================
+
+/**
+ * @struct sample_frame_payload_t
+ * @brief Payload of SAMPLE_FRAME_TYPE_SAMPLE (6 bytes)
+ *
+ * Decoded in place as a zero-copy view of the receive buffer.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t hour;      ///< 0-23, or SAMPLE_FRAME_NO_TIME
+    uint8_t minute;    ///< 0-59
+    uint8_t second;    ///< 0-59, or SAMPLE_FRAME_NO_SECONDS
+    uint8_t cpu_load;  ///< CPU load percentage 0-100
+    int16_t cpu_temp;  ///< CPU temperature in °C
+} sample_frame_payload_t;
+
+/**
+ * @struct delta_frame_header_t
+ * @brief Start of a SAMPLE_FRAME_TYPE_DELTA payload (6 bytes)
+ *
+ * Followed by the fields flagged in fields, in bit order:
+ * - SAMPLE_DELTA_TIME: hour, minute, second (3 bytes, as in
+ *   sample_frame_payload_t)
+ * - SAMPLE_DELTA_METRIC(n): int16_t value of metric n, lowest n first
+ *
+ * seq increases by one per update (samples and deltas, not keep-alives),
+ * so the display can count lost updates and drop late ones.
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t seq;     ///< Sequence number
+    uint16_t fields;  ///< SAMPLE_DELTA_* bits of the fields that follow
+} delta_frame_header_t;
+
+/**
+ * @struct telemetry_frame_payload_t
+ * @brief Payload of SAMPLE_FRAME_TYPE_TELEMETRY (64 bytes)
+ *
+ * Sent by the display in reply to the "telemetry" command, so a host can
+ * poll device health without parsing text. Averages are over the firmware's
+ * rolling statistics window; counters run since boot. The latency
+ * percentiles are receive-to-flush ("latency" command) since the last
+ * statistics reset.
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t uptime_ms;         ///< Time since boot
+    uint32_t frames;            ///< Display refreshes since boot
+    uint16_t fps;               ///< Average frames per second
+    uint16_t render_avg_us;     ///< Average frame render time without flushes
+    uint16_t flush_avg_us;      ///< Average flush (SPI push) time
+    uint8_t lvgl_used_pct;      ///< LVGL heap in use
+    uint8_t lvgl_frag_pct;      ///< LVGL heap fragmentation
+    uint32_t heap_free;         ///< Free 8-bit capable heap
+    uint32_t heap_min_free;     ///< Lowest free heap since boot
+    uint32_t heap_largest;      ///< Largest allocatable heap block
+    uint32_t lvgl_max_used;     ///< LVGL heap high-water mark in bytes
+    uint32_t samples_decoded;   ///< Samples decoded from lines and frames
+    uint32_t lines_garbage;     ///< Lines with control bytes or invalid JSON
+    uint32_t lines_overlong;    ///< Lines longer than the receive buffer
+    uint32_t frames_crc_error;  ///< Binary frames with CRC mismatch
+    uint32_t frames_invalid;    ///< Binary frames with bad length, type or size
+    uint32_t queue_dropped;     ///< Samples dropped by the full render queue
+    uint32_t latency_p50_us;    ///< Median sample receive-to-flush latency
+    uint32_t latency_p99_us;    ///< 99th percentile sample receive-to-flush latency
+} telemetry_frame_payload_t;
+
+// ============================================================================
+// HELPER FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Compute CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ * @param data Bytes to checksum
+ * @param length Number of bytes
+ * @return CRC value
+ */
+static inline uint16_t sample_frame_crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Encode a complete frame into a caller-provided buffer
+ * @param out Output buffer (at least SAMPLE_FRAME_MAX_SIZE bytes)
+ * @param type Frame type
+ * @param payload Payload bytes
+ * @param length Payload length (at most SAMPLE_FRAME_MAX_PAYLOAD)
+ * @return Total frame size in bytes, or 0 if the payload is too large
+ */
+static inline size_t sample_frame_encode(uint8_t *out, uint8_t type, const void *payload, uint8_t length) {
+    if (length > SAMPLE_FRAME_MAX_PAYLOAD) {
+        return 0;
+    }
+    out[0] = SAMPLE_FRAME_SYNC;
+    out[1] = length;
+    out[2] = type;
+    memcpy(&out[SAMPLE_FRAME_HEADER_SIZE], payload, length);
+
+    uint16_t crc = sample_frame_crc16(&out[1], (size_t)length + 2);
+    out[SAMPLE_FRAME_HEADER_SIZE + length] = (uint8_t)(crc & 0xFF);
+    out[SAMPLE_FRAME_HEADER_SIZE + length + 1] = (uint8_t)(crc >> 8);
+    return (size_t)SAMPLE_FRAME_HEADER_SIZE + length + SAMPLE_FRAME_CRC_SIZE;
+}
+
+#endif // SAMPLE_PROTOCOL_H
@@ -0,0 +1,101 @@
+/**
+ * @file sample_queue.h
+ * @brief Lock-free single-producer/single-consumer sample queue
+ * 
+ * Hands decoded samples from the serial ingest task (producer, core 0) to
+ * the render task (consumer, core 1) without locks or heap allocation.
+ * Exactly one task may push and exactly one task may pop.
+ * 
+ * When the render side falls behind, the _latest variants coalesce
+ * instead of dropping: the producer holds back one sample and merges
+ * newer ones into it until a slot is free, and the consumer merges
+ * everything queued into one sample. Only the latest value of each metric
+ * is applied, so display latency stays bounded under any input rate.
+ * 
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SAMPLE_QUEUE_H
+#define SAMPLE_QUEUE_H
+
+#include <Arduino.h>
+#include "serial_link.h"
+
+// ============================================================================
+// CONSTANTS AND CONFIGURATION
+// ============================================================================
+
+#ifndef SAMPLE_QUEUE_LENGTH
+#define SAMPLE_QUEUE_LENGTH 8  ///< Queue capacity in samples (must be a power of two)
+#endif
+
+// ============================================================================
+// QUEUE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Reset the queue to empty (call before the tasks start)
+ */
+void sample_queue_init();
+
+/**
+ * @brief Append a sample (producer side only)
+ * @param sample Sample to copy into the queue
+ * @return false if the queue was full and the sample was dropped
+ */
+bool sample_queue_push(const sensor_sample_t *sample);
+
+/**
+ * @brief Append a sample, coalescing while the queue is full (producer side only)
+ * @param sample Sample to copy into the queue
+ * @return true if a sample was published; false if it is held back until
+ *         a later push or sample_queue_flush()
+ */
+bool sample_queue_push_latest(const sensor_sample_t *sample);
+
+/**
+ * @brief Publish the held-back sample if a slot is free (producer side only)
+ * @return true if a sample was published
+ */
+bool sample_queue_flush();
+
+/**
+ * @brief Whether a sample is held back by sample_queue_push_latest()
+ * @return true until sample_queue_flush() or a push publishes it
+ */
+bool sample_queue_pending();
+
+/**
+ * @brief Remove the oldest sample (consumer side only)
+ * @param sample Output sample
+ * @return false if the queue was empty
+ */
+bool sample_queue_pop(sensor_sample_t *sample);
+
+/**
+ * @brief Remove all queued samples merged into one (consumer side only)
+ * @param sample Output sample with the latest value of every metric carried
+ * @return false if the queue was empty
+ */
+bool sample_queue_pop_latest(sensor_sample_t *sample);
+
+/**
+ * @brief Number of queued samples (either side)
+ * @return Samples waiting for the consumer
+ */
+uint32_t sample_queue_depth();
+
+/**
+ * @brief Number of samples merged into a newer one by the _latest variants
+ * @return Coalesce counter since sample_queue_init()
+ */
+uint32_t sample_queue_coalesced();
+
+/**
+ * @brief Number of samples dropped because the queue was full
+ * @return Drop counter since sample_queue_init()
+ */
+uint32_t sample_queue_dropped();
+
+#endif // SAMPLE_QUEUE_H
@@ -0,0 +1,211 @@
+/**
+ * @file serial_link.h
+ * @brief Non-blocking serial data ingestion for ESP32-S3 monitoring display
+ *
+ * Assembles incoming serial bytes into complete JSON lines or binary frames
+ * (see sample_protocol.h) using fixed-size static buffers, without blocking
+ * and without heap allocation, and decodes them into monitoring samples.
+ * The format is auto-detected per line/frame. Text lines that do not start
+ * with '{' are treated as commands and handed to a command handler; a
+ * binary keep-alive frame is handed over as the "keepalive" command.
+ * Malformed input is counted, not hidden.
+ *
+ * Sequenced updates (JSON "seq" field or delta frames) carry only the
+ * fields that changed. Their sequence numbers are checked here: gaps are
+ * counted as lost updates and late updates are dropped before they reach
+ * the render task.
+ *
+ * Streaming hosts enable credit acks with the "stream" command. The link
+ * then acknowledges every SERIAL_ACK_INTERVAL accepted updates, and the
+ * host keeps at most the granted credits of updates in flight. This bounds
+ * the backlog in the USB receive buffer no matter how fast the host sends.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SERIAL_LINK_H
+#define SERIAL_LINK_H
+
+#include <Arduino.h>
+#include "metric_registry.h"
+
+// ============================================================================
+// CONSTANTS AND CONFIGURATION
+// ============================================================================
+
+#ifndef SERIAL_LINE_BUFFER_SIZE
+#define SERIAL_LINE_BUFFER_SIZE  256  ///< Maximum line length in bytes (longer lines are discarded)
+#endif
+
+#ifndef SERIAL_MAX_BYTES_PER_POLL
+#define SERIAL_MAX_BYTES_PER_POLL 512 ///< Upper bound of bytes drained per poll call
+#endif
+
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE    1024 ///< USB CDC receive buffer in bytes (Serial.setRxBufferSize)
+#endif
+
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE    2048 ///< USB CDC transmit ring in bytes (holds a full text reply)
+#endif
+
+#ifndef SERIAL_TX_TIMEOUT_MS
+#define SERIAL_TX_TIMEOUT_MS     50   ///< Longest wait for the TX lock and ring space while a host is connected
+#endif
+
+#define SAMPLE_TIME_TEXT_SIZE    16   ///< Storage for the "HH:MM:SS" time text
+
+#define SERIAL_KEEPALIVE_COMMAND "keepalive"  ///< Text form of a keep-alive
+
+#ifndef SERIAL_SEQ_STALE_WINDOW
+#define SERIAL_SEQ_STALE_WINDOW  64   ///< Older sequence numbers within this distance are dropped as late
+#endif
+
+#ifndef SERIAL_CREDIT_WINDOW
+#define SERIAL_CREDIT_WINDOW     8    ///< Updates a streaming host may send ahead of the last ack
+#endif
+
+#define SERIAL_ACK_INTERVAL      (SERIAL_CREDIT_WINDOW / 2)  ///< Accepted updates per ack while streaming
+
+#define SAMPLE_ALL_METRICS  ((1u << METRIC_COUNT) - 1)  ///< sensor_sample_t::present of a full sample
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @struct sensor_sample_t
+ * @brief One decoded monitoring sample
+ */
+typedef struct {
+    char time[SAMPLE_TIME_TEXT_SIZE];  ///< Time text ("HH:MM:SS"), empty if not sent
+    int32_t values[METRIC_COUNT];      ///< Metric values indexed by metric_id_t (0 if not sent)
+    uint32_t present;                  ///< Bit (1 << metric_id_t) of every metric carried
+    uint32_t seq;                      ///< Sequence number (valid if has_seq)
+    bool has_seq;                      ///< Sample is a sequenced update
+    uint32_t rx_us;                    ///< micros() when its last byte was read (latency_trace.h)
+    uint32_t host_ts;                  ///< Host stamp, JSON "ts" field (valid if has_ts)
+    bool has_ts;                       ///< Host asked for a "photon:" echo of this sample
+} sensor_sample_t;
+
+/**
+ * @struct serial_link_stats_t
+ * @brief Ingestion counters for diagnostics
+ */
+typedef struct {
+    uint32_t bytes_received;   ///< Total bytes drained from the serial port
+    uint32_t lines_received;   ///< Complete lines handed to the decoder
+    uint32_t samples_decoded;  ///< Lines and frames successfully decoded into samples
+    uint32_t lines_overlong;   ///< Lines discarded for exceeding SERIAL_LINE_BUFFER_SIZE
+    uint32_t lines_garbage;    ///< Lines with control bytes or invalid JSON
+    uint32_t frames_received;  ///< Binary frames with valid CRC
+    uint32_t frames_crc_error; ///< Binary frames discarded for CRC mismatch
+    uint32_t frames_invalid;   ///< Binary frames with bad length, type or payload size
+    uint32_t commands_received; ///< Text lines dispatched as commands
+    uint32_t keepalives_received; ///< Keep-alive frames and "keepalive" commands
+    uint32_t seq_lost;         ///< Updates missing from gaps in the sequence numbers
+    uint32_t seq_stale;        ///< Late or repeated updates dropped
+    uint32_t seq_resyncs;      ///< Sequence restarts accepted (host restarted)
+    uint32_t acks_sent;        ///< Credit acks sent to a streaming host
+} serial_link_stats_t;
+
+/**
+ * @brief Callback invoked for every decoded sample
+ * @param sample Pointer to decoded sample (valid only during the call)
+ */
+typedef void (*sample_handler_t)(const sensor_sample_t *sample);
+
+/**
+ * @brief Callback invoked for every command line
+ * @param command NUL-terminated command text, trailing whitespace removed
+ *                (valid only during the call)
+ */
+typedef void (*command_handler_t)(const char *command);
+
+// ============================================================================
+// GLOBAL STATE
+// ============================================================================
+
+extern serial_link_stats_t serial_link_stats;  ///< Ingestion counters
+
+// ============================================================================
+// SERIAL LINK FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Reset line assembler state and counters
+ */
+void serial_link_init();
+
+/**
+ * @brief Register the handler for command lines
+ * @param handler Callback invoked from serial_link_poll() for each command,
+ *                or NULL to ignore commands
+ */
+void serial_link_set_command_handler(command_handler_t handler);
+
+/**
+ * @brief Drain available serial bytes and dispatch complete lines
+ * @param handler Callback invoked for each decoded sample
+ */
+void serial_link_poll(sample_handler_t handler);
+
+/**
+ * @brief Forget the sequence of the previous host
+ *
+ * Called when a host announces itself with "link": a restarted host
+ * counts from its own start again, which may lie just behind the old
+ * sequence and would otherwise be dropped as late. The next sequenced
+ * update is accepted as is and counted as a resync.
+ *
+ * @note Ingest task only
+ */
+void serial_link_reset_sequence();
+
+/**
+ * @brief Enable or disable credit acks for a streaming host
+ * @param enabled true = acknowledge accepted updates (the first ack is due at once)
+ */
+void serial_link_set_acks(bool enabled);
+
+/**
+ * @brief Check whether an ack should be sent now
+ * @param seq Output: last accepted sequence number (0 if none yet)
+ * @return true once per SERIAL_ACK_INTERVAL accepted updates while acks are enabled
+ * @note Ingest task only; the caller sends the ack and counts it in acks_sent
+ */
+bool serial_link_ack_due(uint32_t *seq);
+
+/**
+ * @brief Merge a newer sample into an older one
+ *
+ * Metrics and time carried by newer replace those in into; the others keep
+ * their value, so the result is the latest state of every metric. The
+ * receive and host stamps are those of newer.
+ *
+ * @param into Older sample, updated in place
+ * @param newer Newer sample
+ */
+void serial_link_merge_sample(sensor_sample_t *into, const sensor_sample_t *newer);
+
+/**
+ * @brief Decode a JSON sample line in place
+ * @param line Mutable, NUL-terminated line buffer (modified by the parser)
+ * @param length Line length in bytes
+ * @param sample Output sample structure
+ * @return true if the line was valid JSON
+ */
+bool serial_link_parse_json(char *line, size_t length, sensor_sample_t *sample);
+
+/**
+ * @brief Decode a CRC-checked binary frame
+ * @param type Frame type byte
+ * @param payload Pointer to payload bytes inside the receive buffer
+ * @param length Payload length in bytes
+ * @param sample Output sample structure
+ * @return true if the frame carried a sample
+ */
+bool serial_link_parse_frame(uint8_t type, const uint8_t *payload, size_t length, sensor_sample_t *sample);
+
+#endif // SERIAL_LINK_H
@@ -0,0 +1,66 @@
+/**
+ * @file sparkline.h
+ * @brief Incrementally scrolling trend chart of one metric history tier
+ *
+ * A sparkline owns a pixel buffer with one column per history point (newest
+ * on the right). New points shift the buffer left and draw only the new
+ * columns; the series is rebuilt from the history only when the source
+ * changes or more points arrived than fit on screen. Each column shows the
+ * min..max range of its point with the average highlighted.
+ *
+ * Unlike lv_chart, no per-point objects or series arrays are kept and no
+ * memory is allocated after creation.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <lvgl.h>
+#include "metric_history.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#ifndef SPARKLINE_MAX_INSTANCES
+#define SPARKLINE_MAX_INSTANCES METRIC_COUNT  ///< Sparklines that can be created
+#endif
+
+// ============================================================================
+// SPARKLINE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Create a sparkline widget
+ * @param parent Parent object
+ * @param width Width in pixels (one column per point)
+ * @param height Height in pixels
+ * @param avg_color Color of the average line
+ * @param range_color Color of the min..max band
+ * @return Widget object, or NULL if no instance or buffer was available
+ */
+lv_obj_t *sparkline_create(lv_obj_t *parent, lv_coord_t width, lv_coord_t height,
+                           lv_color_t avg_color, lv_color_t range_color);
+
+/**
+ * @brief Select the history shown and its value range, and redraw it
+ * @param obj Sparkline created by sparkline_create()
+ * @param metric Metric to show
+ * @param tier History tier to show
+ * @param value_min Value at the bottom edge
+ * @param value_max Value at the top edge
+ */
+void sparkline_set_source(lv_obj_t *obj, metric_id_t metric, history_tier_t tier,
+                          int32_t value_min, int32_t value_max);
+
+/**
+ * @brief Scroll in the points added to the history since the last call
+ * @param obj Sparkline created by sparkline_create()
+ * @return true if the widget changed (and was invalidated)
+ */
+bool sparkline_sync(lv_obj_t *obj);
+
+#endif // SPARKLINE_H
@@ -0,0 +1,47 @@
+/**
+ * @file sprite_gauge.h
+ * @brief LovyanGFX sprite fast path for drawing meters
+ *
+ * Alternative to LVGL's lv_meter draw path, selected per meter with
+ * meter_config_t::renderer = METER_RENDERER_SPRITE. The dial face is the
+ * pre-rendered static layer of the meter (see meter_layer_cache_t), wrapped
+ * in a sprite without copying; the needle is pre-rendered once into a small
+ * sprite. Each frame the face and the rotated needle are composited with
+ * LovyanGFX straight into LVGL's draw buffer, so objects on top of the meter
+ * (center button, time display) are still drawn and flushed by LVGL.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SPRITE_GAUGE_H
+#define SPRITE_GAUGE_H
+
+#include <lvgl.h>
+#include "ui_components.h"
+
+// ============================================================================
+// SPRITE GAUGE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Prepare the sprite renderer for a cached meter
+ * @param cache Meter layer cache providing the face pixels
+ * @param config Meter configuration (needle width and color)
+ * @param needle_length Needle length in pixels from the scale center
+ * @return true if the sprites were created; false leaves the LVGL path active
+ * @note Call again after the cache was re-rendered
+ */
+bool sprite_gauge_attach(meter_layer_cache_t *cache, const meter_config_t *config, lv_coord_t needle_length);
+
+/**
+ * @brief Draw face and needle of a sprite-rendered meter
+ * @param cache Meter layer cache with attached sprite renderer
+ * @param draw_ctx LVGL draw context of the current refresh area
+ * @param center Needle pivot (scale center) in screen coordinates
+ * @param angle Needle angle in degrees (LVGL convention: 0 = 3 o'clock, clockwise)
+ */
+void sprite_gauge_draw(const meter_layer_cache_t *cache, lv_draw_ctx_t *draw_ctx,
+                       const lv_point_t *center, int32_t angle);
+
+#endif // SPRITE_GAUGE_H
@@ -14,6 +14,7 @@
 #define SYSTEM_MANAGER_H
 
 #include <Arduino.h>
+#include "metric_registry.h"
 
 // ============================================================================
 // CONSTANTS AND CONFIGURATION
@@ -30,13 +31,8 @@
 extern unsigned long sys_last_data_received_time;   ///< Timestamp of last valid data reception
 extern bool sys_first_data_received;                ///< Flag: true after first valid JSON data
 
-// Meter hiding system state
-extern unsigned long sys_cpu_temp_zero_start_time;  ///< Timestamp when CPU temp became 0
-extern unsigned long sys_cpu_load_zero_start_time;  ///< Timestamp when CPU load became 0
-extern bool sys_cpu_temp_meter_hidden;              ///< Flag: true when temp meter is hidden
-extern bool sys_cpu_load_meter_hidden;              ///< Flag: true when load meter is hidden
-extern int sys_last_cpu_temp;                       ///< Last received CPU temperature value
-extern int sys_last_cpu_load;                       ///< Last received CPU load value
+// Meter hiding system state is kept per metric in metric_table
+// (last_value, zero_start_time, hidden - see metric_registry.h)
 
 // Display power management state
 extern bool sys_display_blanked;                    ///< Flag: true when display is blanked
@@ -56,10 +52,18 @@ void system_manager_init();
 
 /**
  * @brief Process new system monitoring data
- * @param cpu_temp Current CPU temperature (0-100°C)
- * @param cpu_load Current CPU load percentage (0-100%)
+ * @param values Current metric values indexed by metric_id_t
+ * @param present Bit (1 << metric_id_t) of every metric carried; the others keep their state
  */
-void system_process_data(int cpu_temp, int cpu_load);
+void system_process_data(const int32_t *values, uint32_t present);
+
+/**
+ * @brief Refresh the data timeout for a keep-alive
+ *
+ * The host is alive and the last values still hold: no meter, time or
+ * display state is touched.
+ */
+void system_process_keepalive();
 
 /**
  * @brief Handle first valid data reception
@@ -72,45 +76,22 @@ void system_handle_first_data();
 
 /**
  * @brief Update meter hiding logic based on new data values
- * @param cpu_temp Current CPU temperature (0-100)
- * @param cpu_load Current CPU load percentage (0-100)
- */
-void system_update_meter_values(int cpu_temp, int cpu_load);
-
-/**
- * @brief Check if meters should be hidden due to prolonged zero values
- */
-void system_check_meter_hiding_conditions();
-
-/**
- * @brief Hide CPU temperature meter
- */
-void system_hide_cpu_temp_meter();
-
-/**
- * @brief Show CPU temperature meter
- */
-void system_show_cpu_temp_meter();
-
-/**
- * @brief Hide CPU load meter
+ * @param values Current metric values indexed by metric_id_t
+ * @param present Bit (1 << metric_id_t) of every metric carried
  */
-void system_hide_cpu_load_meter();
+void system_update_meter_values(const int32_t *values, uint32_t present);
 
 /**
- * @brief Show CPU load meter
+ * @brief Hide or show a metric's meter
+ * @param metric Metric whose meter is changed
+ * @param hidden true to hide, false to show
  */
-void system_show_cpu_load_meter();
+void system_set_meter_hidden(metric_id_t metric, bool hidden);
 
 // ============================================================================
 // DISPLAY POWER MANAGEMENT SYSTEM
 // ============================================================================
 
-/**
- * @brief Check if display should be blanked due to data timeout
- */
-void system_check_data_timeout();
-
 /**
  * @brief Blank entire display to save power
  */
@@ -126,14 +107,26 @@ void system_show_entire_display();
 // ============================================================================
 
 /**
- * @brief Perform periodic system maintenance tasks
+ * @brief Run the system manager deadlines that have expired
+ * 
+ * The meter hiding and data timeouts are one-shot deadlines armed and
+ * cancelled by incoming data; this only does work once one is due.
  */
 void system_periodic_update();
 
 /**
- * @brief Get system status information
- * @return String containing current system status
+ * @brief Time until the next system manager timeout can expire
+ * @return Milliseconds until the earliest armed deadline, UINT32_MAX if none
+ */
+uint32_t system_ms_until_next_deadline();
+
+/**
+ * @brief Format system status information into a buffer
+ * @param buffer Output buffer (always NUL-terminated)
+ * @param size Buffer size in bytes
+ * @return Length of the text written (truncated if the buffer is too small)
+ * @note Render task only
  */
-String system_get_status();
+size_t system_format_status(char *buffer, size_t size);
 
 #endif // SYSTEM_MANAGER_H
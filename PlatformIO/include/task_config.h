@@ -0,0 +1,63 @@
+/**
+ * @file task_config.h
+ * @brief FreeRTOS task layout for the dual-core processing pipeline
+ * 
+ * The ESP32-S3 runs two pinned tasks:
+ * - Ingest task (core 0): drains the serial port and decodes samples
+ * - Render task (core 1): owns every LVGL call, applies samples, renders
+ * 
+ * Samples travel between them through the lock-free queue in
+ * sample_queue.h. Both tasks are event driven: the ingest task sleeps until
+ * the USB CDC RX event fires, the render task sleeps until a sample is
+ * queued or the next LVGL / system manager deadline is due.
+ * All values may be overridden via build_flags.
+ * 
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef TASK_CONFIG_H
+#define TASK_CONFIG_H
+
+// ============================================================================
+// INGEST TASK (SERIAL READ + DECODE)
+// ============================================================================
+
+#ifndef INGEST_TASK_CORE
+#define INGEST_TASK_CORE        0     ///< Core the ingest task is pinned to
+#endif
+
+#ifndef INGEST_TASK_STACK_SIZE
+#define INGEST_TASK_STACK_SIZE  4096  ///< Ingest task stack in bytes
+#endif
+
+#ifndef INGEST_TASK_PRIORITY
+#define INGEST_TASK_PRIORITY    2     ///< Ingest task FreeRTOS priority
+#endif
+
+#ifndef INGEST_IDLE_TIMEOUT_MS
+#define INGEST_IDLE_TIMEOUT_MS  1000  ///< Safety re-poll if an RX event was missed
+#endif
+
+#ifndef INGEST_RETRY_MS
+#define INGEST_RETRY_MS         2     ///< Re-poll delay while a coalesced sample waits for a queue slot
+#endif
+
+// ============================================================================
+// RENDER TASK (SYSTEM LOGIC + LVGL)
+// ============================================================================
+
+#ifndef RENDER_TASK_CORE
+#define RENDER_TASK_CORE        1     ///< Core the render task is pinned to
+#endif
+
+#ifndef RENDER_TASK_STACK_SIZE
+#define RENDER_TASK_STACK_SIZE  8192  ///< Render task stack in bytes
+#endif
+
+#ifndef RENDER_TASK_PRIORITY
+#define RENDER_TASK_PRIORITY    1     ///< Render task FreeRTOS priority
+#endif
+
+
+#endif // TASK_CONFIG_H
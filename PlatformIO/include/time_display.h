@@ -0,0 +1,60 @@
+/**
+ * @file time_display.h
+ * @brief Digital time widget built from cached fixed-width glyph cells
+ *
+ * Replaces a plain lv_label for the "HH:MM" / "HH:MM:SS" time text. Digits
+ * and the colon are pre-rendered once into small RGB565 images; the widget
+ * draws one image per character cell and, on every update, invalidates
+ * only the cells whose character changed. Setting identical text costs
+ * nothing.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef TIME_DISPLAY_H
+#define TIME_DISPLAY_H
+
+#include <lvgl.h>
+
+// ============================================================================
+// CONSTANTS AND CONFIGURATION
+// ============================================================================
+
+#define TIME_DISPLAY_MAX_CHARS  8             ///< Longest text shown ("HH:MM:SS")
+#define TIME_DISPLAY_GLYPHS     "0123456789:" ///< Characters held in the glyph cache
+
+// ============================================================================
+// TIME DISPLAY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Create the time widget and render its glyph cache
+ * @param parent Parent object
+ * @param width Minimum widget width (grows if the text needs more)
+ * @param height Widget height
+ * @param font Font used for the glyphs
+ * @param text_color Glyph color
+ * @param bg_color Background color the glyphs are rendered on
+ * @param face_style Shared style of the widget background (opaque, bg_color)
+ * @return Widget object (only one time display may exist)
+ */
+lv_obj_t *time_display_create(lv_obj_t *parent, lv_coord_t width, lv_coord_t height,
+                              const lv_font_t *font, lv_color_t text_color, lv_color_t bg_color,
+                              lv_style_t *face_style);
+
+/**
+ * @brief Update the displayed text, redrawing only changed cells
+ * @param obj Widget returned by time_display_create()
+ * @param text New text; characters not in TIME_DISPLAY_GLYPHS show as blank
+ *             cells, text beyond TIME_DISPLAY_MAX_CHARS is ignored
+ */
+void time_display_set_text(lv_obj_t *obj, const char *text);
+
+/**
+ * @brief Pixels invalidated by time updates since boot (diagnostics)
+ * @return Invalidated pixel count
+ */
+uint32_t time_display_invalidated_px();
+
+#endif // TIME_DISPLAY_H
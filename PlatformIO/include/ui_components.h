@@ -14,6 +14,8 @@
 #define UI_COMPONENTS_H
 
 #include <lvgl.h>
+#include "metric_registry.h"
+#include "metric_history.h"
 
 // ============================================================================
 // TYPE DEFINITIONS
@@ -33,11 +35,27 @@ typedef struct {
     lv_color_t needle;       ///< Color for meter needle/pointer
 } meter_colors_t;
 
+/**
+ * @brief Screen layouts
+ */
+typedef enum {
+    UI_VIEW_METERS = 0,  ///< Analog meters and time (default)
+    UI_VIEW_TREND        ///< Sparkline history of every metric
+} ui_view_t;
+
+/**
+ * @brief Drawing path of a meter
+ */
+typedef enum {
+    METER_RENDERER_LVGL = 0,  ///< lv_meter draws the needle over the cached layer
+    METER_RENDERER_SPRITE     ///< LovyanGFX sprites composite face and needle (sprite_gauge.h)
+} meter_renderer_t;
+
 /**
  * @struct meter_config_t
  * @brief Complete configuration structure for analog meters
  */
-typedef struct {
+typedef struct meter_config_t {
     // Size and position
     lv_coord_t width;         ///< Meter widget width in pixels
     lv_coord_t height;        ///< Meter widget height in pixels
@@ -73,8 +91,32 @@ typedef struct {
     
     // Colors
     meter_colors_t colors;    ///< Complete color scheme for this meter
+    
+    // Rendering
+    uint8_t renderer;         ///< meter_renderer_t (sprite path needs UI_METER_STATIC_CACHE)
 } meter_config_t;
 
+struct sprite_gauge_t;  // Defined in sprite_gauge.cpp
+
+/**
+ * @struct meter_layer_cache_t
+ * @brief Pre-rendered static layer (scale, ticks, zones, labels) of a meter
+ * 
+ * Rendered once into an RGB565 buffer so that needle animation only has to
+ * blit the cached pixels under the needle instead of re-rasterizing arcs,
+ * tick lines and label glyphs. Black pixels are transparent (chroma key).
+ */
+typedef struct {
+    lv_obj_t *meter;                ///< Live meter drawing on top of the cache
+    const meter_config_t *config;   ///< Configuration the cache was rendered from
+    lv_img_dsc_t image;             ///< Image descriptor of the cropped layer
+    uint8_t *buffer;                ///< Pixel buffer (PSRAM when available)
+    lv_coord_t offset_x;            ///< Layer position relative to meter x1
+    lv_coord_t offset_y;            ///< Layer position relative to meter y1
+    lv_coord_t ext_draw_size;       ///< Extra draw area needed outside the meter
+    struct sprite_gauge_t *sprite;  ///< Sprite renderer state (NULL = lv_meter draws the needle)
+} meter_layer_cache_t;
+
 // ============================================================================
 // HELPER MACROS
 // ============================================================================
@@ -90,6 +132,23 @@ typedef struct {
 #define METER_GOLDEN_AMBER  METER_COLOR(255, 130, 3)   ///< Warm amber for UI elements
 #define METER_BRIGHT_RED    METER_COLOR(255, 50, 50)    ///< Alert red for warnings
 
+// ============================================================================
+// RENDERING OPTIONS
+// ============================================================================
+
+#ifndef UI_METER_STATIC_CACHE
+#define UI_METER_STATIC_CACHE 1  ///< 1 = draw meter scales from a pre-rendered layer cache
+#endif
+
+#ifndef UI_DEFAULT_METER_RENDERER
+#define UI_DEFAULT_METER_RENDERER METER_RENDERER_LVGL  ///< Renderer of the built-in meter configurations
+#endif
+
+#define UI_MAX_METERS         METRIC_COUNT  ///< Number of meter layer cache slots
+
+#define UI_TREND_CHART_WIDTH  180  ///< Trend view sparkline width (one column per point)
+#define UI_TREND_CHART_HEIGHT 44   ///< Trend view sparkline height
+
 // ============================================================================
 // METER CONFIGURATIONS
 // ============================================================================
@@ -133,7 +192,9 @@ static const meter_config_t cpu_temp_meter_config = {
         .green_zone = METER_GOLDEN_AMBER,
         .red_zone = METER_BRIGHT_RED,
         .needle = METER_WHITE
-    }
+    },
+    
+    .renderer = UI_DEFAULT_METER_RENDERER
 };
 
 /**
@@ -175,7 +236,9 @@ static const meter_config_t cpu_load_meter_config = {
         .green_zone = METER_GOLDEN_AMBER,
         .red_zone = METER_GOLDEN_AMBER,
         .needle = METER_WHITE
-    }
+    },
+    
+    .renderer = UI_DEFAULT_METER_RENDERER
 };
 
 
@@ -183,17 +246,16 @@ static const meter_config_t cpu_load_meter_config = {
 // GLOBAL UI OBJECTS
 // ============================================================================
 
-extern lv_obj_t *cpu_temp_meter;  ///< CPU temperature analog meter widget
-extern lv_obj_t *cpu_load_meter;  ///< CPU load analog meter widget  
 extern lv_obj_t *center_button;   ///< Central circular button (time display background)
-extern lv_obj_t *time_label;      ///< Digital time display label
+extern lv_obj_t *time_label;      ///< Digital time display (cached-glyph time widget)
 
 // ============================================================================
 // NEEDLE ANIMATION SYSTEM
 // ============================================================================
 
-extern lv_anim_t cpu_temp_needle_anim;  ///< Animation for CPU temperature needle
-extern lv_anim_t cpu_load_needle_anim;  ///< Animation for CPU load needle
+// Meter widgets live in metric_table (metric_registry.h), needle motion in needle_spring.h
+
+extern uint32_t ui_needle_invalidated_px;  ///< Total pixels invalidated by needle moves
 
 // ============================================================================
 // BOOT ANIMATION SYSTEM
@@ -211,6 +273,7 @@ extern lv_anim_t boot_anim;                 ///< Main rotation animation
 
 /**
  * @brief Apply visual styling to a meter widget based on configuration
+ * @note Attaches the shared styles of the configuration (ui_theme.h)
  * @param meter Pointer to LVGL meter object
  * @param config Pointer to meter configuration structure
  */
@@ -223,23 +286,53 @@ void apply_meter_style(lv_obj_t *meter, const meter_config_t *config);
  */
 lv_obj_t* create_simple_meter_with_config(const meter_config_t *config);
 
+/**
+ * @brief Re-render a meter's static layer after its configuration changed
+ * @param meter Pointer to meter widget created by create_simple_meter_with_config()
+ * @param config New meter configuration (must stay valid while in use)
+ */
+void ui_meter_set_config(lv_obj_t *meter, const meter_config_t *config);
+
+/**
+ * @brief Switch every meter of one configuration to another
+ * @note One shared style change for all of them (ui_theme_set())
+ * @param from Configuration to replace
+ * @param to New configuration (must stay valid while in use)
+ */
+void ui_meters_set_config(const meter_config_t *from, const meter_config_t *to);
+
 /**
  * @brief Create central button and time label widgets
  */
 void create_button_and_label();
 
 /**
- * @brief Initialize complete UI system
+ * @brief Show a new time text, redrawing only the digits that changed
+ * @param text Time text ("HH:MM" or "HH:MM:SS")
+ */
+void ui_set_time_text(const char *text);
+
+/**
+ * @brief Initialize the UI and start the boot animation
+ * @note The meters, time label and trend view are built afterwards by
+ *       ui_build_step(), so the boot animation runs while they are created
  */
 void ui_init();
 
+/**
+ * @brief Build the next part of the main UI (render task)
+ * @return true while more steps remain; call once per render loop pass
+ *         until it returns false before feeding samples to the UI
+ */
+bool ui_build_step();
+
 /**
  * @brief Apply dark theme styling to the main screen
  */
 void apply_dark_theme();
 
 /**
- * @brief Update meter needle position to display new value
+ * @brief Update meter needle position to display new value (no animation)
  * @param meter Pointer to meter widget
  * @param value New value to display (0-100)
  */
@@ -250,12 +343,13 @@ void update_simple_meter_needle(lv_obj_t *meter, int32_t value);
 // ============================================================================
 
 /**
- * @brief Update meter needle with smooth animation
- * @param meter Pointer to meter widget
+ * @brief Update a metric's meter needle with smooth animation
+ * @param metric Metric whose meter is updated
  * @param new_value Target value to animate to (0-100)
- * @param duration Animation duration in milliseconds (default: 500ms)
+ * @param duration Settling time in milliseconds (see metric_descriptors[])
+ * @note A needle still in motion is retargeted from its displayed position
  */
-void update_meter_needle_animated(lv_obj_t *meter, int32_t new_value, uint32_t duration);
+void update_meter_needle_animated(metric_id_t metric, int32_t new_value, uint32_t duration);
 
 /**
  * @brief Initialize needle animation system
@@ -286,37 +380,42 @@ void hide_boot_animation();
 // ============================================================================
 
 /**
- * @brief Hide CPU temperature meter widget (UI-only operation)
+ * @brief Hide or show a metric's meter widget (UI-only operation)
+ * @param metric Metric whose meter is changed
+ * @param hidden true to hide, false to show
  */
-void ui_hide_cpu_temp_meter();
+void ui_set_meter_hidden(metric_id_t metric, bool hidden);
 
-/**
- * @brief Show CPU temperature meter widget (UI-only operation)
- */
-void ui_show_cpu_temp_meter();
+// ============================================================================
+// UI-ONLY DISPLAY CONTROL FUNCTIONS
+// ============================================================================
 
 /**
- * @brief Hide CPU load meter widget (UI-only operation)
+ * @brief Hide all UI elements (UI-only operation)
  */
-void ui_hide_cpu_load_meter();
+void ui_blank_entire_display();
 
 /**
- * @brief Show CPU load meter widget (UI-only operation)
+ * @brief Show all UI elements (UI-only operation)
  */
-void ui_show_cpu_load_meter();
+void ui_show_entire_display();
 
 // ============================================================================
-// UI-ONLY DISPLAY CONTROL FUNCTIONS
+// VIEW FUNCTIONS
 // ============================================================================
 
 /**
- * @brief Hide all UI elements (UI-only operation)
+ * @brief Switch between the meter and trend views
+ * @param view View to show
+ * @param tier History tier shown by the trend view
+ * @note Takes effect immediately unless the display is blanked or booting
  */
-void ui_blank_entire_display();
+void ui_set_view(ui_view_t view, history_tier_t tier);
 
 /**
- * @brief Show all UI elements (UI-only operation)
+ * @brief Scroll new history points into the trend view
+ * @note Cheap no-op unless the trend view is on screen; call after each sample
  */
-void ui_show_entire_display();
+void ui_trend_sync();
 
 #endif // UI_COMPONENTS_H
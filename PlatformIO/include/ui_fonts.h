@@ -0,0 +1,28 @@
+/**
+ * @file ui_fonts.h
+ * @brief Fonts used by the UI
+ * 
+ * With UI_USE_SUBSET_FONTS (defined by scripts/font_subset.py once the
+ * subsets were generated into src/fonts/) the UI uses fonts that contain
+ * only the glyphs it draws; otherwise LVGL's built-in Montserrat fonts of
+ * the same sizes. Adding text with new characters or sizes requires an
+ * entry in the FONTS table of the script.
+ * 
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef UI_FONTS_H
+#define UI_FONTS_H
+
+#include <lvgl.h>
+
+#if UI_USE_SUBSET_FONTS
+#define UI_FONT_TIME (&ui_font_time_32)       ///< Time digits: "0123456789:" only
+#define UI_FONT_TEXT (&ui_font_text_14)       ///< Labels and captions: printable ASCII
+#else
+#define UI_FONT_TIME (&lv_font_montserrat_32) ///< Time digits
+#define UI_FONT_TEXT (&lv_font_montserrat_14) ///< Labels and captions
+#endif
+
+#endif // UI_FONTS_H
@@ -0,0 +1,104 @@
+/**
+ * @file ui_theme.h
+ * @brief Shared LVGL styles of the UI
+ *
+ * The meters, boot animation, central button, time face, trend column
+ * and captions reference statically allocated lv_style_t objects created
+ * once by ui_theme_init() instead of carrying local style properties. Meters get the style pair
+ * of their configuration variant: configurations that look the same share
+ * one pair, so all meters resolve their style from the same few entries.
+ * Switching a meter's configuration is one style swap followed by one
+ * invalidation; ui_theme_set() switches all meters of a variant at once by
+ * changing their shared pair.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef UI_THEME_H
+#define UI_THEME_H
+
+#include <lvgl.h>
+#include "ui_components.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#ifndef UI_THEME_MAX_METER_STYLES
+#define UI_THEME_MAX_METER_STYLES UI_MAX_METERS  ///< Distinct meter style variants
+#endif
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @struct ui_theme_t
+ * @brief Fixed styles of the non-meter widgets
+ */
+typedef struct {
+    lv_style_t screen;             ///< Screen background
+    lv_style_t overlay;            ///< Opaque full-screen container without border or padding
+    lv_style_t spinner_track;      ///< Boot arc track and body (invisible)
+    lv_style_t spinner_indicator;  ///< Boot arc rotating segment
+    lv_style_t spinner_knob;       ///< Boot arc knob (invisible)
+    lv_style_t round_button;       ///< Central black circle behind the time
+    lv_style_t time_face;          ///< Opaque background of the time widget
+    lv_style_t trend_column;       ///< Centered flex column of the trend view rows
+    lv_style_t caption;            ///< Trend view captions
+} ui_theme_t;
+
+// ============================================================================
+// GLOBAL STATE
+// ============================================================================
+
+extern ui_theme_t ui_theme;  ///< Fixed styles (valid after ui_theme_init())
+
+// ============================================================================
+// THEME FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Create the fixed styles (only the first call has an effect)
+ * @note Call after lv_init(), before any styled object is created
+ */
+void ui_theme_init();
+
+/**
+ * @brief Attach the shared style pair of a meter configuration
+ *
+ * Replaces a style pair attached earlier; attaching the pair the meter
+ * already has does nothing. The pair is created on first use of a variant.
+ *
+ * @param meter Meter widget
+ * @param config Meter configuration
+ * @return false if the variant pool was full and local style properties were used
+ */
+bool ui_theme_apply_meter(lv_obj_t *meter, const meter_config_t *config);
+
+/**
+ * @brief Whether two configurations share a meter style pair
+ * @return false if neither has a pair yet
+ */
+bool ui_theme_meter_style_shared(const meter_config_t *a, const meter_config_t *b);
+
+/**
+ * @brief Restyle every meter of one configuration variant
+ *
+ * Changes the shared style pair of from in place to the look of to,
+ * followed by one lv_obj_report_style_change(): a theme switch for all
+ * meters of the variant without touching them one by one.
+ *
+ * @param from Configuration the meters currently have
+ * @param to Configuration to give them
+ * @return false if from has no pair, or to has a pair of its own (attach it per meter then)
+ */
+bool ui_theme_set(const meter_config_t *from, const meter_config_t *to);
+
+/**
+ * @brief Number of meter style variants in use
+ */
+uint8_t ui_theme_meter_style_count();
+
+#endif // UI_THEME_H
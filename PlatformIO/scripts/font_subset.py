@@ -0,0 +1,75 @@
+"""
+PlatformIO pre-build script: generate subset LVGL fonts for the UI.
+
+The UI only needs two fonts (see include/ui_fonts.h):
+- ui_font_time_32: the time digits and the colon
+- ui_font_text_14: printable ASCII for meter labels and trend captions
+
+Both are rendered with lv_font_conv (run through npx) from the Montserrat
+TTF that ships with the LVGL library, into src/fonts/. Generation is skipped
+while the outputs match FONTS (stamp file). If lv_font_conv or the TTF is
+not available, the build keeps LVGL's built-in Montserrat fonts.
+
+Disable with `custom_font_subset = no` in the environment.
+"""
+
+import json
+import os
+import subprocess
+
+Import("env")
+
+# name, size, lv_font_conv glyph selection
+FONTS = [
+    ("ui_font_time_32", 32, ["--symbols", "0123456789:"]),
+    ("ui_font_text_14", 14, ["--range", "0x20-0x7E"]),
+]
+
+FONT_BPP = 4
+
+project_dir = env.subst("$PROJECT_DIR")
+out_dir = os.path.join(project_dir, "src", "fonts")
+stamp_path = os.path.join(out_dir, ".stamp")
+ttf_path = os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"),
+                        "lvgl", "scripts", "built_in_font", "Montserrat-Medium.ttf")
+
+
+def outputs_current(stamp):
+    if not os.path.isfile(stamp_path):
+        return False
+    with open(stamp_path) as f:
+        if f.read() != stamp:
+            return False
+    return all(os.path.isfile(os.path.join(out_dir, name + ".c")) for name, _, _ in FONTS)
+
+
+def generate(stamp):
+    os.makedirs(out_dir, exist_ok=True)
+    for name, size, glyphs in FONTS:
+        cmd = ["npx", "--yes", "lv_font_conv",
+               "--font", ttf_path, *glyphs,
+               "--size", str(size), "--bpp", str(FONT_BPP),
+               "--format", "lvgl", "--no-compress",
+               "--lv-include", "lvgl.h", "--lv-font-name", name,
+               "-o", os.path.join(out_dir, name + ".c")]
+        subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+        print("Font subset: generated %s (%d px)" % (name, size))
+    with open(stamp_path, "w") as f:
+        f.write(stamp)
+
+
+if env.GetProjectOption("custom_font_subset", "yes").lower() in ("yes", "true", "1"):
+    stamp = json.dumps([FONTS, FONT_BPP])
+    ready = outputs_current(stamp)
+    if not ready:
+        if not os.path.isfile(ttf_path):
+            print("Font subset: %s not found - using built-in fonts" % ttf_path)
+        else:
+            try:
+                generate(stamp)
+                ready = True
+            except (OSError, subprocess.CalledProcessError) as err:
+                print("Font subset: lv_font_conv failed (%s) - using built-in fonts" % err)
+
+    if ready:
+        env.Append(CPPDEFINES=[("UI_USE_SUBSET_FONTS", 1)])
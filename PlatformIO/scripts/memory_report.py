@@ -0,0 +1,82 @@
+"""
+PlatformIO post-build script: RAM/flash budget report.
+
+Parses the linker map of the firmware and prints
+- flash used by each font
+- the LVGL heap pool against LV_MEM_SIZE (the runtime high-water mark is
+  printed by the `stats` serial command)
+- the largest statically allocated buffers of the firmware sources
+"""
+
+import os
+import re
+
+Import("env")
+
+TOP_BUFFERS = 12
+
+map_path = os.path.join(env.subst("$BUILD_DIR"), "firmware.map")
+env.Append(LINKFLAGS=["-Wl,-Map," + map_path])
+
+# Input section, address, size, object (section name may wrap onto its own line)
+SECTION_RE = re.compile(r"^ (\.[\w.$]+)\s+0x[0-9a-f]+\s+0x([0-9a-f]+)\s+(\S+\.o)\b", re.M)
+FONT_RE = re.compile(r"((?:lv|ui)_font_\w+)\.c\.o$")
+MANGLED_RE = re.compile(r"_ZL?N?(\d+)(\w+)")
+
+
+def read_sections():
+    with open(map_path) as f:
+        text = re.sub(r"^ (\.[\w.$]+)\n\s+", r" \1 ", f.read(), flags=re.M)
+    for name, size, obj in SECTION_RE.findall(text):
+        yield name, int(size, 16), obj.replace("\\", "/")
+
+
+def symbol_name(section):
+    name = section.split(".")[-1]
+    match = MANGLED_RE.match(name)
+    return match.group(2)[:int(match.group(1))] if match else name
+
+
+def lv_mem_size():
+    with open(os.path.join(env.subst("$PROJECT_INCLUDE_DIR"), "lv_conf.h")) as f:
+        match = re.search(r"#define\s+LV_MEM_SIZE\s+\((\d+)U\s*\*\s*(\d+)U\)", f.read())
+    return int(match.group(1)) * int(match.group(2)) if match else None
+
+
+def memory_report(source, target, env):
+    if not os.path.isfile(map_path):
+        print("Memory report: %s not found" % map_path)
+        return
+
+    fonts = {}
+    buffers = []
+    lvgl_pool = 0
+    for section, size, obj in read_sections():
+        font = FONT_RE.search(obj)
+        if font and section.startswith((".rodata", ".data")):
+            fonts[font.group(1)] = fonts.get(font.group(1), 0) + size
+        elif section.startswith((".bss", ".data", ".dram")) and "/src/" in obj:
+            buffers.append((size, symbol_name(section), os.path.basename(obj)[:-2]))
+        if "lv_mem.c.o" in obj and "work_mem_int" in section:
+            lvgl_pool = size
+
+    print("")
+    print("=== Memory budget ===")
+    print("Fonts (flash):")
+    for name, size in sorted(fonts.items(), key=lambda item: -item[1]):
+        print("  %-28s %8d bytes" % (name, size))
+    print("  %-28s %8d bytes" % ("total", sum(fonts.values())))
+
+    budget = lv_mem_size()
+    print("LVGL heap (RAM): pool %d bytes, LV_MEM_SIZE %s bytes"
+          % (lvgl_pool, budget if budget else "?"))
+    print("  runtime high-water mark: send `stats` over serial")
+
+    print("Largest static buffers (RAM):")
+    for size, name, obj in sorted(buffers, reverse=True)[:TOP_BUFFERS]:
+        print("  %-28s %8d bytes  %s" % (name, size, obj))
+    print("  %-28s %8d bytes" % ("total (firmware sources)", sum(size for size, _, _ in buffers)))
+    print("Runtime allocations: DMA draw buffers (DISPLAY_BUFFER_LINES), meter layer caches, sparklines")
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", memory_report)
@@ -0,0 +1,129 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino core shim for the native simulator build
+ *
+ * Provides only what the UI, system manager and serial link sources use:
+ * a virtual millisecond clock, a Print class with printf, and a Serial
+ * object whose input is fed by the replay driver and whose output goes to
+ * stdout. The clock only moves when the simulator advances it, so a
+ * recording can be replayed faster than real time with unchanged timeouts.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#ifndef SIM_CPU_MHZ
+#define SIM_CPU_MHZ 1000  ///< Reported CPU clock: one "cycle" per nanosecond of host time
+#endif
+
+#define SIM_SERIAL_RX_SIZE 4096  ///< Replay bytes buffered ahead of the serial link
+
+// ============================================================================
+// VIRTUAL CLOCK
+// ============================================================================
+
+/**
+ * @brief Milliseconds of simulated time since start
+ */
+uint32_t millis();
+
+/**
+ * @brief Microseconds of simulated time since start
+ */
+uint32_t micros();
+
+/**
+ * @brief Advance the simulated clock (does not sleep)
+ * @param ms Milliseconds to add
+ */
+void delay(uint32_t ms);
+
+/**
+ * @brief Advance the simulated clock
+ * @param ms Milliseconds to add
+ * @note The caller feeds the same step to lv_tick_inc()
+ */
+void sim_clock_advance(uint32_t ms);
+
+/**
+ * @brief CPU clock used to convert cycle counts
+ * @return SIM_CPU_MHZ
+ */
+uint32_t getCpuFrequencyMhz();
+
+// ============================================================================
+// PRINT AND SERIAL
+// ============================================================================
+
+/**
+ * @class Print
+ * @brief Output stream with the Arduino print/printf interface
+ */
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+
+  size_t write(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+  size_t print(const char *text) { return write(text); }
+  size_t println(const char *text) { return write(text) + write('\n'); }
+  size_t println() { return write('\n'); }
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/**
+ * @class SimSerial
+ * @brief Serial port backed by a replay buffer (input) and stdout (output)
+ */
+class SimSerial : public Print {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void setTxTimeoutMs(uint32_t ms) { (void)ms; }
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+
+  int available();
+  int read();
+  size_t read(uint8_t *buffer, size_t size);
+
+  /**
+   * @brief Queue bytes as if the host had sent them
+   * @param data Bytes to receive
+   * @param size Number of bytes
+   * @return Bytes accepted (less than size if the buffer is full)
+   */
+  size_t feed(const void *data, size_t size);
+
+  /**
+   * @brief Suppress or restore output to stdout
+   * @param quiet true = discard everything written
+   */
+  void set_quiet(bool quiet) { quiet_ = quiet; }
+
+private:
+  uint8_t rx_[SIM_SERIAL_RX_SIZE];
+  size_t rx_head_ = 0;   ///< Next byte to read
+  size_t rx_count_ = 0;  ///< Bytes waiting
+  bool quiet_ = false;
+};
+
+extern SimSerial Serial;  ///< Global serial instance
+
+#endif // SIM_ARDUINO_H
@@ -0,0 +1,26 @@
+/**
+ * @file display_sim.h
+ * @brief Simulator-only additions to the display driver interface
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef DISPLAY_SIM_H
+#define DISPLAY_SIM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Write the simulated panel content as a binary PPM image
+ * @param path Output file
+ * @return true on success
+ */
+bool display_sim_write_ppm(const char *path);
+
+/**
+ * @brief Whether the simulated backlight is on
+ */
+bool display_sim_backlight_on();
+
+#endif // DISPLAY_SIM_H
@@ -0,0 +1,29 @@
+/**
+ * @file esp_cpu.h
+ * @brief ESP-IDF cycle counter shim for the native simulator build
+ *
+ * Counts host time at SIM_CPU_MHZ "cycles" per microsecond, so the
+ * pipeline statistics report the real cost of the UI code on the host
+ * while millis() follows the simulated clock.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SIM_ESP_CPU_H
+#define SIM_ESP_CPU_H
+
+#include <stdint.h>
+#include <time.h>
+#include "Arduino.h"
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  uint64_t ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+  return (esp_cpu_cycle_count_t)(ns * SIM_CPU_MHZ / 1000ULL);
+}
+
+#endif // SIM_ESP_CPU_H
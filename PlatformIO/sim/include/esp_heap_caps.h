@@ -0,0 +1,37 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief ESP-IDF capability allocator shim for the native simulator build
+ *
+ * The host has one heap, so every capability maps to malloc().
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SIM_ESP_HEAP_CAPS_H
+#define SIM_ESP_HEAP_CAPS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+static inline void *heap_caps_malloc(size_t size, uint32_t caps) {
+  (void)caps;
+  return malloc(size);
+}
+
+static inline void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps) {
+  (void)caps;
+  return realloc(ptr, size);
+}
+
+static inline void heap_caps_free(void *ptr) {
+  free(ptr);
+}
+
+#endif // SIM_ESP_HEAP_CAPS_H
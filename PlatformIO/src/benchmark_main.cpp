@@ -0,0 +1,332 @@
+/**
+ * @file benchmark_main.cpp
+ * @brief On-device rendering benchmark firmware ([env:benchmark])
+ *
+ * Replaces main.cpp in the benchmark build. Drives the real ui_init() meters
+ * through scripted scenarios while sweeping the display pipeline settings,
+ * and prints one results row per configuration and scenario over serial.
+ *
+ * Swept settings (see bench_configs[]):
+ * - Partial stripe buffers vs full-frame direct mode (SRAM / PSRAM)
+ * - Draw buffer height in lines
+ * - Single vs double buffering
+ * - Round mask with DMA: whole trimmed stripes vs one transfer per row span
+ * - SPI write frequency
+ * - LVGL refresh period (fixed per run; the adaptive policy is disabled)
+ *
+ * The pixel byte order is a compile-time setting: [env:benchmark] renders in
+ * panel order (LV_COLOR_16_SWAP=1, flush is a plain DMA copy) and
+ * [env:benchmark_noswap] in native order (LovyanGFX swaps every pixel).
+ * Compare the flush_KB/s columns of both runs.
+ *
+ * Scenarios:
+ * - sweep: both needles animate full scale back and forth
+ * - time:  time label text changes every 50 ms
+ * - hide:  temperature meter is hidden and shown every 250 ms
+ *
+ * Reported per row: frames, achieved FPS, frame time p50/p90/p99/max (µs,
+ * complete refresh including flushes), average pixels per frame and flush
+ * throughput (bytes pushed / time spent in the flush callback).
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include <Arduino.h>
+#include "display_driver.h"
+#include "ui_components.h"
+#include "needle_spring.h"
+
+// ============================================================================
+// BENCHMARK CONFIGURATION
+// ============================================================================
+
+#define BENCH_SCENARIO_MS   3000  ///< Measurement time per scenario
+#define BENCH_SETTLE_MS     300   ///< Unmeasured run-in after reconfiguration
+#define BENCH_MAX_FRAMES    512   ///< Frame samples kept per scenario
+
+/**
+ * @struct bench_config_t
+ * @brief One display pipeline configuration to measure
+ */
+typedef struct {
+  uint16_t buffer_lines;    ///< Draw buffer height in lines
+  bool double_buffer;       ///< Two DMA buffers with overlapped flush
+  uint32_t spi_hz;          ///< SPI write frequency
+  uint32_t refr_period_ms;  ///< LVGL refresh period
+  uint8_t full_frame;       ///< 0 = stripes, 1 = full frame in SRAM, 2 = full frame in PSRAM
+  bool dma_spans;           ///< Double-buffered round mask: one DMA per row span
+} bench_config_t;
+
+/**
+ * @brief Configurations to measure - first row is the firmware default
+ */
+static const bench_config_t bench_configs[] = {
+  { DISPLAY_BUFFER_LINES, DISPLAY_DOUBLE_BUFFER, DISPLAY_SPI_WRITE_HZ, DISPLAY_REFR_ACTIVE_MS, DISPLAY_FULL_FRAME, false },
+  // Buffer height
+  { 10, true,  27000000, 30, 0, false },
+  { 40, true,  27000000, 30, 0, false },
+  { 80, true,  27000000, 30, 0, false },
+  // Single vs double buffering
+  { 20, false, 27000000, 30, 0, false },
+  { 40, false, 27000000, 30, 0, false },
+  // SPI write frequency
+  { 20, true,  20000000, 30, 0, false },
+  { 20, true,  40000000, 30, 0, false },
+  { 20, true,  80000000, 30, 0, false },
+  { 20, false, 80000000, 30, 0, false },
+  // Round mask with DMA: one transfer per row span instead of per stripe
+  { 20, true,  27000000, 30, 0, true  },
+  { 40, true,  80000000, 16, 0, true  },
+  // Refresh period
+  { 20, true,  27000000, 16, 0, false },
+  { 20, true,  27000000, 50, 0, false },
+  { 40, true,  80000000, 16, 0, false },
+  // Full-frame direct mode with tile diffing
+  {  0, false, 27000000, 30, 1, false },
+  {  0, false, 27000000, 30, 2, false },
+  {  0, false, 80000000, 16, 1, false },
+  {  0, false, 80000000, 16, 2, false },
+};
+
+#define BENCH_CONFIG_COUNT (sizeof(bench_configs) / sizeof(bench_configs[0]))
+
+/**
+ * @brief Scripted UI activity
+ */
+typedef enum {
+  BENCH_SCENARIO_SWEEP = 0,  ///< Animated full-scale needle sweeps
+  BENCH_SCENARIO_TIME,       ///< Time label updates
+  BENCH_SCENARIO_HIDE,       ///< Meter show/hide cycles
+  BENCH_SCENARIO_COUNT
+} bench_scenario_t;
+
+static const char *bench_scenario_names[BENCH_SCENARIO_COUNT] = { "sweep", "time", "hide" };
+
+// ============================================================================
+// FRAME SAMPLES
+// ============================================================================
+
+static uint32_t frame_us[BENCH_MAX_FRAMES];  ///< Refresh times of the current scenario
+static uint32_t frame_count = 0;             ///< Frames seen (may exceed BENCH_MAX_FRAMES)
+static uint64_t flush_us_total = 0;          ///< Time spent flushing
+static uint64_t flush_px_total = 0;          ///< Pixels flushed
+static bool recording = false;               ///< Samples are collected only while measuring
+
+/**
+ * @brief Display frame hook - collects one sample per refresh
+ */
+static void bench_frame_hook(uint32_t frame_time_us, uint32_t flush_time_us, uint32_t px) {
+  if (!recording) {
+    return;
+  }
+  if (frame_count < BENCH_MAX_FRAMES) {
+    frame_us[frame_count] = frame_time_us;
+  }
+  frame_count++;
+  flush_us_total += flush_time_us;
+  flush_px_total += px;
+}
+
+/**
+ * @brief qsort comparator for frame times
+ */
+static int compare_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Percentile of the sorted samples (nearest rank)
+ * @param sorted Sorted samples
+ * @param count Number of samples
+ * @param percent Percentile 0-100
+ */
+static uint32_t percentile(const uint32_t *sorted, uint32_t count, uint32_t percent) {
+  if (count == 0) {
+    return 0;
+  }
+  uint32_t rank = (percent * count + 99) / 100;
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+// ============================================================================
+// SCENARIOS
+// ============================================================================
+
+/**
+ * @brief Run LVGL for a while, applying one scenario's scripted changes
+ * @param scenario Scenario to drive
+ * @param duration_ms Run time in milliseconds
+ */
+static void run_scenario(bench_scenario_t scenario, uint32_t duration_ms) {
+  uint32_t start = millis();
+  uint32_t next_step = start;
+  uint32_t step = 0;
+
+  while (millis() - start < duration_ms) {
+    uint32_t now = millis();
+
+    if ((int32_t)(now - next_step) >= 0) {
+      switch (scenario) {
+        case BENCH_SCENARIO_SWEEP: {
+          int32_t target = (step & 1) ? 0 : 100;
+          update_meter_needle_animated(METRIC_CPU_TEMP, target, 600);
+          update_meter_needle_animated(METRIC_CPU_LOAD, 100 - target, 400);
+          next_step += 700;
+          break;
+        }
+        case BENCH_SCENARIO_TIME: {
+          char text[16];
+          uint32_t seconds = step;
+          snprintf(text, sizeof(text), "%02lu:%02lu:%02lu",
+                   (unsigned long)(seconds / 3600 % 24), (unsigned long)(seconds / 60 % 60),
+                   (unsigned long)(seconds % 60));
+          ui_set_time_text(text);
+          next_step += 50;
+          break;
+        }
+        case BENCH_SCENARIO_HIDE:
+          ui_set_meter_hidden(METRIC_CPU_TEMP, (step & 1) == 0);
+          next_step += 250;
+          break;
+        default:
+          break;
+      }
+      step++;
+    }
+
+    uint32_t wait_ms = lv_timer_handler();
+    int32_t until_step = (int32_t)(next_step - millis());
+    if (until_step < 0) until_step = 0;
+    if (wait_ms > (uint32_t)until_step) wait_ms = (uint32_t)until_step;
+    delay(wait_ms > 0 ? wait_ms : 1);
+  }
+
+  // Leave the UI in a common state for the next scenario
+  ui_set_meter_hidden(METRIC_CPU_TEMP, false);
+}
+
+/**
+ * @brief Buffer column of a result row: stripe height or framebuffer memory
+ */
+static const char *buffer_label(const bench_config_t *config, char *buf, size_t size) {
+  switch (config->full_frame) {
+    case 1:  return "fb-S";
+    case 2:  return "fb-P";
+    default: snprintf(buf, size, "%u", (unsigned)config->buffer_lines); return buf;
+  }
+}
+
+/**
+ * @brief Measure one scenario and print its result row
+ * @param config Active configuration
+ * @param scenario Scenario to measure
+ */
+static void measure_scenario(const bench_config_t *config, bench_scenario_t scenario) {
+  run_scenario(scenario, BENCH_SETTLE_MS);
+
+  frame_count = 0;
+  flush_us_total = 0;
+  flush_px_total = 0;
+  recording = true;
+  uint32_t start = millis();
+  run_scenario(scenario, BENCH_SCENARIO_MS);
+  uint32_t elapsed = millis() - start;
+  recording = false;
+
+  uint32_t samples = frame_count < BENCH_MAX_FRAMES ? frame_count : BENCH_MAX_FRAMES;
+  qsort(frame_us, samples, sizeof(frame_us[0]), compare_u32);
+
+  uint32_t fps_x10 = elapsed > 0 ? frame_count * 10000 / elapsed : 0;
+  uint32_t avg_px = frame_count > 0 ? (uint32_t)(flush_px_total / frame_count) : 0;
+  uint32_t kb_per_s = flush_us_total > 0
+    ? (uint32_t)(flush_px_total * sizeof(lv_color_t) * 1000000ULL / flush_us_total / 1024)
+    : 0;
+
+  char lines[8];
+  Serial.printf("%5s  %4s  %3lu  %4lu  %-5s  %6lu  %3lu.%lu  %6lu  %6lu  %6lu  %6lu  %8lu  %10lu\n",
+                buffer_label(config, lines, sizeof(lines)), config->double_buffer ? (config->dma_spans ? "span" : "yes") : "no",
+                (unsigned long)(config->spi_hz / 1000000), (unsigned long)config->refr_period_ms,
+                bench_scenario_names[scenario], (unsigned long)frame_count,
+                (unsigned long)(fps_x10 / 10), (unsigned long)(fps_x10 % 10),
+                (unsigned long)percentile(frame_us, samples, 50),
+                (unsigned long)percentile(frame_us, samples, 90),
+                (unsigned long)percentile(frame_us, samples, 99),
+                (unsigned long)(samples > 0 ? frame_us[samples - 1] : 0),
+                (unsigned long)avg_px, (unsigned long)kb_per_s);
+}
+
+/**
+ * @brief Apply a configuration to the display pipeline
+ * @return true if the draw buffers or the framebuffer could be allocated
+ */
+static bool apply_config(const bench_config_t *config) {
+  bool ok = config->full_frame
+    ? display_configure_full_frame(config->full_frame == 2)
+    : display_configure_buffers(config->buffer_lines, config->double_buffer);
+  if (!ok) {
+    return false;
+  }
+  display_set_dma_spans(config->dma_spans);
+  display_set_spi_frequency(config->spi_hz);
+  display_set_refresh_policy(config->refr_period_ms, config->refr_period_ms);
+  return true;
+}
+
+// ============================================================================
+// BENCHMARK ENTRY POINTS
+// ============================================================================
+
+/**
+ * @brief Benchmark setup - build the real UI and switch to the main screen
+ */
+void setup() {
+  Serial.begin(115200);
+  delay(2000);  // Give the host time to open the CDC port and see the header
+
+  metric_registry_init();
+  display_init();
+  ui_init();
+  while (ui_build_step()) {
+  }
+  hide_boot_animation();  // Show meters, center button and time label
+  for (int id = 0; id < METRIC_COUNT; id++) {
+    metric_table.needle_value[id] = 0;  // Animations start from the reset position
+    needle_spring_set((uint8_t)id, 0);
+  }
+  ui_set_time_text("00:00:00");
+
+  display_set_frame_hook(bench_frame_hook);
+}
+
+/**
+ * @brief Run the full sweep, print the table, then repeat
+ */
+void loop() {
+  Serial.println();
+  Serial.printf("Rendering benchmark: %u configurations x %u scenarios, %u ms each\n",
+                (unsigned)BENCH_CONFIG_COUNT, (unsigned)BENCH_SCENARIO_COUNT, (unsigned)BENCH_SCENARIO_MS);
+  Serial.printf("Pixel order: %s\n", LV_COLOR_16_SWAP ? "panel (LV_COLOR_16_SWAP=1, no CPU swap)"
+                                                      : "native (LV_COLOR_16_SWAP=0, swapped by LovyanGFX)");
+  Serial.println("lines  dbuf  MHz  refr  scene  frames    fps  p50_us  p90_us  p99_us  max_us  px/frame  flush_KB/s");
+
+  for (uint32_t c = 0; c < BENCH_CONFIG_COUNT; c++) {
+    const bench_config_t *config = &bench_configs[c];
+    if (!apply_config(config)) {
+      char lines[8];
+      Serial.printf("%5s  %4s  skipped (out of memory)\n",
+                    buffer_label(config, lines, sizeof(lines)), config->double_buffer ? "yes" : "no");
+      continue;
+    }
+    for (int s = 0; s < BENCH_SCENARIO_COUNT; s++) {
+      measure_scenario(config, (bench_scenario_t)s);
+    }
+  }
+
+  // Restore the firmware defaults between passes
+  apply_config(&bench_configs[0]);
+  Serial.println("Benchmark pass complete");
+  delay(5000);
+}
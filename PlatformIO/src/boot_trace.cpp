@@ -0,0 +1,60 @@
+/**
+ * @file boot_trace.cpp
+ * @brief Implementation of the boot phase trace
+ *
+ * Times come from esp_timer, which starts with the application, so the ROM
+ * and second stage bootloader are not included in the first phase.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "boot_trace.h"
+
+// ============================================================================
+// TRACE STATE
+// ============================================================================
+
+/**
+ * @struct boot_mark_t
+ * @brief End of one boot phase
+ */
+typedef struct {
+    const char *phase;  ///< Phase name
+    uint32_t time_us;   ///< micros() at the end of the phase
+} boot_mark_t;
+
+static boot_mark_t boot_marks[BOOT_TRACE_MAX_MARKS];  ///< Recorded marks
+static uint8_t boot_mark_count = 0;                   ///< Marks in use
+
+// ============================================================================
+// BOOT TRACE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Record that a boot phase has ended
+ */
+void boot_trace_mark(const char *phase) {
+    if (boot_mark_count < BOOT_TRACE_MAX_MARKS) {
+        boot_marks[boot_mark_count].phase = phase;
+        boot_marks[boot_mark_count].time_us = micros();
+        boot_mark_count++;
+    }
+}
+
+/**
+ * @brief Print all marks with their time since reset and the phase duration
+ */
+void boot_trace_print(Print &out) {
+    out.println("=== Boot trace ===");
+    out.printf("%-16s %9s %8s\n", "phase", "at_ms", "took_ms");
+    uint32_t previous_us = 0;
+    for (uint8_t i = 0; i < boot_mark_count; i++) {
+        uint32_t at_us = boot_marks[i].time_us;
+        out.printf("%-16s %7lu.%lu %6lu.%lu\n", boot_marks[i].phase,
+                   (unsigned long)(at_us / 1000), (unsigned long)(at_us / 100 % 10),
+                   (unsigned long)((at_us - previous_us) / 1000),
+                   (unsigned long)((at_us - previous_us) / 100 % 10));
+        previous_us = at_us;
+    }
+}
@@ -0,0 +1,377 @@
+/**
+ * @file command_channel.cpp
+ * @brief Implementation of the serial command channel
+ *
+ * Commands are matched by their first word against command_table[]. An
+ * entry's argument parser runs in the ingest task and only validates and
+ * stores arguments; the work itself happens in the render task, which
+ * owns LVGL and the system state.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "command_channel.h"
+#include "display_driver.h"
+#include "ui_components.h"
+#include "system_manager.h"
+#include "serial_link.h"
+#include "sample_queue.h"
+#include "sample_apply.h"
+#include "sample_protocol.h"
+#include "perf_stats.h"
+#include "latency_trace.h"
+#include "boot_trace.h"
+#include "metric_history.h"
+#include <esp_heap_caps.h>
+#include <stdarg.h>
+#include <atomic>
+
+// ============================================================================
+// REQUEST STATE
+// ============================================================================
+
+/**
+ * @brief Work posted to the render task by commands
+ */
+enum {
+    COMMAND_REQUEST_STATUS      = 1 << 0,  ///< Print system status
+    COMMAND_REQUEST_STATS       = 1 << 1,  ///< Print pipeline statistics
+    COMMAND_REQUEST_RESET_STATS = 1 << 2,  ///< Clear pipeline statistics
+    COMMAND_REQUEST_CONFIG      = 1 << 3,  ///< Print build configuration
+    COMMAND_REQUEST_TELEMETRY   = 1 << 4,  ///< Send a binary telemetry frame
+    COMMAND_REQUEST_BOOT_TRACE  = 1 << 5,  ///< Print the boot phase trace
+    COMMAND_REQUEST_SET_VIEW    = 1 << 6,  ///< Switch to requested_view
+    COMMAND_REQUEST_KEEPALIVE   = 1 << 7,  ///< Hold the values, refresh the data timeout
+    COMMAND_REQUEST_LATENCY     = 1 << 8,  ///< Print the latency histograms
+};
+
+static TaskHandle_t render_task_handle = NULL;   ///< Task woken for requests
+static std::atomic<uint32_t> pending_requests(0); ///< Pending COMMAND_REQUEST_* bits
+static std::atomic<uint32_t> requested_view(0);   ///< ui_view_t | history_tier_t << 8
+
+static char response_buffer[COMMAND_RESPONSE_SIZE];  ///< Text reply (render task only)
+
+// ============================================================================
+// COMMAND TABLE
+// ============================================================================
+
+/**
+ * @struct command_entry_t
+ * @brief One serial command
+ */
+typedef struct {
+    const char *name;                      ///< Command word
+    uint32_t request;                      ///< COMMAND_REQUEST_* bit (0 = done by parse_args)
+    bool (*parse_args)(const char *args);  ///< Checks and stores arguments (NULL = none accepted)
+    const char *help;                      ///< One-line description
+} command_entry_t;
+
+static bool parse_view_args(const char *args);
+static bool print_link_info(const char *args);
+static bool set_streaming(const char *args);
+static bool print_help(const char *args);
+
+static const command_entry_t command_table[] = {
+    { SERIAL_KEEPALIVE_COMMAND, COMMAND_REQUEST_KEEPALIVE, NULL,   "host alive, values unchanged (no reply)" },
+    { "link",        0,                           print_link_info, "capabilities for change-driven hosts" },
+    { "stream",      0,                           set_streaming,   "[on|off] credit acks for streaming hosts" },
+    { "status",      COMMAND_REQUEST_STATUS,      NULL,            "system state and link counters" },
+    { "stats",       COMMAND_REQUEST_STATS,       NULL,            "frame pipeline statistics" },
+    { "latency",     COMMAND_REQUEST_LATENCY,     NULL,            "sample-to-photon latency p50/p99" },
+    { "reset-stats", COMMAND_REQUEST_RESET_STATS, NULL,            "clear pipeline and latency statistics" },
+    { "config",      COMMAND_REQUEST_CONFIG,      NULL,            "build and display configuration" },
+    { "telemetry",   COMMAND_REQUEST_TELEMETRY,   NULL,            "binary telemetry frame (type 0x81)" },
+    { "boot",        COMMAND_REQUEST_BOOT_TRACE,  NULL,            "boot phase trace" },
+    { "view",        COMMAND_REQUEST_SET_VIEW,    parse_view_args, "meters | trend [1s|10s|1m]" },
+    { "help",        0,                           print_help,      "this list" },
+};
+
+#define COMMAND_COUNT (sizeof(command_table) / sizeof(command_table[0]))
+
+// ============================================================================
+// ARGUMENT PARSERS (ingest task)
+// ============================================================================
+
+/**
+ * @brief "view meters" or "view trend [tier]" (default tier 10s)
+ */
+static bool parse_view_args(const char *args) {
+    if (strcmp(args, "meters") == 0) {
+        requested_view.store(UI_VIEW_METERS, std::memory_order_relaxed);
+        return true;
+    }
+    if (strncmp(args, "trend", 5) != 0 || (args[5] != '\0' && args[5] != ' ')) {
+        return false;
+    }
+    int tier = args[5] ? metric_history_find_tier(args + 6) : HISTORY_TIER_10S;
+    if (tier < 0) {
+        return false;
+    }
+    requested_view.store(UI_VIEW_TREND | ((uint32_t)tier << 8), std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Report keep-alive and streaming support and the timeouts a host must beat
+ *
+ * One line, so a host can negotiate change-driven or streaming mode:
+ * "link: keepalive stream blank_timeout_ms=N hide_timeout_ms=N credits=N"
+ *
+ * A host asks this after connecting, so its sequence starts afresh.
+ */
+static bool print_link_info(const char *args) {
+    if (args[0] != '\0') {
+        return false;
+    }
+    serial_link_reset_sequence();
+    Serial.printf("link: keepalive stream blank_timeout_ms=%lu hide_timeout_ms=%lu credits=%u\n",
+                  (unsigned long)DISPLAY_BLANK_TIMEOUT_MS, (unsigned long)METER_HIDE_TIMEOUT_MS,
+                  (unsigned)SERIAL_CREDIT_WINDOW);
+    return true;
+}
+
+/**
+ * @brief "stream" / "stream on" enables credit acks, "stream off" ends them
+ *
+ * Enabling makes the first ack due at once; it is the reply. The sequence
+ * is kept: a host repeats "stream" when an ack went missing mid-stream.
+ */
+static bool set_streaming(const char *args) {
+    if (args[0] == '\0' || strcmp(args, "on") == 0) {
+        serial_link_set_acks(true);
+        return true;
+    }
+    if (strcmp(args, "off") == 0) {
+        serial_link_set_acks(false);
+        Serial.println("stream: off");
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief List all commands (only reads the constant table)
+ */
+static bool print_help(const char *args) {
+    if (args[0] != '\0') {
+        return false;
+    }
+    Serial.println("Commands:");
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        Serial.printf("  %-12s %s\n", command_table[i].name, command_table[i].help);
+    }
+    return true;
+}
+
+// ============================================================================
+// RESPONSES (render task)
+// ============================================================================
+
+/**
+ * @brief Append printf-formatted text to response_buffer
+ * @return New length (capped at the buffer size - 1)
+ */
+static size_t response_append(size_t length, const char *format, ...) {
+    if (length + 1 >= sizeof(response_buffer)) {
+        return length;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(response_buffer + length, sizeof(response_buffer) - length, format, args);
+    va_end(args);
+    if (written < 0) {
+        return length;
+    }
+    length += (size_t)written;
+    return length < sizeof(response_buffer) ? length : sizeof(response_buffer) - 1;
+}
+
+/**
+ * @brief Print the build and display configuration
+ */
+static void print_config() {
+    size_t n = 0;
+    n = response_append(n, "Configuration:\n");
+    n = response_append(n, "  Display: %ux%u, SPI %lu MHz, %s byte order, round mask %s\n",
+                        (unsigned)SCREEN_WIDTH, (unsigned)SCREEN_HEIGHT,
+                        (unsigned long)(display.get_write_frequency() / 1000000),
+                        LV_COLOR_16_SWAP ? "panel" : "native", DISPLAY_ROUND_MASK ? "on" : "off");
+    if (DISPLAY_FULL_FRAME) {
+        n = response_append(n, "  Buffers: full frame in %s (falls back to %u-line stripes)\n",
+                            DISPLAY_FULL_FRAME == 2 ? "PSRAM" : "SRAM", (unsigned)DISPLAY_BUFFER_LINES);
+    } else {
+        n = response_append(n, "  Buffers: %u-line stripes, %s\n", (unsigned)DISPLAY_BUFFER_LINES,
+                            DISPLAY_DOUBLE_BUFFER ? "double-buffered DMA" : "single blocking");
+    }
+    n = response_append(n, "  Refresh: %u ms active, %u ms idle\n",
+                        (unsigned)DISPLAY_REFR_ACTIVE_MS, (unsigned)DISPLAY_REFR_IDLE_MS);
+    n = response_append(n, "  Meters: %s, %s renderer\n",
+                        UI_METER_STATIC_CACHE ? "cached layers" : "lv_meter",
+                        UI_DEFAULT_METER_RENDERER == METER_RENDERER_SPRITE ? "sprite" : "LVGL");
+    n = response_append(n, "  Timeouts: hide meter %lu ms, blank %lu ms\n",
+                        (unsigned long)METER_HIDE_TIMEOUT_MS, (unsigned long)DISPLAY_BLANK_TIMEOUT_MS);
+    n = response_append(n, "  Link: line buffer %u bytes, queue %u samples, frame payload <= %u bytes\n",
+                        (unsigned)SERIAL_LINE_BUFFER_SIZE, (unsigned)SAMPLE_QUEUE_LENGTH,
+                        (unsigned)SAMPLE_FRAME_MAX_PAYLOAD);
+    n = response_append(n, "  LVGL heap: %u bytes, perf stats %s\n", (unsigned)LV_MEM_SIZE,
+                        PERF_STATS_ENABLE ? "on" : "off");
+    n = response_append(n, "  Metrics:");
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        n = response_append(n, " %s", metric_descriptors[id].key);
+    }
+    response_append(n, "\n");
+    Serial.print(response_buffer);
+}
+
+/**
+ * @brief Clamp a statistic into a 16-bit telemetry field
+ */
+static uint16_t clamp_u16(uint32_t value) {
+    return value > UINT16_MAX ? UINT16_MAX : (uint16_t)value;
+}
+
+static_assert(sizeof(telemetry_frame_payload_t) <= SAMPLE_FRAME_MAX_PAYLOAD, "telemetry exceeds one frame");
+
+/**
+ * @brief Send device health as one binary frame
+ */
+static void send_telemetry() {
+    telemetry_frame_payload_t t;
+    perf_summary_t fps, render, flush;
+    perf_stats_get(PERF_FPS, &fps);
+    perf_stats_get(PERF_FRAME_RENDER, &render);
+    perf_stats_get(PERF_FLUSH, &flush);
+    latency_summary_t latency;
+    latency_trace_get(LATENCY_FLUSH, &latency);
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+
+    t.uptime_ms = millis();
+    t.frames = display_refresh_stats.frames;
+    t.fps = clamp_u16(fps.avg);
+    t.render_avg_us = clamp_u16(render.avg);
+    t.flush_avg_us = clamp_u16(flush.avg);
+    t.lvgl_used_pct = mem.used_pct;
+    t.lvgl_frag_pct = mem.frag_pct;
+    t.heap_free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    t.heap_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    t.heap_largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    t.lvgl_max_used = mem.max_used;
+    t.samples_decoded = serial_link_stats.samples_decoded;
+    t.lines_garbage = serial_link_stats.lines_garbage;
+    t.lines_overlong = serial_link_stats.lines_overlong;
+    t.frames_crc_error = serial_link_stats.frames_crc_error;
+    t.frames_invalid = serial_link_stats.frames_invalid;
+    t.queue_dropped = sample_queue_dropped();
+    t.latency_p50_us = latency.p50_us;
+    t.latency_p99_us = latency.p99_us;
+
+    uint8_t frame[SAMPLE_FRAME_MAX_SIZE];
+    size_t size = sample_frame_encode(frame, SAMPLE_FRAME_TYPE_TELEMETRY, &t, sizeof(t));
+    Serial.write(frame, size);
+}
+
+// ============================================================================
+// COMMAND CHANNEL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Set the task that carries out posted requests
+ */
+void command_channel_init(TaskHandle_t render_task) {
+    render_task_handle = render_task;
+}
+
+/**
+ * @brief Execute one command line
+ */
+void command_channel_dispatch(const char *command) {
+    const char *space = strchr(command, ' ');
+    size_t name_length = space ? (size_t)(space - command) : strlen(command);
+    const char *args = space ? space + 1 : "";
+
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        const command_entry_t *entry = &command_table[i];
+        if (strncmp(entry->name, command, name_length) != 0 || entry->name[name_length] != '\0') {
+            continue;
+        }
+
+        bool valid = entry->parse_args ? entry->parse_args(args) : args[0] == '\0';
+        if (!valid) {
+            Serial.printf("Invalid arguments: %s\n", command);
+        } else if (entry->request) {
+            pending_requests.fetch_or(entry->request, std::memory_order_release);
+            if (render_task_handle) {
+                xTaskNotifyGive(render_task_handle);
+            }
+        }
+        return;
+    }
+    Serial.printf("Unknown command: %s (try \"help\")\n", command);
+}
+
+/**
+ * @brief Send a credit ack if one is due
+ *
+ * "ack: seq=S credits=C depth=D": the host may send updates up to S + C.
+ * Samples still waiting for the render task reduce the credits, so a busy
+ * render core slows the host down; at least SERIAL_ACK_INTERVAL credits
+ * are granted so the next ack is always reached.
+ */
+void command_channel_send_ack() {
+    uint32_t seq;
+    if (!serial_link_ack_due(&seq)) {
+        return;
+    }
+    uint32_t depth = sample_queue_depth() + (sample_queue_pending() ? 1 : 0);
+    uint32_t credits = depth < SERIAL_CREDIT_WINDOW ? SERIAL_CREDIT_WINDOW - depth : 0;
+    if (credits < SERIAL_ACK_INTERVAL) {
+        credits = SERIAL_ACK_INTERVAL;
+    }
+    Serial.printf("ack: seq=%lu credits=%lu depth=%lu\n",
+                  (unsigned long)seq, (unsigned long)credits, (unsigned long)depth);
+    serial_link_stats.acks_sent++;
+}
+
+/**
+ * @brief Carry out requests posted by commands
+ */
+void command_channel_process() {
+    uint32_t requests = pending_requests.exchange(0, std::memory_order_acquire);
+    if (requests == 0) {
+        return;
+    }
+
+    if (requests & COMMAND_REQUEST_KEEPALIVE) {
+        sample_apply_keepalive();
+    }
+    if (requests & COMMAND_REQUEST_STATUS) {
+        system_format_status(response_buffer, sizeof(response_buffer));
+        Serial.print(response_buffer);
+    }
+    if (requests & COMMAND_REQUEST_STATS) {
+        perf_stats_print(Serial);
+    }
+    if (requests & COMMAND_REQUEST_LATENCY) {
+        latency_trace_print(Serial);
+    }
+    if (requests & COMMAND_REQUEST_RESET_STATS) {
+        perf_stats_reset();
+        latency_trace_reset();
+        Serial.println("Pipeline statistics reset");
+    }
+    if (requests & COMMAND_REQUEST_CONFIG) {
+        print_config();
+    }
+    if (requests & COMMAND_REQUEST_TELEMETRY) {
+        send_telemetry();
+    }
+    if (requests & COMMAND_REQUEST_BOOT_TRACE) {
+        boot_trace_print(Serial);
+    }
+    if (requests & COMMAND_REQUEST_SET_VIEW) {
+        uint32_t view = requested_view.load(std::memory_order_relaxed);
+        ui_set_view((ui_view_t)(view & 0xFF), (history_tier_t)(view >> 8));
+    }
+}
@@ -11,7 +11,11 @@
  */
 
 #include "display_driver.h"
+#include "boot_trace.h"
+#include "perf_stats.h"
+#include "latency_trace.h"
 #include <Arduino.h>
+#include <esp_pm.h>
 
 // ============================================================================
 // GLOBAL VARIABLES
@@ -25,6 +29,36 @@ const uint16_t SCREEN_HEIGHT = 240;  ///< Display height in pixels
 
 DisplayDriver display;  ///< Global display driver instance
 
+display_refresh_stats_t display_refresh_stats;  ///< Refresh counters (render task only)
+
+static lv_disp_draw_buf_t draw_buf;                 ///< LVGL draw buffer descriptor
+static lv_disp_drv_t disp_drv;                      ///< LVGL display driver
+static lv_color_t *draw_buffers[2] = {NULL, NULL};  ///< DMA-capable pixel buffers
+static bool double_buffered = false;                ///< Overlapped DMA flush active
+static bool dma_spans = false;                      ///< Double-buffered round mask sends spans, not stripes
+
+#define TILES_X (240 / DISPLAY_TILE_SIZE)  ///< Tile columns in full-frame mode
+#define TILES_Y (240 / DISPLAY_TILE_SIZE)  ///< Tile rows in full-frame mode
+
+static uint16_t *shadow_frame = NULL;           ///< Copy of the frame as sent to the panel (PSRAM), or NULL
+static uint64_t tile_hashes[TILES_Y][TILES_X];  ///< Hash of each tile as last sent (without shadow frame)
+static bool tile_dirty[TILES_Y][TILES_X];       ///< Tile changed in the current frame
+static bool tile_state_valid = false;           ///< false = panel content unknown, send all
+
+static uint8_t round_span_start[240];  ///< First visible column per row (spans are symmetric)
+
+static uint32_t frame_flush_cycles = 0;  ///< Cycles spent in flush_cb during the current refresh
+static uint32_t frame_flush_px = 0;      ///< Pixels pushed during the current refresh
+static uint32_t frame_first_flush_us = 0; ///< micros() at the first flush that pushed pixels
+static display_frame_hook_t frame_hook = NULL;  ///< Optional refresh observer
+
+static uint32_t refresh_active_ms = DISPLAY_REFR_ACTIVE_MS;  ///< Period while animating
+static uint32_t refresh_idle_ms = DISPLAY_REFR_IDLE_MS;      ///< Period while idle
+static bool refresh_active = false;                          ///< Active period selected
+
+static bool low_power = false;           ///< Blanked low-power mode active
+static uint32_t active_cpu_mhz = 0;      ///< CPU clock to restore when leaving low power
+
 // ============================================================================
 // DISPLAYDRIVER CLASS IMPLEMENTATION
 // ============================================================================
@@ -39,6 +73,7 @@ DisplayDriver display;  ///< Global display driver instance
  * - Mode: 0 (CPOL=0, CPHA=0)
  * - Write Speed: 27MHz (safe maximum for stable operation)
  * - Read Speed: 16MHz (conservative for reliable data reading)
+ * - DMA: Automatic channel selection (required for pushImageDMA)
  * 
  * Pin Assignments (ESP32-S3 specific):
  * - SCLK (Clock): GPIO 1
@@ -58,12 +93,13 @@ DisplayDriver::DisplayDriver(void) {
 
     bus_config.spi_host   = SPI2_HOST;  // ESP32-S3 supports SPI2_HOST
     bus_config.spi_mode   = 0;          // SPI mode 0 (CPOL=0, CPHA=0)
-    bus_config.freq_write = 27000000;   // 27MHz write speed (safe maximum)
+    bus_config.freq_write = DISPLAY_SPI_WRITE_HZ;  // 27MHz write speed (safe maximum)
     bus_config.freq_read  = 16000000;   // 16MHz read speed (conservative)
     bus_config.pin_sclk   = 1;          // Serial clock pin
     bus_config.pin_mosi   = 2;          // Master out, slave in (data)
     bus_config.pin_miso   = -1;         // Not used for display
     bus_config.pin_dc     = 4;          // Data/command selection pin
+    bus_config.dma_channel = SPI_DMA_CH_AUTO; // DMA for asynchronous pixel pushes
 
     bus.config(bus_config);
     panel.setBus(&bus);
@@ -85,6 +121,25 @@ DisplayDriver::DisplayDriver(void) {
   setPanel(&panel);  // Register panel with LovyanGFX
 }
 
+/**
+ * @brief Change the SPI write clock
+ * 
+ * LovyanGFX recomputes the clock divider at the start of the next
+ * transaction after the bus configuration changed.
+ */
+void DisplayDriver::set_write_frequency(uint32_t freq_write_hz) {
+  auto bus_config = bus.config();
+  bus_config.freq_write = freq_write_hz;
+  bus.config(bus_config);
+}
+
+/**
+ * @brief Current SPI write clock
+ */
+uint32_t DisplayDriver::get_write_frequency() {
+  return bus.config().freq_write;
+}
+
 // ============================================================================
 // LVGL TIMER SYSTEM
 // ============================================================================
@@ -132,6 +187,257 @@ void lvgl_timer_init() {
 // LVGL DISPLAY INTEGRATION
 // ============================================================================
 
+/**
+ * @brief Build the visible span table of the 240 px circle
+ * 
+ * A pixel is visible when its center lies inside the circle. Computed in
+ * doubled integer coordinates so no floating point is involved.
+ */
+static void round_mask_init() {
+  for (int32_t y = 0; y < 240; y++) {
+    int32_t dy = 2 * y + 1 - 240;
+    int32_t x = 0;
+    while (x < 119 && (2 * x + 1 - 240) * (2 * x + 1 - 240) + dy * dy > 240 * 240) {
+      x++;
+    }
+    round_span_start[y] = (uint8_t)x;
+  }
+}
+
+/**
+ * @brief Last visible column of a row
+ */
+static inline int32_t round_span_end(int32_t y) {
+  return 239 - round_span_start[y];
+}
+
+/**
+ * @brief Whether no pixel of an area lies inside the circle
+ * 
+ * The row of the area closest to the center has the widest span, so the
+ * area is visible exactly when its columns overlap that row's span.
+ */
+static bool area_outside_circle(const lv_area_t *area) {
+  int32_t y = area->y1 > 119 ? area->y1 : (area->y2 < 119 ? area->y2 : 119);
+  return area->x2 < round_span_start[y] || area->x1 > round_span_end(y);
+}
+
+/**
+ * @brief LVGL rounder callback - trims invalidated areas to the circle
+ * 
+ * Columns are cut to the widest visible span of the area's rows, then rows
+ * whose span misses the remaining columns are cut from the top and bottom.
+ * Areas entirely outside the circle are left alone here (an area cannot be
+ * dropped by the rounder) and are culled before the refresh instead.
+ */
+static void display_rounder_callback(lv_disp_drv_t *display_driver, lv_area_t *area) {
+  if (area_outside_circle(area)) {
+    return;
+  }
+
+  int32_t y = area->y1 > 119 ? area->y1 : (area->y2 < 119 ? area->y2 : 119);
+  if (area->x1 < round_span_start[y]) area->x1 = round_span_start[y];
+  if (area->x2 > round_span_end(y)) area->x2 = round_span_end(y);
+
+  while (area->y1 < area->y2 &&
+         (area->x2 < round_span_start[area->y1] || area->x1 > round_span_end(area->y1))) {
+    area->y1++;
+  }
+  while (area->y2 > area->y1 &&
+         (area->x2 < round_span_start[area->y2] || area->x1 > round_span_end(area->y2))) {
+    area->y2--;
+  }
+}
+
+/**
+ * @brief Drop invalidated areas that are entirely outside the circle
+ * 
+ * Marking an area as joined makes LVGL skip it, the same as for areas
+ * merged into a larger one.
+ */
+static void cull_outside_areas(lv_disp_t *disp) {
+  for (uint16_t i = 0; i < disp->inv_p; i++) {
+    if (!disp->inv_area_joined[i] && area_outside_circle(&disp->inv_areas[i])) {
+      disp->inv_area_joined[i] = 1;
+    }
+  }
+}
+
+/**
+ * @brief Send a rectangle of contiguous pixels (DMA when double-buffered)
+ */
+static void push_rect(int32_t x, int32_t y, int32_t w, int32_t h, lv_color_t *pixels) {
+  if (double_buffered) {
+    display.pushImageDMA(x, y, w, h, (display_pixel_t *)pixels);
+  } else {
+    display.setAddrWindow(x, y, w, h);
+    display.pushPixels((display_pixel_t *)pixels, w * h);
+  }
+}
+
+/**
+ * @brief Send only the visible part of a stripe
+ * 
+ * Consecutive rows that are visible over the full stripe width go out as
+ * one window; other rows are sent as their visible span. Meant for the
+ * blocking path, where a window is only an address command in the open
+ * transaction; with DMA every span would wait for the previous transfer.
+ * 
+ * @return Pixels sent
+ */
+static uint32_t push_visible_spans(const lv_area_t *area, lv_color_t *pixels) {
+  int32_t w = area->x2 - area->x1 + 1;
+  uint32_t sent_px = 0;
+
+  int32_t y = area->y1;
+  while (y <= area->y2) {
+    lv_color_t *row = pixels + (y - area->y1) * w;
+    int32_t start = LV_MAX(area->x1, round_span_start[y]);
+    int32_t end = LV_MIN(area->x2, round_span_end(y));
+
+    if (start == area->x1 && end == area->x2) {
+      int32_t rows = 1;
+      while (y + rows <= area->y2 && round_span_start[y + rows] <= area->x1 &&
+             round_span_end(y + rows) >= area->x2) {
+        rows++;
+      }
+      push_rect(area->x1, y, w, rows, row);
+      sent_px += w * rows;
+      y += rows;
+      continue;
+    }
+
+    if (start <= end) {
+      push_rect(start, y, end - start + 1, 1, row + (start - area->x1));
+      sent_px += end - start + 1;
+    }
+    y++;
+  }
+  return sent_px;
+}
+
+/**
+ * @brief Rotate a 64-bit value left
+ */
+static inline uint64_t rotl64(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+/**
+ * @brief 64-bit MurmurHash3-style hash of one framebuffer tile
+ *
+ * Every 4-pixel block is mixed with multiply and rotate, so a change in
+ * any bit reaches the whole state, and the fmix64 finalizer avalanches
+ * the result. A plain multiply-xor hash only carries changes upward, so
+ * two flips of the same high bit cancel out and the tile is never sent.
+ */
+static uint64_t hash_tile(const uint16_t *frame, int32_t tx, int32_t ty) {
+  const uint64_t c1 = 0x87c37b91114253d5ULL;
+  const uint64_t c2 = 0x4cf5ad432745937fULL;
+  const uint16_t *row = frame + (ty * DISPLAY_TILE_SIZE) * SCREEN_WIDTH + tx * DISPLAY_TILE_SIZE;
+  uint64_t hash = 0x9e3779b97f4a7c15ULL;
+  for (int32_t y = 0; y < DISPLAY_TILE_SIZE; y++, row += SCREEN_WIDTH) {
+    for (int32_t x = 0; x < DISPLAY_TILE_SIZE; x += 4) {
+      uint64_t block;
+      memcpy(&block, &row[x], sizeof(block));  // Four pixels per step
+      block = rotl64(block * c1, 31) * c2;
+      hash = rotl64(hash ^ block, 27) * 5 + 0x52dce729;
+    }
+  }
+
+  // fmix64
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/**
+ * @brief Check a tile against what the panel shows and record it as sent
+ *
+ * With a shadow frame the tile is compared exactly and copied over when
+ * it differs. Without one its 64-bit hash is compared; a change that
+ * keeps the hash (about 2^-64 per changed tile) stays on the panel until
+ * the tile changes again or the next full redraw (buffer reconfiguration).
+ *
+ * @return true if the tile must be sent
+ */
+static bool tile_changed(const uint16_t *frame, int32_t tx, int32_t ty) {
+  if (shadow_frame) {
+    size_t offset = (ty * DISPLAY_TILE_SIZE) * SCREEN_WIDTH + tx * DISPLAY_TILE_SIZE;
+    const size_t row_bytes = DISPLAY_TILE_SIZE * sizeof(uint16_t);
+    bool changed = !tile_state_valid;
+    for (int32_t y = 0; y < DISPLAY_TILE_SIZE; y++, offset += SCREEN_WIDTH) {
+      if (changed || memcmp(&frame[offset], &shadow_frame[offset], row_bytes) != 0) {
+        memcpy(&shadow_frame[offset], &frame[offset], row_bytes);
+        changed = true;
+      }
+    }
+    return changed;
+  }
+
+  uint64_t hash = hash_tile(frame, tx, ty);
+  if (tile_state_valid && hash == tile_hashes[ty][tx]) {
+    return false;
+  }
+  tile_hashes[ty][tx] = hash;
+  return true;
+}
+
+/**
+ * @brief Push the tiles of a frame that differ from what the panel shows
+ * 
+ * Only tiles overlapping this refresh's invalidated areas are checked; a
+ * tile is sent when it differs from what was last sent (see
+ * tile_changed()). Adjacent changed tiles of a tile row are merged into one
+ * address window and sent row by row from the framebuffer.
+ * 
+ * @param frame Full-screen framebuffer
+ * @return Pixels sent
+ */
+static uint32_t flush_changed_tiles(const lv_color_t *frame) {
+  const uint16_t *pixels = (const uint16_t *)frame;
+  lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+
+  memset(tile_dirty, 0, sizeof(tile_dirty));
+  for (uint16_t i = 0; i < disp->inv_p; i++) {
+    if (disp->inv_area_joined[i]) continue;
+    const lv_area_t *area = &disp->inv_areas[i];
+    for (int32_t ty = area->y1 / DISPLAY_TILE_SIZE; ty <= area->y2 / DISPLAY_TILE_SIZE; ty++) {
+      for (int32_t tx = area->x1 / DISPLAY_TILE_SIZE; tx <= area->x2 / DISPLAY_TILE_SIZE; tx++) {
+        if (tile_dirty[ty][tx]) continue;
+        tile_dirty[ty][tx] = tile_changed(pixels, tx, ty);
+      }
+    }
+  }
+  tile_state_valid = true;
+
+  uint32_t sent_px = 0;
+  display.startWrite();
+  for (int32_t ty = 0; ty < TILES_Y; ty++) {
+    for (int32_t tx = 0; tx < TILES_X; tx++) {
+      if (!tile_dirty[ty][tx]) continue;
+
+      int32_t run = 1;
+      while (tx + run < TILES_X && tile_dirty[ty][tx + run]) run++;
+
+      int32_t x = tx * DISPLAY_TILE_SIZE;
+      int32_t y = ty * DISPLAY_TILE_SIZE;
+      int32_t w = run * DISPLAY_TILE_SIZE;
+      display.setAddrWindow(x, y, w, DISPLAY_TILE_SIZE);
+      for (int32_t row = 0; row < DISPLAY_TILE_SIZE; row++) {
+        display.pushPixels((display_pixel_t *)&pixels[(y + row) * SCREEN_WIDTH + x], w);
+      }
+      sent_px += w * DISPLAY_TILE_SIZE;
+      tx += run - 1;
+    }
+  }
+  display.endWrite();
+  return sent_px;
+}
+
 /**
  * @brief LVGL display flush callback - transfers pixel data to physical display
  * 
@@ -139,36 +445,171 @@ void lvgl_timer_init() {
  * It efficiently transfers pixel data from LVGL's internal buffer to the
  * physical display via SPI communication.
  * 
- * Process:
- * 1. Calculate update region dimensions
- * 2. Start SPI transaction for optimal performance
- * 3. Set display address window to target region
- * 4. Push pixel data in RGB565 format
- * 5. End SPI transaction
- * 6. Notify LVGL that flush is complete
+ * Double-buffered mode (DISPLAY_DOUBLE_BUFFER = 1, or selected at runtime
+ * with display_configure_buffers()):
+ * 1. Queue the stripe with pushImageDMA() - LovyanGFX first waits for the
+ *    DMA of the previous stripe, which lives in the other buffer
+ * 2. Notify LVGL immediately so it renders the next stripe into the other
+ *    buffer while this one is still being transferred
+ * 
+ * The SPI transaction is held open permanently (see display_init()) so the
+ * DMA transfer is never forced to complete when the callback returns.
+ * 
+ * Single-buffered mode:
+ * 1. Start SPI transaction, set address window, push pixels (blocking)
+ * 2. End SPI transaction and notify LVGL that flush is complete
+ * 
+ * With DISPLAY_ROUND_MASK only the part of each row inside the visible
+ * circle is sent (see push_visible_spans()).
+ * 
+ * Full-frame direct mode (display_configure_full_frame()):
+ * LVGL renders every area in place into the framebuffer and calls this
+ * once per area; after the last area only changed tiles are sent.
  * 
  * @param disp Pointer to LVGL display driver structure
  * @param area Pointer to screen area that needs updating (x1,y1 to x2,y2)
  * @param color_p Pointer to pixel color data buffer in RGB565 format
  */
 void display_flush_callback(lv_disp_drv_t *display_driver, const lv_area_t *update_area, lv_color_t *color_buffer) {
+  uint32_t flush_start = perf_stats_cycles();
+  if (frame_flush_px == 0) {
+    frame_first_flush_us = micros();  // Kept once this flush pushes pixels
+  }
+
   // Calculate dimensions of update region
   int32_t w = update_area->x2 - update_area->x1 + 1;  // Width in pixels
   int32_t h = update_area->y2 - update_area->y1 + 1;  // Height in pixels
 
-  // Perform efficient SPI transfer
-  display.startWrite();                                           // Begin SPI transaction
-  display.setAddrWindow(update_area->x1, update_area->y1, w, h); // Set target region
-  display.pushPixels((lgfx::rgb565_t *)color_buffer, w * h);     // Transfer pixel data
-  display.endWrite();                                            // End SPI transaction
+  if (display_driver->direct_mode) {
+    // Whole frame is in place once the last area was rendered
+    uint32_t px = lv_disp_flush_is_last(display_driver) ? flush_changed_tiles(color_buffer) : 0;
+    uint32_t flush_cycles = perf_stats_cycles() - flush_start;
+    if (px > 0) {
+      PERF_RECORD_CYCLES(PERF_FLUSH, flush_cycles);
+    }
+    frame_flush_cycles += flush_cycles;
+    frame_flush_px += px;
+    lv_disp_flush_ready(display_driver);
+    return;
+  }
+
+  uint32_t px = w * h;
+  if (!double_buffered) {
+    display.startWrite();  // Blocking transfer in its own SPI transaction
+  }
+  if (DISPLAY_ROUND_MASK && (!double_buffered || dma_spans)) {
+    px = push_visible_spans(update_area, color_buffer);
+  } else {
+    // Whole rectangle (already trimmed to the circle by the rounder) as one
+    // transfer; when double-buffered the previous stripe's DMA is awaited inside
+    push_rect(update_area->x1, update_area->y1, w, h, color_buffer);
+  }
+  if (!double_buffered) {
+    display.endWrite();
+  }
+
+  uint32_t flush_cycles = perf_stats_cycles() - flush_start;
+  PERF_RECORD_CYCLES(PERF_FLUSH, flush_cycles);
+  frame_flush_cycles += flush_cycles;
+  frame_flush_px += px;
+
+  lv_disp_flush_ready(display_driver);  // Notify LVGL that the buffer may be reused
+}
+
+/**
+ * @brief LVGL monitor callback - records pixels refreshed per frame
+ * 
+ * Called by LVGL after every completed refresh with the refresh duration
+ * and the number of pixels rendered (the size of all invalidated areas).
+ * 
+ * @param display_driver Pointer to LVGL display driver structure
+ * @param time Refresh duration in milliseconds
+ * @param px Number of pixels refreshed
+ */
+static void display_monitor_callback(lv_disp_drv_t *display_driver, uint32_t time, uint32_t px) {
+  display_refresh_stats.frames++;
+  display_refresh_stats.last_frame_px = px;
+  display_refresh_stats.last_frame_ms = time;
+  display_refresh_stats.total_px += px;
+  if (px > display_refresh_stats.max_frame_px) {
+    display_refresh_stats.max_frame_px = px;
+  }
+}
+
+/**
+ * @brief Instrumented replacement for LVGL's display refresh timer callback
+ * 
+ * Wraps _lv_disp_refr_timer() to time each complete refresh with the cycle
+ * counter. The time spent inside flush_cb is subtracted to obtain the pure
+ * render time. Refresh calls that flushed nothing are not counted as frames.
+ * A frame that flushed pixels completes the sample followed by the latency
+ * trace. With DISPLAY_ROUND_MASK, areas outside the visible circle are
+ * culled first.
+ * 
+ * @param timer LVGL refresh timer of the display
+ */
+static void display_refresh_timer_callback(lv_timer_t *timer) {
+  frame_flush_cycles = 0;
+  frame_flush_px = 0;
+
+  if (DISPLAY_ROUND_MASK) {
+    cull_outside_areas((lv_disp_t *)timer->user_data);
+  }
+
+  uint32_t frame_start = perf_stats_cycles();
+  _lv_disp_refr_timer(timer);
+  uint32_t frame_cycles = perf_stats_cycles() - frame_start;
+
+  if (frame_flush_px == 0) {
+    return;
+  }
 
-  lv_disp_flush_ready(display_driver);  // Notify LVGL that flush is complete
+  latency_trace_frame_flushed(frame_first_flush_us, micros());
+  PERF_RECORD_CYCLES(PERF_FRAME_TOTAL, frame_cycles);
+  PERF_RECORD_CYCLES(PERF_FRAME_RENDER, frame_cycles - frame_flush_cycles);
+  PERF_RECORD_VALUE(PERF_FRAME_PIXELS, frame_flush_px);
+#if PERF_STATS_ENABLE
+  perf_stats_frame_done();
+#endif
+
+  if (frame_hook) {
+    uint32_t mhz = getCpuFrequencyMhz();
+    frame_hook(frame_cycles / mhz, frame_flush_cycles / mhz, frame_flush_px);
+  }
 }
 
 // ============================================================================
 // SYSTEM INITIALIZATION
 // ============================================================================
 
+/**
+ * @brief Draw the first boot spinner frame directly through LovyanGFX
+ * 
+ * Runs before lv_init() so the panel shows the spinner within milliseconds
+ * of reset. The arc matches the boot animation's first frame (0° at three
+ * o'clock, rounded ends), so LVGL's first refresh takes over without a jump.
+ */
+static void display_draw_splash() {
+  const int32_t cx = SCREEN_WIDTH / 2;
+  const int32_t cy = SCREEN_HEIGHT / 2;
+  const int32_t r_outer = DISPLAY_SPLASH_SIZE / 2;
+  const int32_t r_inner = r_outer - DISPLAY_SPLASH_WIDTH;
+  const uint32_t color = lgfx::color888(DISPLAY_SPLASH_COLOR >> 16, (DISPLAY_SPLASH_COLOR >> 8) & 0xFF,
+                                        DISPLAY_SPLASH_COLOR & 0xFF);
+
+  display.startWrite();
+  display.fillScreen(TFT_BLACK);
+  display.fillArc(cx, cy, r_outer - 1, r_inner, 0, DISPLAY_SPLASH_ARC, color);
+
+  // Rounded ends
+  const float r_mid = (r_outer + r_inner) / 2.0f;
+  const float end_rad = DISPLAY_SPLASH_ARC * (float)M_PI / 180.0f;
+  display.fillCircle(cx + (int32_t)r_mid, cy, DISPLAY_SPLASH_WIDTH / 2, color);
+  display.fillCircle(cx + (int32_t)(r_mid * cosf(end_rad)), cy + (int32_t)(r_mid * sinf(end_rad)),
+                     DISPLAY_SPLASH_WIDTH / 2, color);
+  display.endWrite();
+}
+
 /**
  * @brief Complete display and LVGL system initialization
  * 
@@ -177,16 +618,18 @@ void display_flush_callback(lv_disp_drv_t *display_driver, const lv_area_t *upda
  * 1. Hardware Initialization:
  *    - Initialize DisplayDriver (SPI, pins, panel settings)
  *    - Set display rotation to 0° (portrait orientation)
- *    - Initialize backlight control (GPIO21)
+ *    - Draw the boot splash, then turn on the backlight (GPIO21) so the
+ *      panel's power-on garbage is never visible
  * 
  * 2. LVGL Library Setup:
  *    - Initialize LVGL core library
  *    - Set up hardware timer for 1ms ticks
  * 
- * 3. Memory Management:
- *    - Allocate DMA-capable buffer (10 lines = 2400 pixels)
- *    - Buffer size: 240px × 10 lines × 2 bytes = 4800 bytes
- *    - Uses DMA for optimal SPI transfer performance
+ * 3. Memory Management (see display_configure_buffers()):
+ *    - Allocate DISPLAY_BUFFER_LINES high DMA-capable buffer(s)
+ *    - Buffer size: 240px × 20 lines × 2 bytes = 9600 bytes each (default)
+ *    - Two buffers when DISPLAY_DOUBLE_BUFFER is enabled so rendering and
+ *      SPI DMA transfer overlap
  * 
  * 4. Display Driver Registration:
  *    - Configure LVGL display driver structure
@@ -200,9 +643,11 @@ void display_init() {
   // Initialize the display hardware
   display.begin();         // Start DisplayDriver (SPI, panel initialization)
   display.setRotation(0);  // Set to portrait orientation (0°)
+  display_draw_splash();   // First spinner frame while the rest boots
 
   // Initialize backlight control
   backlight_init();        // Configure GPIO21 and turn on backlight
+  boot_trace_mark("splash");
 
   // Initialize LVGL graphics library
   lv_init();
@@ -210,23 +655,300 @@ void display_init() {
   // Initialize hardware timer for LVGL (must be done early)
   lvgl_timer_init();
 
-  // Allocate display buffer in DMA-capable memory for optimal performance
-  // Buffer size: 240 pixels × 10 lines × 2 bytes/pixel = 4800 bytes
-  static lv_disp_draw_buf_t draw_buf;
-  static lv_color_t *buf = (lv_color_t *)heap_caps_malloc(
-    SCREEN_WIDTH * 10 * sizeof(lv_color_t), 
-    MALLOC_CAP_DMA  // DMA-capable memory for fast SPI transfers
-  );
-  lv_disp_draw_buf_init(&draw_buf, buf, NULL, SCREEN_WIDTH * 10);
-
   // Register display driver with LVGL
-  static lv_disp_drv_t disp_drv;
   lv_disp_drv_init(&disp_drv);              // Initialize with defaults
+
+  // Allocate the framebuffer or stripe buffer(s); partial stripes in
+  // DMA-capable memory are the fallback if the framebuffer does not fit
+  bool configured = false;
+  if (DISPLAY_FULL_FRAME) {
+    configured = display_configure_full_frame(DISPLAY_FULL_FRAME == 2);
+  }
+  if (!configured) {
+    display_configure_buffers(DISPLAY_BUFFER_LINES, DISPLAY_DOUBLE_BUFFER);
+  }
+
   disp_drv.flush_cb = display_flush_callback; // Set pixel transfer callback
+  disp_drv.monitor_cb = display_monitor_callback; // Per-frame pixel counters
+  if (DISPLAY_ROUND_MASK) {
+    round_mask_init();
+    disp_drv.rounder_cb = display_rounder_callback; // Trim areas to the round panel
+  }
   disp_drv.draw_buf = &draw_buf;             // Assign drawing buffer
   disp_drv.hor_res = SCREEN_WIDTH;           // Set horizontal resolution
   disp_drv.ver_res = SCREEN_HEIGHT;          // Set vertical resolution
-  lv_disp_drv_register(&disp_drv);           // Register with LVGL
+  lv_disp_t *disp = lv_disp_drv_register(&disp_drv); // Register with LVGL
+
+  // Time every refresh for the pipeline statistics and frame hook
+  lv_timer_set_cb(disp->refr_timer, display_refresh_timer_callback);
+
+  // Start idle; the boot animation switches to the active period
+  display_set_refresh_period(refresh_idle_ms);
+  boot_trace_mark("lvgl");
+}
+
+// ============================================================================
+// RUNTIME RECONFIGURATION
+// ============================================================================
+
+/**
+ * @brief Replace the LVGL draw buffers
+ * 
+ * Any DMA still in flight is completed before the old buffers are freed,
+ * and the whole screen is invalidated so the next refresh uses the new
+ * buffers from scratch.
+ */
+static void install_buffers(lv_color_t *buf, lv_color_t *buf2, uint32_t pixels,
+                            bool double_buffer, bool direct_mode) {
+  // Finish transfers from the old buffers and leave the held transaction
+  if (double_buffered) {
+    display.waitDMA();
+    display.endWrite();
+  }
+  heap_caps_free(draw_buffers[0]);
+  heap_caps_free(draw_buffers[1]);
+  heap_caps_free(shadow_frame);
+  shadow_frame = NULL;
+
+  draw_buffers[0] = buf;
+  draw_buffers[1] = buf2;
+  double_buffered = double_buffer;
+  lv_disp_draw_buf_init(&draw_buf, buf, buf2, pixels);
+  disp_drv.direct_mode = direct_mode;
+  tile_state_valid = false;  // Send the first full frame completely
+
+  if (double_buffered) {
+    display.startWrite();
+  }
+
+  // Redraw everything once the driver is registered
+  if (lv_disp_get_default()) {
+    lv_obj_invalidate(lv_scr_act());
+  }
+}
+
+/**
+ * @brief Reallocate the LVGL draw buffers
+ * 
+ * Buffer size: 240 pixels × buffer_lines lines × 2 bytes/pixel each, in
+ * DMA-capable memory. With double buffering the SPI transaction is kept
+ * open permanently so DMA transfers run in the background instead of being
+ * awaited by endWrite() at the end of every flush.
+ */
+bool display_configure_buffers(uint16_t buffer_lines, bool double_buffer) {
+  const uint32_t buffer_pixels = (uint32_t)SCREEN_WIDTH * buffer_lines;
+  const size_t buffer_bytes = buffer_pixels * sizeof(lv_color_t);
+
+  lv_color_t *buf = (lv_color_t *)heap_caps_malloc(buffer_bytes, MALLOC_CAP_DMA);
+  lv_color_t *buf2 = NULL;
+  if (double_buffer && buf) {
+    // Second buffer: rendered while the first is on the wire
+    buf2 = (lv_color_t *)heap_caps_malloc(buffer_bytes, MALLOC_CAP_DMA);
+  }
+  if (!buf || (double_buffer && !buf2)) {
+    heap_caps_free(buf);
+    heap_caps_free(buf2);
+    Serial.printf("Display buffer allocation failed (%u lines)\n", (unsigned)buffer_lines);
+    return false;
+  }
+
+  install_buffers(buf, buf2, buffer_pixels, double_buffer, false);
+  return true;
+}
+
+/**
+ * @brief Switch to full-frame direct mode with tile diffing
+ * 
+ * One 240×240 RGB565 framebuffer (115200 bytes) holds the complete screen.
+ * Rendering happens in place at screen coordinates, so unchanged pixels
+ * are never re-rendered, and the flush sends only tiles whose content
+ * changed (blocking SPI, the same buffer is rendered into next).
+ *
+ * If PSRAM is available a second frame keeps a copy of what the panel
+ * shows, so changed tiles are found exactly; SRAM-only boards fall back
+ * to a 64-bit hash per tile.
+ */
+bool display_configure_full_frame(bool use_psram) {
+  const uint32_t frame_pixels = (uint32_t)SCREEN_WIDTH * SCREEN_HEIGHT;
+  const size_t frame_bytes = frame_pixels * sizeof(lv_color_t);
+
+  uint32_t caps = (use_psram ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+  lv_color_t *frame = (lv_color_t *)heap_caps_malloc(frame_bytes, caps);
+  if (!frame) {
+    Serial.printf("Framebuffer allocation failed (%s)\n", use_psram ? "PSRAM" : "SRAM");
+    return false;
+  }
+  uint16_t *shadow = (uint16_t *)heap_caps_malloc(frame_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!shadow) {
+    Serial.println("No PSRAM for a shadow frame - diffing tiles by hash");
+  }
+
+  install_buffers(frame, NULL, frame_pixels, false, true);
+  shadow_frame = shadow;
+  return true;
+}
+
+/**
+ * @brief Select span or whole-stripe DMA for the round mask
+ */
+void display_set_dma_spans(bool per_span) {
+  dma_spans = per_span;
+}
+
+/**
+ * @brief Change the SPI write clock
+ * 
+ * The held double-buffer transaction is closed around the change so the
+ * new clock divider takes effect on the next transfer.
+ */
+void display_set_spi_frequency(uint32_t freq_write_hz) {
+  if (double_buffered) {
+    display.waitDMA();
+    display.endWrite();
+  }
+  display.set_write_frequency(freq_write_hz);
+  if (double_buffered) {
+    display.startWrite();
+  }
+}
+
+/**
+ * @brief Change the LVGL display refresh period
+ */
+void display_set_refresh_period(uint32_t period_ms) {
+  lv_disp_t *disp = lv_disp_get_default();
+  if (disp && disp->refr_timer) {
+    lv_timer_set_period(disp->refr_timer, period_ms);
+  }
+}
+
+/**
+ * @brief Set the refresh periods used while animating and while idle
+ */
+void display_set_refresh_policy(uint32_t active_ms, uint32_t idle_ms) {
+  refresh_active_ms = active_ms;
+  refresh_idle_ms = idle_ms;
+  display_set_refresh_period(refresh_active ? active_ms : idle_ms);
+}
+
+/**
+ * @brief Switch between the active and idle refresh period
+ * 
+ * LVGL pauses the refresh timer when nothing is invalidated and resumes it
+ * on the next invalidation, so the idle period only bounds how quickly
+ * single updates (time text, trend columns) reach the panel; without
+ * invalidations the refresh timer does not run at all. When an animation
+ * ends, the timer is made ready so its last frame is not held back by the
+ * longer idle period.
+ */
+void display_set_refresh_active(bool active) {
+  if (active == refresh_active) {
+    return;
+  }
+  refresh_active = active;
+  display_set_refresh_period(active ? refresh_active_ms : refresh_idle_ms);
+
+  lv_disp_t *disp = lv_disp_get_default();
+  if (disp && disp->refr_timer) {
+    lv_timer_ready(disp->refr_timer);
+  }
+}
+
+/**
+ * @brief Register an observer for completed refreshes
+ */
+void display_set_frame_hook(display_frame_hook_t hook) {
+  frame_hook = hook;
+}
+
+// ============================================================================
+// LOW-POWER MODE
+// ============================================================================
+
+/**
+ * @brief Select the CPU clock and light sleep policy
+ * 
+ * With CONFIG_PM_ENABLE and tickless idle the power management driver owns
+ * the CPU clock and may enter light sleep whenever all tasks are blocked;
+ * the USB Serial/JTAG driver keeps the chip awake while the host is
+ * connected, so CDC RX still wakes the ingest task. Without it only the
+ * clock is lowered and idle time is spent in the FreeRTOS idle wait.
+ * An explicit esp_light_sleep_start() is not used: it would drop the USB
+ * link that is supposed to wake the display.
+ */
+static void apply_cpu_power(uint32_t cpu_mhz, bool light_sleep) {
+#if CONFIG_PM_ENABLE && CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  esp_pm_config_t pm_config = {};
+  pm_config.max_freq_mhz = cpu_mhz;
+  pm_config.min_freq_mhz = light_sleep ? 40 : cpu_mhz;
+  pm_config.light_sleep_enable = light_sleep;
+  if (esp_pm_configure(&pm_config) != ESP_OK) {
+    setCpuFrequencyMhz(cpu_mhz);
+  }
+#else
+  (void)light_sleep;
+  setCpuFrequencyMhz(cpu_mhz);
+#endif
+  perf_stats_set_cpu_mhz(getCpuFrequencyMhz());
+}
+
+/**
+ * @brief Enter the blanked low-power mode
+ * 
+ * Order matters: the last DMA transfer must complete and the held SPI
+ * transaction must be closed before the panel command, and the tick is
+ * stopped before the clock changes so no LVGL work runs in between.
+ */
+void display_enter_low_power() {
+  if (low_power) {
+    return;
+  }
+  low_power = true;
+
+  // Suspend LVGL time: no ticks, no due timers
+  timerStop(lvgl_timer);
+
+  // Panel sleep-in (frame memory is retained)
+  if (double_buffered) {
+    display.waitDMA();
+    display.endWrite();
+  }
+  display.sleep();
+
+  active_cpu_mhz = getCpuFrequencyMhz();
+  apply_cpu_power(DISPLAY_LOW_POWER_CPU_MHZ, true);
+
+  Serial.printf("Low-power mode: tick stopped, panel asleep, CPU %lu MHz\n",
+                (unsigned long)getCpuFrequencyMhz());
+}
+
+/**
+ * @brief Leave the blanked low-power mode
+ */
+void display_exit_low_power() {
+  if (!low_power) {
+    return;
+  }
+
+  apply_cpu_power(active_cpu_mhz, false);
+
+  // Panel sleep-out, then reopen the transaction held for double buffering
+  display.wakeup();
+  if (double_buffered) {
+    display.startWrite();
+  }
+
+  timerStart(lvgl_timer);
+  low_power = false;
+
+  Serial.println("Low-power mode left");
+}
+
+/**
+ * @brief Whether the low-power mode is active
+ */
+bool display_low_power_active() {
+  return low_power;
 }
 
 // ============================================================================
@@ -0,0 +1,256 @@
+/**
+ * @file latency_trace.cpp
+ * @brief Implementation of the sample-to-photon latency histograms
+ *
+ * A histogram bucket is exact below LATENCY_SUB_BUCKETS µs and covers an
+ * eighth of a power of two above, so percentiles are reported as bucket
+ * upper bounds at most 12.5 % above the true value. Stamps are micros(),
+ * which is the same clock on both cores.
+ *
+ * The parse stage is written by the ingest task, all others by the render
+ * task; as with the pipeline statistics no locking is needed, and a reset
+ * racing a parse record may keep or lose that one sample.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "latency_trace.h"
+
+// ============================================================================
+// LATENCY STATE
+// ============================================================================
+
+#if PERF_STATS_ENABLE
+
+/**
+ * @struct latency_histogram_t
+ * @brief Histogram of one stage since reset
+ */
+typedef struct {
+    uint32_t buckets[LATENCY_BUCKETS];  ///< Samples per bucket
+    uint32_t count;                     ///< Samples recorded
+    uint32_t max_us;                    ///< Largest value recorded
+} latency_histogram_t;
+
+/**
+ * @struct latency_follow_t
+ * @brief Applied sample waiting for its frame (render task only)
+ */
+typedef struct {
+    bool armed;        ///< A sample is being followed
+    uint32_t rx_us;    ///< Its receive stamp
+    bool has_ts;       ///< It carried a host stamp
+    uint32_t host_ts;  ///< The host stamp
+} latency_follow_t;
+
+static latency_histogram_t latency_histograms[LATENCY_STAGE_COUNT];  ///< One histogram per stage
+static latency_follow_t followed;  ///< Sample followed to the next flushed frame
+
+static bool echo_ready = false;  ///< A "photon:" echo is waiting to be sent
+static uint32_t echo_ts = 0;     ///< Host stamp of the echo
+static uint32_t echo_us = 0;     ///< Receive-to-flush latency of the echo
+
+#endif
+
+static const char *latency_stage_names[LATENCY_STAGE_COUNT] = {
+    "parse",
+    "apply",
+    "render",
+    "flush",
+};
+
+// ============================================================================
+// HISTOGRAM HELPERS
+// ============================================================================
+
+#if PERF_STATS_ENABLE
+
+/**
+ * @brief Bucket of a latency value
+ */
+static uint32_t bucket_of(uint32_t us) {
+    if (us < LATENCY_SUB_BUCKETS) {
+        return us;
+    }
+    uint32_t octave = 31 - __builtin_clz(us);
+    if (octave >= LATENCY_MAX_OCTAVE) {
+        return LATENCY_BUCKETS - 1;
+    }
+    uint32_t sub = (us >> (octave - LATENCY_SUB_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+    return LATENCY_SUB_BUCKETS * (1 + octave - LATENCY_SUB_BITS) + sub;
+}
+
+/**
+ * @brief Largest value that falls into a bucket
+ */
+static uint32_t bucket_upper_us(uint32_t bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS) {
+        return bucket;
+    }
+    uint32_t shift = bucket / LATENCY_SUB_BUCKETS - 1;  // octave - LATENCY_SUB_BITS
+    uint32_t sub = bucket % LATENCY_SUB_BUCKETS;
+    return ((LATENCY_SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Add one value to a stage histogram
+ */
+static void record_value(latency_stage_t stage, uint32_t us) {
+    latency_histogram_t *histogram = &latency_histograms[stage];
+    histogram->buckets[bucket_of(us)]++;
+    histogram->count++;
+    if (us > histogram->max_us) {
+        histogram->max_us = us;
+    }
+}
+
+/**
+ * @brief Elapsed time from a receive stamp (0 if the stamp is later)
+ */
+static uint32_t elapsed_us(uint32_t rx_us, uint32_t now_us) {
+    int32_t elapsed = (int32_t)(now_us - rx_us);
+    return elapsed > 0 ? (uint32_t)elapsed : 0;
+}
+
+/**
+ * @brief Value at a percentile of a histogram
+ * @param percent Percentile (1-100)
+ */
+static uint32_t percentile_us(const latency_histogram_t *histogram, uint32_t percent) {
+    uint32_t rank = (uint32_t)(((uint64_t)histogram->count * percent + 99) / 100);
+    uint32_t seen = 0;
+    for (uint32_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        seen += histogram->buckets[bucket];
+        if (seen >= rank) {
+            uint32_t upper = bucket_upper_us(bucket);
+            return upper < histogram->max_us ? upper : histogram->max_us;
+        }
+    }
+    return histogram->max_us;
+}
+
+#endif
+
+// ============================================================================
+// LATENCY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Clear all histograms and the pending frame trace
+ */
+void latency_trace_reset() {
+#if PERF_STATS_ENABLE
+    memset(latency_histograms, 0, sizeof(latency_histograms));
+    followed.armed = false;
+    echo_ready = false;
+#endif
+}
+
+/**
+ * @brief Record one stage latency, measured up to now
+ */
+void latency_trace_record(latency_stage_t stage, uint32_t rx_us) {
+#if PERF_STATS_ENABLE
+    record_value(stage, elapsed_us(rx_us, micros()));
+#endif
+}
+
+/**
+ * @brief Record the apply stage and follow a visible sample to its frame
+ */
+void latency_trace_applied(const sensor_sample_t *sample, bool visible) {
+#if PERF_STATS_ENABLE
+    record_value(LATENCY_APPLY, elapsed_us(sample->rx_us, micros()));
+    if (!visible || followed.armed) {
+        return;
+    }
+    followed.armed = true;
+    followed.rx_us = sample->rx_us;
+    followed.has_ts = sample->has_ts;
+    followed.host_ts = sample->host_ts;
+#endif
+}
+
+/**
+ * @brief Record render and flush stages of the followed sample
+ *
+ * With double-buffered DMA the last stripe may still be on the bus when
+ * the last flush returns; the flush stage excludes that one transfer.
+ */
+void latency_trace_frame_flushed(uint32_t first_flush_us, uint32_t last_flush_us) {
+#if PERF_STATS_ENABLE
+    if (!followed.armed) {
+        return;
+    }
+    followed.armed = false;
+
+    uint32_t flush_us = elapsed_us(followed.rx_us, last_flush_us);
+    record_value(LATENCY_RENDER, elapsed_us(followed.rx_us, first_flush_us));
+    record_value(LATENCY_FLUSH, flush_us);
+
+    if (followed.has_ts) {
+        echo_ts = followed.host_ts;
+        echo_us = flush_us;
+        echo_ready = true;
+    }
+#else
+    (void)first_flush_us;
+    (void)last_flush_us;
+#endif
+}
+
+/**
+ * @brief Send the pending "photon:" echo
+ *
+ * "photon: ts=T us=D": the update stamped T by the host is on the panel,
+ * D µs after its last byte was read. Only the latest echo is kept.
+ */
+void latency_trace_send_echo() {
+#if PERF_STATS_ENABLE
+    if (!echo_ready) {
+        return;
+    }
+    echo_ready = false;
+    Serial.printf("photon: ts=%lu us=%lu\n", (unsigned long)echo_ts, (unsigned long)echo_us);
+#endif
+}
+
+/**
+ * @brief Summarize one stage
+ */
+void latency_trace_get(latency_stage_t stage, latency_summary_t *summary) {
+    memset(summary, 0, sizeof(*summary));
+#if PERF_STATS_ENABLE
+    const latency_histogram_t *histogram = &latency_histograms[stage];
+    summary->count = histogram->count;
+    summary->max_us = histogram->max_us;
+    if (histogram->count == 0) {
+        return;
+    }
+    summary->p50_us = percentile_us(histogram, 50);
+    summary->p99_us = percentile_us(histogram, 99);
+#endif
+}
+
+/**
+ * @brief Print the summary of every stage
+ *
+ * Formats with printf into the stream; no heap allocation.
+ */
+void latency_trace_print(Print &out) {
+#if PERF_STATS_ENABLE
+    out.println("Latency from receive (us, since reset):");
+    out.printf("  %-8s %8s %8s %8s %8s\n", "stage", "count", "p50", "p99", "max");
+    for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        latency_summary_t summary;
+        latency_trace_get((latency_stage_t)i, &summary);
+        out.printf("  %-8s %8lu %8lu %8lu %8lu\n", latency_stage_names[i],
+                   (unsigned long)summary.count, (unsigned long)summary.p50_us,
+                   (unsigned long)summary.p99_us, (unsigned long)summary.max_us);
+    }
+#else
+    (void)latency_stage_names;
+    out.println("Latency trace disabled (PERF_STATS_ENABLE=0)");
+#endif
+}
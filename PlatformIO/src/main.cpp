@@ -6,6 +6,11 @@
  * received via serial JSON messages. Features automatic UI management and
  * display power management.
  * 
+ * Processing is split across both ESP32-S3 cores (see task_config.h):
+ * an ingest task reads and decodes serial data on core 0 and hands samples
+ * through a lock-free queue to the render task on core 1, which owns all
+ * LVGL calls.
+ * 
  * @author ESP32-S3 Display Project
  * @date 2025
  */
@@ -14,7 +19,27 @@
 #include "display_driver.h"
 #include "ui_components.h"
 #include "system_manager.h"
-#include <ArduinoJson.h>
+#include "serial_link.h"
+#include "sample_queue.h"
+#include "sample_apply.h"
+#include "task_config.h"
+#include "perf_stats.h"
+#include "latency_trace.h"
+#include "metric_registry.h"
+#include "metric_history.h"
+#include "boot_trace.h"
+#include "command_channel.h"
+
+// ============================================================================
+// TASK HANDLES
+// ============================================================================
+
+static TaskHandle_t ingest_task_handle = NULL;  ///< Serial ingest task (core 0)
+static TaskHandle_t render_task_handle = NULL;  ///< LVGL render task (core 1)
+
+static void ingest_task(void *parameter);
+static void render_task(void *parameter);
+static void update_tx_timeout();
 
 // ============================================================================
 // SYSTEM INITIALIZATION
@@ -23,109 +48,264 @@
 /**
  * @brief System setup and initialization
  * 
- * Initializes serial communication, display hardware, UI components,
- * and system manager. Shows boot animation until first data received.
+ * Brings the splash up first, then starts the pipeline tasks as early as
+ * possible. The USB CDC host is not waited for: boot progress goes to the
+ * boot trace, which is printed once the UI is complete (and on "boot").
+ * The meters are built by the render task while the boot animation runs.
  */
 void setup() {
+  boot_trace_mark("setup");
 
-  // Initialize serial communication for data reception
+  // Initialize serial communication for data reception. The baud rate
+  // means nothing for USB CDC; the receive buffer bounds the backlog a
+  // fast host can build up. The transmit ring holds a whole text reply, so
+  // the ingest and render tasks can both write without cutting lines
+  Serial.setRxBufferSize(SERIAL_RX_BUFFER_SIZE);
+#if ARDUINO_USB_MODE
+  Serial.setTxBufferSize(SERIAL_TX_BUFFER_SIZE);
+#endif
   Serial.begin(115200);
+  update_tx_timeout();
   
-  // Wait for serial connection to be established (important for USB CDC)
-  delay(1000);
-  
-  // Print startup information
-  Serial.println("ESP32-S3 Display Project Starting...");
-  Serial.println("Serial communication initialized at 115200 baud");
+  // Metric table must exist before the UI creates meters and samples arrive
+  metric_registry_init();
+  metric_history_init();
   
-  // Initialize display hardware and LVGL graphics system
-  Serial.println("Initializing display...");
+  // Initialize display hardware (splash on screen) and LVGL graphics system
   display_init();  // Set up SPI, GC9A01 panel, LVGL integration
-  Serial.println("Display initialized successfully");
   
-  // Initialize complete user interface system
-  Serial.println("Initializing UI components...");
-  ui_init();  // Create meters, labels, boot animation
-  Serial.println("UI components initialized successfully");
+  // Boot animation only; meters are built in the render task
+  ui_init();
+  boot_trace_mark("boot screen");
   
   // Initialize system manager for system control logic
-  Serial.println("Initializing system manager...");
   system_manager_init();  // Initialize system logic and state management
-  Serial.println("System manager initialized successfully");
   
-  // System ready - print usage information
+  // Initialize non-blocking serial line assembler and the task hand-off queue
+  serial_link_init();
+  serial_link_set_command_handler(command_channel_dispatch);
+  sample_queue_init();
+  perf_stats_init();
+  
+  // Start the pipeline: ingest on one core, rendering on the other
+  xTaskCreatePinnedToCore(render_task, "render", RENDER_TASK_STACK_SIZE, NULL,
+                          RENDER_TASK_PRIORITY, &render_task_handle, RENDER_TASK_CORE);
+  command_channel_init(render_task_handle);  // Commands are decoded by the ingest task
+  xTaskCreatePinnedToCore(ingest_task, "ingest", INGEST_TASK_STACK_SIZE, NULL,
+                          INGEST_TASK_PRIORITY, &ingest_task_handle, INGEST_TASK_CORE);
+  boot_trace_mark("tasks");
+}
+
+/**
+ * @brief Select the serial write timeout for the current host state
+ * 
+ * Both pipeline tasks write to Serial. While a host has the CDC port open
+ * a writer waits up to SERIAL_TX_TIMEOUT_MS for the lock and ring space,
+ * so no ack or reply line is lost to the other task's output. Without a
+ * host nothing drains the ring: writes must not block, and are dropped.
+ */
+static void update_tx_timeout() {
+#if ARDUINO_USB_MODE
+  static int8_t host_connected = -1;  // Unknown until the first call
+  int8_t connected = Serial ? 1 : 0;
+  if (connected != host_connected) {
+    host_connected = connected;
+    Serial.setTxTimeoutMs(connected ? SERIAL_TX_TIMEOUT_MS : 0);
+  }
+#endif
+}
+
+/**
+ * @brief Build one step of the main UI; print the boot trace when done
+ * @return true while the UI is still being built
+ */
+static bool build_ui_step() {
+  static bool first_frame = false;
+  if (!first_frame && display_refresh_stats.frames > 0) {
+    first_frame = true;
+    boot_trace_mark("first frame");
+  }
+
+  if (ui_build_step()) {
+    return true;
+  }
+
+  boot_trace_mark("ui built");
+  boot_trace_print(Serial);
   Serial.println("Setup complete - Ready to receive JSON data");
   Serial.println("Expected JSON format: {\"time\":\"HH:MM:SS\",\"cpu_load\":0-100,\"cpu_temp\":0-100}");
+  return false;
 }
 
 // ============================================================================
-// MAIN APPLICATION LOOP
+// PIPELINE TASKS
 // ============================================================================
 
 /**
- * @brief Main application loop - handles data processing and UI management
+ * @brief Queue a decoded sample for the render task
  * 
- * Processes incoming JSON data, updates UI elements, manages automatic
- * meter hiding/showing, and handles LVGL graphics processing.
+ * Called by the serial link in the ingest task context. Wakes the render
+ * task immediately so a new sample adds no scheduling latency. While the
+ * queue is full, samples are coalesced into one held-back sample that the
+ * ingest task publishes as soon as a slot frees up.
+ * 
+ * @param sample Pointer to decoded sample
  */
-void loop() {
-  // ========================================================================
-  // SERIAL DATA PROCESSING
-  // ========================================================================
-  
-  if (Serial.available()) {
-    // Read complete JSON line from serial
-    String json = Serial.readStringUntil('\n');
+static void enqueue_sample(const sensor_sample_t *sample) {
+  if (sample_queue_push_latest(sample)) {
+    xTaskNotifyGive(render_task_handle);
+  }
+}
+
+/**
+ * @brief USB CDC receive event handler - wakes the ingest task
+ * 
+ * Runs in the ESP event loop task whenever the CDC driver has received
+ * data. A pending notification is kept if the ingest task is still busy,
+ * so no event is ever lost between a poll and the next wait.
+ */
+static void serial_rx_event_handler(void *arg, esp_event_base_t event_base,
+                                    int32_t event_id, void *event_data) {
+  if (ingest_task_handle) {
+    xTaskNotifyGive(ingest_task_handle);
+  }
+}
+
+/**
+ * @brief Convert a millisecond delay into a FreeRTOS wait (at least 1 tick)
+ * @param ms Milliseconds until the next deadline (UINT32_MAX = none)
+ * @return Tick count for ulTaskNotifyTake()
+ */
+static TickType_t wait_ticks_for(uint32_t ms) {
+  if (ms == UINT32_MAX) {
+    return portMAX_DELAY;
+  }
+  TickType_t ticks = pdMS_TO_TICKS(ms);
+  return ticks > 0 ? ticks : 1;  // Always block so lower priority tasks run
+}
+
+/**
+ * @brief Ingest task - serial read and decode (core 0)
+ * 
+ * Drains the serial port and decodes JSON lines and binary frames. Parsing
+ * bursts run here and never delay a frame on the render core. Credit acks
+ * for a streaming host are sent here too. Between bursts the task blocks
+ * until the CDC RX event fires.
+ * 
+ * @param parameter Unused
+ */
+static void ingest_task(void *parameter) {
+#if ARDUINO_USB_MODE
+  Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, serial_rx_event_handler);
+#else
+  Serial.onEvent(ARDUINO_USB_CDC_RX_EVENT, serial_rx_event_handler);
+#endif
+
+  for (;;) {
+    // Drain whatever has arrived; never blocks waiting for a complete line.
+    // Invalid lines are counted in serial_link_stats instead of being parsed.
+    update_tx_timeout();
+    serial_link_poll(enqueue_sample);
+    if (sample_queue_flush()) {
+      xTaskNotifyGive(render_task_handle);
+    }
+    command_channel_send_ack();
     
-    // Parse JSON data with 256-byte buffer (sufficient for expected format)
-    StaticJsonDocument<256> json_doc;
-    DeserializationError error = deserializeJson(json_doc, json);
+    // Sleep until more data arrives (timeout only guards against lost
+    // events). A held-back sample is retried soon instead
+    if (Serial.available() <= 0) {
+      uint32_t timeout_ms = sample_queue_pending() ? INGEST_RETRY_MS : INGEST_IDLE_TIMEOUT_MS;
+      ulTaskNotifyTake(pdTRUE, wait_ticks_for(timeout_ms));
+    }
+  }
+}
+
+/**
+ * @brief Render task - system logic and LVGL processing (core 1)
+ * 
+ * The only task that touches LVGL. Applies queued samples, performs
+ * periodic system management and runs the LVGL timer handler, then sleeps
+ * until a sample is queued or the earliest LVGL / system manager deadline
+ * is due. With nothing animating and no timeouts armed it never wakes.
+ * 
+ * Until the main UI is built, each pass builds one part of it between
+ * boot animation frames instead; samples and commands wait in the queue.
+ * 
+ * @param parameter Unused
+ */
+static void render_task(void *parameter) {
+  bool building_ui = true;
+
+  for (;;) {
+    // ======================================================================
+    // SAMPLE AND COMMAND PROCESSING
+    // ======================================================================
     
-    if (!error) {
-      // Extract data fields from JSON
-      const char* timeStr = json_doc["time"];        // Time string "HH:MM:SS"
-      int cpu_load = json_doc["cpu_load"];           // CPU load percentage 0-100
-      int cpu_temperature = json_doc["cpu_temp"];    // CPU temperature 0-100°C
-      
-      // Process data through system manager (handles all system logic)
-      system_process_data(cpu_temperature, cpu_load);
-      
-      // ====================================================================
-      // UI UPDATES (only if display is active)
-      // ====================================================================
-      
-      if (!sys_display_blanked) {
-        // Update CPU temperature meter with smooth animation (only if visible)
-        if (!sys_cpu_temp_meter_hidden) {
-          update_meter_needle_animated(cpu_temp_meter, cpu_temperature, 600);
-        }
-        
-        // Update CPU load meter with smooth animation (only if visible)
-        if (!sys_cpu_load_meter_hidden) {
-          update_meter_needle_animated(cpu_load_meter, cpu_load, 400);
-        }
-        
-        // Always update time display when screen is active
-        lv_label_set_text(time_label, timeStr);
+    if (!building_ui) {
+      // Everything queued since the last pass is applied as one sample
+      // with the latest value of each metric
+      sensor_sample_t sample;
+      if (sample_queue_pop_latest(&sample)) {
+        sample_apply(&sample);
       }
+      command_channel_process();
+
+      // Perform all periodic system management tasks
+      system_periodic_update();
+    }
+
+    // ======================================================================
+    // GRAPHICS PROCESSING
+    // ======================================================================
+    
+    // Process LVGL animations, timers, and screen updates.
+    // Returns the time until the next LVGL timer is due. While blanked the
+    // tick is stopped and nothing is rendered: sleep until a sample arrives.
+    uint32_t lvgl_ms = LV_NO_TIMER_READY;
+    if (!display_low_power_active()) {
+      uint32_t handler_start = PERF_TIMESTAMP();
+      lvgl_ms = lv_timer_handler();
+      PERF_RECORD(PERF_LVGL_HANDLER, handler_start);
+      latency_trace_send_echo();  // After the frame, so the reply never delays it
+    }
+
+    // ======================================================================
+    // DEFERRED UI CONSTRUCTION
+    // ======================================================================
+    
+    // After the frame, so the boot animation is drawn before the first build
+    if (building_ui) {
+      building_ui = build_ui_step();
+    }
+
+    // ======================================================================
+    // SLEEP UNTIL NEXT EVENT
+    // ======================================================================
+    
+    uint32_t system_ms = building_ui ? 0 : system_ms_until_next_deadline();
+    uint32_t sleep_ms = lvgl_ms < system_ms ? lvgl_ms : system_ms;
+    TickType_t wait_ticks = wait_ticks_for(sleep_ms);
+    uint32_t planned_wake_us = micros() + wait_ticks * portTICK_PERIOD_MS * 1000;
+
+    // A timed-out wait (no notification) was a scheduled deadline: record
+    // how late the task actually resumed
+    if (ulTaskNotifyTake(pdTRUE, wait_ticks) == 0 && wait_ticks != portMAX_DELAY) {
+      int32_t late_us = (int32_t)(micros() - planned_wake_us);
+      PERF_RECORD_VALUE(PERF_LOOP_JITTER, late_us > 0 ? (uint32_t)late_us : 0);
     }
-    // Note: JSON parsing errors are silently ignored to maintain stability
   }
+}
 
-  // ========================================================================
-  // SYSTEM MANAGEMENT
-  // ========================================================================
-  
-  // Perform all periodic system management tasks
-  system_periodic_update();
+// ============================================================================
+// MAIN APPLICATION LOOP
+// ============================================================================
 
-  // ========================================================================
-  // GRAPHICS PROCESSING
-  // ========================================================================
-  
-  // Process LVGL animations, timers, and screen updates
-  lv_timer_handler();
-  
-  // Small delay for system stability and to prevent watchdog timeout
-  delay(5);  // 5ms delay = ~200Hz loop frequency
+/**
+ * @brief Arduino loop - unused
+ * 
+ * All work runs in the pinned ingest and render tasks created in setup(),
+ * so the Arduino loop task removes itself.
+ */
+void loop() {
+  vTaskDelete(NULL);
 }
@@ -0,0 +1,167 @@
+/**
+ * @file metric_history.cpp
+ * @brief Implementation of the tiered metric history
+ *
+ * Each ring accumulates min, max and sum of the samples of its current
+ * period. When a sample arrives in a later period the accumulated point is
+ * stored, followed by one point for every period that had no samples: a
+ * gap, or the held value while the link was alive.
+ * All tiers accumulate raw samples independently, so a 1 min average is the
+ * exact average of its samples rather than an average of averages.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "metric_history.h"
+#include <string.h>
+
+// ============================================================================
+// HISTORY STATE
+// ============================================================================
+
+/**
+ * @struct history_ring_t
+ * @brief Points and open accumulator of one metric and tier
+ */
+typedef struct {
+    history_point_t points[HISTORY_CAPACITY];  ///< Ring storage
+    uint32_t total;                            ///< Points stored since boot
+    uint32_t period;                           ///< Period number of the accumulator
+    int32_t acc_min;                           ///< Lowest sample of the open period
+    int32_t acc_max;                           ///< Highest sample of the open period
+    int64_t acc_sum;                           ///< Sum of the samples of the open period
+    uint32_t acc_count;                        ///< Samples in the open period (0 = none yet)
+} history_ring_t;
+
+/**
+ * @struct history_tier_info_t
+ * @brief Static description of a tier
+ */
+typedef struct {
+    uint32_t period_ms;  ///< Duration of one point
+    const char *key;     ///< Command argument
+    const char *name;    ///< Display name
+} history_tier_info_t;
+
+static const history_tier_info_t history_tiers[HISTORY_TIER_COUNT] = {
+    {  1000, "1s",  "1 s"   },
+    { 10000, "10s", "10 s"  },
+    { 60000, "1m",  "1 min" },
+};
+
+static history_ring_t history_rings[METRIC_COUNT][HISTORY_TIER_COUNT];  ///< All history storage
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Append a point to a ring, overwriting the oldest one when full
+ */
+static void push_point(history_ring_t *ring, int16_t min, int16_t max, int16_t avg) {
+    history_point_t *point = &ring->points[ring->total % HISTORY_CAPACITY];
+    point->min = min;
+    point->max = max;
+    point->avg = avg;
+    ring->total++;
+}
+
+/**
+ * @brief Clamp a sample into the 16-bit point range (HISTORY_GAP excluded)
+ */
+static int16_t clamp_value(int32_t value) {
+    if (value <= HISTORY_GAP) return HISTORY_GAP + 1;
+    if (value > INT16_MAX) return INT16_MAX;
+    return (int16_t)value;
+}
+
+// ============================================================================
+// HISTORY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Clear all history
+ */
+void metric_history_init() {
+    memset(history_rings, 0, sizeof(history_rings));
+}
+
+/**
+ * @brief Add one sample of every metric
+ */
+void metric_history_add(uint32_t now_ms, const int32_t *values, const int32_t *held) {
+    for (int tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+        uint32_t period = now_ms / history_tiers[tier].period_ms;
+
+        for (int id = 0; id < METRIC_COUNT; id++) {
+            history_ring_t *ring = &history_rings[id][tier];
+
+            if (ring->acc_count > 0 && period != ring->period) {
+                // Close the open period, then fill periods without samples
+                push_point(ring, clamp_value(ring->acc_min), clamp_value(ring->acc_max),
+                           clamp_value((int32_t)(ring->acc_sum / ring->acc_count)));
+                uint32_t gaps = period - ring->period - 1;
+                if (gaps > HISTORY_CAPACITY) gaps = HISTORY_CAPACITY;
+                while (gaps--) {
+                    if (held) {
+                        int16_t value = clamp_value(held[id]);
+                        push_point(ring, value, value, value);
+                    } else {
+                        push_point(ring, 0, 0, HISTORY_GAP);
+                    }
+                }
+                ring->acc_count = 0;
+            }
+
+            int32_t value = values[id];
+            if (ring->acc_count == 0) {
+                ring->period = period;
+                ring->acc_min = ring->acc_max = value;
+                ring->acc_sum = 0;
+            }
+            if (value < ring->acc_min) ring->acc_min = value;
+            if (value > ring->acc_max) ring->acc_max = value;
+            ring->acc_sum += value;
+            ring->acc_count++;
+        }
+    }
+}
+
+/**
+ * @brief Number of points stored since boot (next absolute index)
+ */
+uint32_t metric_history_total(metric_id_t metric, history_tier_t tier) {
+    return history_rings[metric][tier].total;
+}
+
+/**
+ * @brief Read a point by absolute index
+ */
+bool metric_history_get(metric_id_t metric, history_tier_t tier, uint32_t index, history_point_t *point) {
+    const history_ring_t *ring = &history_rings[metric][tier];
+    if (index >= ring->total || ring->total - index > HISTORY_CAPACITY) {
+        return false;
+    }
+    *point = ring->points[index % HISTORY_CAPACITY];
+    return true;
+}
+
+/**
+ * @brief Short tier name for display
+ */
+const char *metric_history_tier_name(history_tier_t tier) {
+    return history_tiers[tier].name;
+}
+
+/**
+ * @brief Map a command argument to its tier
+ */
+int metric_history_find_tier(const char *key) {
+    for (int tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+        if (strcmp(history_tiers[tier].key, key) == 0) {
+            return tier;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file metric_registry.cpp
+ * @brief Metric definitions and key lookup
+ *
+ * Field names are matched through a table of FNV-1a hashes computed once at
+ * startup: a lookup hashes the incoming key, scans the contiguous hash array
+ * and confirms the single candidate with strcmp().
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "metric_registry.h"
+#include "ui_components.h"
+#include <Arduino.h>
+
+// ============================================================================
+// METRIC DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief One row per metric, in metric_id_t order (also the drawing order)
+ */
+const metric_descriptor_t metric_descriptors[METRIC_COUNT] = {
+    { "cpu_temp", "CPU temperature", &cpu_temp_meter_config, 600 },
+    { "cpu_load", "CPU load",        &cpu_load_meter_config, 400 },
+};
+
+metric_table_t metric_table;  ///< Metric runtime state
+
+static uint32_t metric_key_hashes[METRIC_COUNT];  ///< FNV-1a hash of each descriptor key
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief 32-bit FNV-1a hash of a NUL-terminated string
+ */
+static uint32_t hash_key(const char *key) {
+    uint32_t hash = 2166136261u;
+    while (*key) {
+        hash ^= (uint8_t)*key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ============================================================================
+// REGISTRY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Reset runtime state and precompute the key lookup table
+ *
+ * Meter widgets are filled in by ui_build_step().
+ */
+void metric_registry_init() {
+    memset(&metric_table, 0, sizeof(metric_table));
+
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        metric_table.last_value[id] = -1;     // -1 indicates uninitialized
+        metric_table.needle_value[id] = 30;   // Needle position set by meter creation
+        metric_table.config[id] = metric_descriptors[id].config;
+        metric_key_hashes[id] = hash_key(metric_descriptors[id].key);
+    }
+}
+
+/**
+ * @brief Map a JSON field name to its metric
+ */
+int metric_lookup_key(const char *key) {
+    uint32_t hash = hash_key(key);
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        if (metric_key_hashes[id] == hash && strcmp(metric_descriptors[id].key, key) == 0) {
+            return id;
+        }
+    }
+    return METRIC_UNKNOWN;
+}
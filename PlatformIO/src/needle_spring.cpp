@@ -0,0 +1,175 @@
+/**
+ * @file needle_spring.cpp
+ * @brief Implementation of the needle spring animation
+ *
+ * Each slot integrates x'' = w^2 (target - x) - 2 w x' (critical damping)
+ * with semi-implicit Euler steps of NEEDLE_SPRING_STEP_MS. Position and
+ * velocity are Q16, w is Q8 rad/s; products are formed in 64 bits. A
+ * critically damped spring is within 2 % of a step after w t = 5.83, which
+ * sets w from the requested duration.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "needle_spring.h"
+#include <string.h>
+
+// ============================================================================
+// ENGINE STATE
+// ============================================================================
+
+#define SPRING_Q16(v)        ((int32_t)(v) * 65536)  ///< Integer to Q16
+#define SPRING_SETTLE_DIST   (65536 / 4)             ///< Snap when closer than 0.25 units...
+#define SPRING_SETTLE_SPEED  65536                   ///< ...and slower than 1 unit/s
+#define SPRING_MAX_STEPS     64                      ///< Steps per tick after a stall (256 ms)
+#define SPRING_SETTLE_WT_Q8  1492                    ///< w t at 2 % settling (5.83) in Q8
+
+/**
+ * @struct spring_slot_t
+ * @brief Motion state of one needle
+ */
+typedef struct {
+    int32_t position;  ///< Current value (Q16)
+    int32_t velocity;  ///< Units per second (Q16)
+    int32_t target;    ///< Value pulled towards (Q16)
+    int32_t omega;     ///< Natural frequency (Q8 rad/s)
+    int32_t shown;     ///< Value last passed to the apply callback
+    bool moving;       ///< Integrated by the tick timer
+} spring_slot_t;
+
+static spring_slot_t spring_slots[NEEDLE_SPRING_SLOTS];  ///< One slot per needle
+static uint8_t moving_count = 0;                         ///< Slots with moving set
+static lv_timer_t *spring_timer = NULL;                  ///< Tick timer (paused while idle)
+static uint32_t last_tick_ms = 0;                        ///< lv_tick_get() of the last tick
+static uint32_t leftover_ms = 0;                         ///< Tick time not yet integrated
+static needle_spring_apply_t apply_cb = NULL;            ///< Moves a needle on screen
+static needle_spring_idle_t idle_cb = NULL;              ///< All needles settled
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Advance one slot by one integration step
+ */
+static void step_slot(spring_slot_t *s) {
+    int64_t w = s->omega;
+    int64_t error = (int64_t)s->target - s->position;
+    int64_t accel = ((w * w * error) >> 16) - ((2 * w * s->velocity) >> 8);
+    s->velocity += (int32_t)(accel * NEEDLE_SPRING_STEP_MS / 1000);
+    s->position += (int32_t)((int64_t)s->velocity * NEEDLE_SPRING_STEP_MS / 1000);
+}
+
+/**
+ * @brief Pass the rounded position to the apply callback if it changed
+ */
+static void apply_slot(uint8_t slot, spring_slot_t *s) {
+    int32_t value = (s->position + 32768) >> 16;
+    if (value != s->shown) {
+        s->shown = value;
+        apply_cb(slot, value);
+    }
+}
+
+/**
+ * @brief Tick timer callback - advances all moving needles
+ */
+static void spring_timer_callback(lv_timer_t *timer) {
+    uint32_t elapsed = lv_tick_elaps(last_tick_ms) + leftover_ms;
+    last_tick_ms = lv_tick_get();
+    uint32_t steps = elapsed / NEEDLE_SPRING_STEP_MS;
+    leftover_ms = elapsed % NEEDLE_SPRING_STEP_MS;
+    if (steps > SPRING_MAX_STEPS) {
+        steps = SPRING_MAX_STEPS;
+    }
+
+    for (uint8_t slot = 0; slot < NEEDLE_SPRING_SLOTS; slot++) {
+        spring_slot_t *s = &spring_slots[slot];
+        if (!s->moving) continue;
+
+        for (uint32_t i = 0; i < steps; i++) {
+            step_slot(s);
+        }
+
+        int32_t error = s->target - s->position;
+        if (LV_ABS(error) < SPRING_SETTLE_DIST && LV_ABS(s->velocity) < SPRING_SETTLE_SPEED) {
+            s->position = s->target;
+            s->velocity = 0;
+            s->moving = false;
+            moving_count--;
+        }
+        apply_slot(slot, s);
+    }
+
+    if (moving_count == 0) {
+        lv_timer_pause(timer);
+        if (idle_cb) idle_cb();
+    }
+}
+
+// ============================================================================
+// NEEDLE SPRING FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Create the tick timer and reset all slots
+ */
+void needle_spring_init(needle_spring_apply_t apply, needle_spring_idle_t idle, uint32_t period_ms) {
+    memset(spring_slots, 0, sizeof(spring_slots));
+    moving_count = 0;
+    apply_cb = apply;
+    idle_cb = idle;
+
+    if (!spring_timer) {
+        spring_timer = lv_timer_create(spring_timer_callback, period_ms, NULL);
+    }
+    lv_timer_set_period(spring_timer, period_ms);
+    lv_timer_pause(spring_timer);
+}
+
+/**
+ * @brief Place a needle at a value without animating
+ */
+void needle_spring_set(uint8_t slot, int32_t value) {
+    spring_slot_t *s = &spring_slots[slot];
+    if (s->moving) {
+        s->moving = false;
+        moving_count--;
+    }
+    s->position = s->target = SPRING_Q16(value);
+    s->velocity = 0;
+    s->shown = value;
+    apply_cb(slot, value);
+}
+
+/**
+ * @brief Pull a needle towards a new target from wherever it is now
+ */
+void needle_spring_retarget(uint8_t slot, int32_t target, uint32_t duration_ms) {
+    if (duration_ms == 0) {
+        needle_spring_set(slot, target);
+        return;
+    }
+
+    spring_slot_t *s = &spring_slots[slot];
+    s->target = SPRING_Q16(target);
+    s->omega = (int32_t)(SPRING_SETTLE_WT_Q8 * 1000 / duration_ms);
+    if (s->omega < 1) s->omega = 1;
+
+    if (!s->moving) {
+        s->moving = true;
+        if (moving_count++ == 0) {
+            last_tick_ms = lv_tick_get();
+            leftover_ms = 0;
+            lv_timer_resume(spring_timer);
+        }
+    }
+}
+
+/**
+ * @brief Whether any needle is still moving
+ */
+bool needle_spring_running() {
+    return moving_count > 0;
+}
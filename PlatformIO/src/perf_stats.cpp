@@ -0,0 +1,197 @@
+/**
+ * @file perf_stats.cpp
+ * @brief Implementation of frame pipeline instrumentation
+ *
+ * Each metric owns a fixed ring of the last PERF_WINDOW_SIZE samples plus a
+ * lifetime counter and peak. Durations are taken with the per-core cycle
+ * counter and converted to microseconds when recorded. Every metric has a
+ * single writer task, so no locking is needed; a report printed while the
+ * other core records may mix one stale sample, which is acceptable here.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "perf_stats.h"
+#include <lvgl.h>
+#include <esp_cpu.h>
+
+// ============================================================================
+// STATISTICS STATE
+// ============================================================================
+
+#if PERF_STATS_ENABLE
+
+/**
+ * @struct perf_window_t
+ * @brief Rolling window of one metric
+ */
+typedef struct {
+    uint32_t samples[PERF_WINDOW_SIZE];  ///< Ring of recent samples
+    uint32_t count;                      ///< Samples recorded since reset
+    uint32_t peak;                       ///< Largest sample since reset
+} perf_window_t;
+
+static perf_window_t perf_windows[PERF_METRIC_COUNT];  ///< One window per metric
+static uint32_t perf_cpu_mhz = 240;                    ///< Cycle-to-µs divisor
+
+static uint32_t fps_window_start_ms = 0;  ///< Start of the current FPS window
+static uint32_t fps_frame_count = 0;      ///< Frames in the current FPS window
+
+static const char *perf_metric_names[PERF_METRIC_COUNT] = {
+    "frame render us",
+    "frame total us",
+    "flush us",
+    "frame pixels",
+    "fps",
+    "lv_timer_handler us",
+    "loop jitter us",
+    "json parse us",
+};
+
+#endif
+
+// ============================================================================
+// STATISTICS FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Clear all windows and capture the current CPU frequency
+ */
+void perf_stats_init() {
+#if PERF_STATS_ENABLE
+    perf_cpu_mhz = getCpuFrequencyMhz();
+#endif
+    perf_stats_reset();
+}
+
+/**
+ * @brief Clear all recorded statistics
+ */
+void perf_stats_reset() {
+#if PERF_STATS_ENABLE
+    memset(perf_windows, 0, sizeof(perf_windows));
+    fps_window_start_ms = millis();
+    fps_frame_count = 0;
+#endif
+}
+
+/**
+ * @brief Update the cycle-to-microsecond conversion after a CPU clock change
+ */
+void perf_stats_set_cpu_mhz(uint32_t mhz) {
+#if PERF_STATS_ENABLE
+    if (mhz > 0) {
+        perf_cpu_mhz = mhz;
+    }
+#endif
+}
+
+/**
+ * @brief Read the CPU cycle counter
+ */
+uint32_t perf_stats_cycles() {
+    return (uint32_t)esp_cpu_get_cycle_count();
+}
+
+/**
+ * @brief Record a duration measured in CPU cycles (stored in µs)
+ */
+void perf_stats_record_cycles(perf_metric_t metric, uint32_t cycles) {
+#if PERF_STATS_ENABLE
+    perf_stats_record_value(metric, cycles / perf_cpu_mhz);
+#endif
+}
+
+/**
+ * @brief Record a plain value (pixels, FPS, µs)
+ */
+void perf_stats_record_value(perf_metric_t metric, uint32_t value) {
+#if PERF_STATS_ENABLE
+    perf_window_t *window = &perf_windows[metric];
+    window->samples[window->count % PERF_WINDOW_SIZE] = value;
+    window->count++;
+    if (value > window->peak) {
+        window->peak = value;
+    }
+#endif
+}
+
+/**
+ * @brief Count one completed frame for the FPS metric
+ *
+ * Closes a one-second window whenever at least 1000 ms have passed since
+ * the window started and records the achieved frame rate.
+ */
+void perf_stats_frame_done() {
+#if PERF_STATS_ENABLE
+    uint32_t now = millis();
+    fps_frame_count++;
+
+    uint32_t elapsed = now - fps_window_start_ms;
+    if (elapsed >= 1000) {
+        perf_stats_record_value(PERF_FPS, fps_frame_count * 1000 / elapsed);
+        fps_window_start_ms = now;
+        fps_frame_count = 0;
+    }
+#endif
+}
+
+/**
+ * @brief Summarize a metric over its rolling window
+ */
+void perf_stats_get(perf_metric_t metric, perf_summary_t *summary) {
+    memset(summary, 0, sizeof(*summary));
+#if PERF_STATS_ENABLE
+    const perf_window_t *window = &perf_windows[metric];
+    uint32_t filled = window->count < PERF_WINDOW_SIZE ? window->count : PERF_WINDOW_SIZE;
+
+    summary->count = window->count;
+    summary->peak = window->peak;
+    if (filled == 0) {
+        return;
+    }
+
+    uint64_t sum = 0;
+    summary->min = UINT32_MAX;
+    for (uint32_t i = 0; i < filled; i++) {
+        uint32_t value = window->samples[i];
+        sum += value;
+        if (value < summary->min) summary->min = value;
+        if (value > summary->max) summary->max = value;
+    }
+    summary->avg = (uint32_t)(sum / filled);
+    summary->last = window->samples[(window->count - 1) % PERF_WINDOW_SIZE];
+#endif
+}
+
+/**
+ * @brief Print a statistics table including LVGL memory usage
+ *
+ * Formats with printf into the stream; no heap allocation.
+ */
+void perf_stats_print(Print &out) {
+#if PERF_STATS_ENABLE
+    out.printf("Pipeline stats (window %u samples):\n", (unsigned)PERF_WINDOW_SIZE);
+    out.printf("  %-20s %8s %8s %8s %8s %8s %8s\n", "metric", "count", "last", "min", "avg", "max", "peak");
+
+    for (int i = 0; i < PERF_METRIC_COUNT; i++) {
+        perf_summary_t summary;
+        perf_stats_get((perf_metric_t)i, &summary);
+        out.printf("  %-20s %8lu %8lu %8lu %8lu %8lu %8lu\n", perf_metric_names[i],
+                   (unsigned long)summary.count, (unsigned long)summary.last,
+                   (unsigned long)summary.min, (unsigned long)summary.avg,
+                   (unsigned long)summary.max, (unsigned long)summary.peak);
+    }
+#else
+    out.println("Pipeline stats disabled (PERF_STATS_ENABLE=0)");
+#endif
+
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    out.printf("  LVGL heap: %lu/%lu bytes used (%u%%), max used %lu (%lu%% of LV_MEM_SIZE), largest free %lu, frag %u%%\n",
+               (unsigned long)(mem.total_size - mem.free_size), (unsigned long)mem.total_size,
+               (unsigned)mem.used_pct, (unsigned long)mem.max_used,
+               (unsigned long)(mem.max_used * 100UL / LV_MEM_SIZE),
+               (unsigned long)mem.free_biggest_size, (unsigned)mem.frag_pct);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file sample_apply.cpp
+ * @brief Implementation of sample application
+ * 
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "sample_apply.h"
+#include "system_manager.h"
+#include "ui_components.h"
+#include "metric_registry.h"
+#include "metric_history.h"
+#include "latency_trace.h"
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Last received value of every metric (0 before the first one)
+ */
+static void get_held_values(int32_t *held) {
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        int32_t last = metric_table.last_value[id];
+        held[id] = last < 0 ? 0 : last;
+    }
+}
+
+/**
+ * @brief Whether the host link counts as alive (values are held, not stale)
+ */
+static bool link_alive() {
+    return sys_first_data_received && !sys_display_blanked;
+}
+
+// ============================================================================
+// SAMPLE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Apply one decoded sample to system state and UI
+ */
+void sample_apply(const sensor_sample_t *sample) {
+    bool needle_moved = false;
+
+    // Values before this sample; they held since the last one unless the
+    // display blanked in between
+    int32_t held[METRIC_COUNT];
+    get_held_values(held);
+    bool held_valid = link_alive();
+
+    // Process data through system manager (handles all system logic)
+    system_process_data(sample->values, sample->present);
+
+    // Record history even while blanked, so the trend view has no holes.
+    // Metrics not carried by this sample repeat their last value
+    int32_t values[METRIC_COUNT];
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        bool present = sample->present & (1u << id);
+        values[id] = present ? sample->values[id] : held[id];
+    }
+    metric_history_add(millis(), values, held_valid ? held : NULL);
+
+    // ========================================================================
+    // UI UPDATES (only if display is active)
+    // ========================================================================
+
+    if (!sys_display_blanked) {
+        // Update every visible meter carried by the sample with smooth animation
+        for (int id = 0; id < METRIC_COUNT; id++) {
+            if ((sample->present & (1u << id)) && !metric_table.hidden[id]) {
+                needle_moved |= sample->values[id] != metric_table.needle_value[id];
+                update_meter_needle_animated((metric_id_t)id, sample->values[id],
+                                             metric_descriptors[id].anim_duration_ms);
+            }
+        }
+
+        // Update time display when screen is active and time was sent
+        if (sample->time[0] != '\0') {
+            ui_set_time_text(sample->time);
+        }
+
+        // Scroll finished history points into the trend view (if shown)
+        ui_trend_sync();
+    }
+
+    latency_trace_applied(sample, needle_moved);
+}
+
+/**
+ * @brief Apply a keep-alive
+ */
+void sample_apply_keepalive() {
+    bool held_valid = link_alive();
+    system_process_keepalive();
+    if (!held_valid) {
+        return;  // Ignored: no values yet, or blanked until a full sample
+    }
+
+    // History only: the trend view catches up with the next real sample,
+    // so a keep-alive never invalidates anything
+    int32_t held[METRIC_COUNT];
+    get_held_values(held);
+    metric_history_add(millis(), held, held);
+}
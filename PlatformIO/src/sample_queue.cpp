@@ -0,0 +1,170 @@
+/**
+ * @file sample_queue.cpp
+ * @brief Implementation of the lock-free SPSC sample queue
+ * 
+ * Classic ring buffer with free-running head/tail indices. The producer
+ * only writes head, the consumer only writes tail; release/acquire ordering
+ * guarantees a slot's contents are visible before its index is published.
+ * The held-back sample of the coalescing push belongs to the producer.
+ * 
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "sample_queue.h"
+#include <atomic>
+
+static_assert((SAMPLE_QUEUE_LENGTH & (SAMPLE_QUEUE_LENGTH - 1)) == 0,
+              "SAMPLE_QUEUE_LENGTH must be a power of two");
+
+// ============================================================================
+// QUEUE STATE
+// ============================================================================
+
+static sensor_sample_t queue_slots[SAMPLE_QUEUE_LENGTH];  ///< Sample storage
+static std::atomic<uint32_t> queue_head(0);                ///< Next slot to write (producer)
+static std::atomic<uint32_t> queue_tail(0);                ///< Next slot to read (consumer)
+static std::atomic<uint32_t> queue_dropped(0);             ///< Samples rejected while full
+static std::atomic<uint32_t> queue_coalesced(0);           ///< Samples merged into newer ones
+
+static sensor_sample_t held_sample;  ///< Sample waiting for a free slot (producer)
+static bool held_valid = false;      ///< held_sample is waiting
+
+// ============================================================================
+// QUEUE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Reset the queue to empty (call before the tasks start)
+ */
+void sample_queue_init() {
+    queue_head.store(0, std::memory_order_relaxed);
+    queue_tail.store(0, std::memory_order_relaxed);
+    queue_dropped.store(0, std::memory_order_relaxed);
+    queue_coalesced.store(0, std::memory_order_relaxed);
+    held_valid = false;
+}
+
+/**
+ * @brief Publish a sample if a slot is free, without counting a drop
+ */
+static bool try_push(const sensor_sample_t *sample) {
+    uint32_t head = queue_head.load(std::memory_order_relaxed);
+    uint32_t tail = queue_tail.load(std::memory_order_acquire);
+    if (head - tail >= SAMPLE_QUEUE_LENGTH) {
+        return false;
+    }
+    queue_slots[head & (SAMPLE_QUEUE_LENGTH - 1)] = *sample;
+    queue_head.store(head + 1, std::memory_order_release);  // Publish slot to consumer
+    return true;
+}
+
+/**
+ * @brief Append a sample (producer side only)
+ * 
+ * A full queue means the render side is behind; the new sample is dropped
+ * and counted rather than blocking the ingest task.
+ */
+bool sample_queue_push(const sensor_sample_t *sample) {
+    if (!try_push(sample)) {
+        queue_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Append a sample, coalescing while the queue is full (producer side only)
+ * 
+ * A held-back sample is always older than the new one, so the new one is
+ * merged into it and the merged sample takes the next free slot; samples
+ * are never reordered.
+ */
+bool sample_queue_push_latest(const sensor_sample_t *sample) {
+    if (held_valid) {
+        serial_link_merge_sample(&held_sample, sample);
+        queue_coalesced.fetch_add(1, std::memory_order_relaxed);
+        return sample_queue_flush();
+    }
+    if (try_push(sample)) {
+        return true;
+    }
+    held_sample = *sample;
+    held_valid = true;
+    return false;
+}
+
+/**
+ * @brief Publish the held-back sample if a slot is free (producer side only)
+ */
+bool sample_queue_flush() {
+    if (!held_valid || !try_push(&held_sample)) {
+        return false;
+    }
+    held_valid = false;
+    return true;
+}
+
+/**
+ * @brief Whether a sample is held back by sample_queue_push_latest()
+ */
+bool sample_queue_pending() {
+    return held_valid;
+}
+
+/**
+ * @brief Remove the oldest sample (consumer side only)
+ */
+bool sample_queue_pop(sensor_sample_t *sample) {
+    uint32_t tail = queue_tail.load(std::memory_order_relaxed);
+    uint32_t head = queue_head.load(std::memory_order_acquire);
+
+    if (head == tail) {
+        return false;
+    }
+
+    *sample = queue_slots[tail & (SAMPLE_QUEUE_LENGTH - 1)];
+    queue_tail.store(tail + 1, std::memory_order_release);  // Return slot to producer
+    return true;
+}
+
+/**
+ * @brief Remove all queued samples merged into one (consumer side only)
+ * 
+ * More than one queued sample means the consumer fell behind; applying
+ * only the merged result skips the stale intermediate states.
+ */
+bool sample_queue_pop_latest(sensor_sample_t *sample) {
+    if (!sample_queue_pop(sample)) {
+        return false;
+    }
+    sensor_sample_t newer;
+    while (sample_queue_pop(&newer)) {
+        serial_link_merge_sample(sample, &newer);
+        queue_coalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/**
+ * @brief Number of queued samples (either side)
+ */
+uint32_t sample_queue_depth() {
+    uint32_t tail = queue_tail.load(std::memory_order_acquire);
+    uint32_t head = queue_head.load(std::memory_order_acquire);
+    return head - tail;
+}
+
+/**
+ * @brief Number of samples merged into a newer one by the _latest variants
+ */
+uint32_t sample_queue_coalesced() {
+    return queue_coalesced.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Number of samples dropped because the queue was full
+ */
+uint32_t sample_queue_dropped() {
+    return queue_dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,600 @@
+/**
+ * @file serial_link.cpp
+ * @brief Implementation of non-blocking serial data ingestion
+ *
+ * Incoming bytes are drained from the serial port in small chunks and
+ * assembled into static buffers. The first byte of every line/frame selects
+ * the decoder:
+ * - SAMPLE_FRAME_SYNC starts a binary frame (see sample_protocol.h)
+ * - anything else starts a text line; text lines starting with '{' are
+ *   JSON samples, all others are commands (e.g. "stats")
+ * - a keep-alive frame becomes the SERIAL_KEEPALIVE_COMMAND command, so
+ *   both forms take the same path to the render task
+ *
+ * Complete JSON lines are decoded in place by ArduinoJson (zero-copy mode),
+ * binary frames are CRC-checked and read through a packed struct view of
+ * the receive buffer. No Arduino String is ever created and the render loop
+ * never waits for a line or frame to finish arriving.
+ *
+ * Sequenced updates (a JSON "seq" field or a delta frame) carry only the
+ * fields that changed; unsequenced JSON lines and sample frames are full
+ * samples in which a missing metric reads as 0. Sequence numbers are
+ * compared with serial arithmetic, so they may wrap.
+ *
+ * Line assembler rules:
+ * - '\n' terminates a line, '\r' is ignored
+ * - Empty lines are skipped silently
+ * - Lines longer than SERIAL_LINE_BUFFER_SIZE are discarded up to the next
+ *   newline and counted as overlong
+ * - Lines containing control bytes are discarded and counted as garbage
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "serial_link.h"
+#include "sample_protocol.h"
+#include "perf_stats.h"
+#include "latency_trace.h"
+#include <ArduinoJson.h>
+
+// ============================================================================
+// GLOBAL STATE
+// ============================================================================
+
+serial_link_stats_t serial_link_stats;  ///< Ingestion counters
+
+// ============================================================================
+// ASSEMBLER STATE
+// ============================================================================
+
+/**
+ * @brief Assembler state: what the current byte belongs to
+ */
+typedef enum {
+    LINK_STATE_IDLE,   ///< Between lines/frames, waiting for the first byte
+    LINK_STATE_TEXT,   ///< Collecting a JSON text line
+    LINK_STATE_FRAME   ///< Collecting a binary frame
+} link_state_t;
+
+static link_state_t link_state = LINK_STATE_IDLE;   ///< Current assembler state
+
+static char line_buffer[SERIAL_LINE_BUFFER_SIZE];  ///< Line under assembly (NUL-terminated on dispatch)
+static size_t line_length = 0;                      ///< Bytes currently in line_buffer
+static bool line_overflow = false;                  ///< Current line exceeded the buffer
+static bool line_has_garbage = false;               ///< Current line contains control bytes
+
+static uint8_t frame_buffer[SAMPLE_FRAME_MAX_SIZE]; ///< Binary frame under assembly
+static size_t frame_length = 0;                      ///< Bytes currently in frame_buffer
+static size_t frame_expected = 0;                    ///< Total frame size once LENGTH is known
+
+static command_handler_t command_handler = NULL;     ///< Receiver of command lines
+
+static bool seq_synced = false;                      ///< A sequenced update was accepted
+static uint32_t last_seq = 0;                        ///< Sequence number of that update
+
+static bool acks_enabled = false;                    ///< A streaming host wants credit acks
+static bool ack_forced = false;                      ///< Next ack is due regardless of the interval
+static uint32_t acked_seq = 0;                       ///< Sequence number of the last ack
+
+static uint32_t chunk_rx_us = 0;                     ///< micros() when the current chunk was read
+
+static_assert((int)METRIC_CPU_TEMP == (int)SAMPLE_METRIC_CPU_TEMP && (int)METRIC_CPU_LOAD == (int)SAMPLE_METRIC_CPU_LOAD,
+              "sample_metric_t must follow metric_id_t");
+static_assert(METRIC_COUNT <= SAMPLE_DELTA_MAX_METRICS, "too many metrics for delta frames");
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Reset assembler for the next line or frame
+ */
+static void reset_assembler() {
+    link_state = LINK_STATE_IDLE;
+    line_length = 0;
+    line_overflow = false;
+    line_has_garbage = false;
+    frame_length = 0;
+    frame_expected = 0;
+}
+
+/**
+ * @brief Check the sequence number of an update
+ *
+ * The next number is accepted, a jump ahead counts the skipped updates as
+ * lost, and a number up to SERIAL_SEQ_STALE_WINDOW behind is a late or
+ * repeated update. Anything further behind means the host restarted its
+ * counter, so the link resynchronizes on it. A host that restarts within
+ * the window is caught by its "link" request instead, which resets the
+ * sequence (serial_link_reset_sequence()).
+ *
+ * After a gap some fields may be stale, so the host is asked for its full
+ * state with a "resync:" line.
+ *
+ * @return true if the update should be applied
+ */
+static bool accept_sequence(uint32_t seq) {
+    if (seq_synced) {
+        int32_t delta = (int32_t)(seq - last_seq);
+        if (delta <= 0 && delta > -SERIAL_SEQ_STALE_WINDOW) {
+            serial_link_stats.seq_stale++;
+            return false;
+        }
+        if (delta > 1) {
+            serial_link_stats.seq_lost += (uint32_t)(delta - 1);
+            Serial.printf("resync: expected seq %lu, got %lu\n",
+                          (unsigned long)(last_seq + 1), (unsigned long)seq);
+        } else if (delta <= 0) {
+            serial_link_stats.seq_resyncs++;
+        }
+    }
+    seq_synced = true;
+    last_seq = seq;
+    return true;
+}
+
+/**
+ * @brief Count a decoded sample and hand it to the handler
+ * @param sample Decoded sample
+ * @param handler Sample callback
+ */
+static void dispatch_sample(const sensor_sample_t *sample, sample_handler_t handler) {
+    if (sample->has_seq && !accept_sequence(sample->seq)) {
+        return;
+    }
+    serial_link_stats.samples_decoded++;
+    if (handler) {
+        handler(sample);
+    }
+    latency_trace_record(LATENCY_PARSE, sample->rx_us);
+}
+
+/**
+ * @brief Hand a command line to the command handler
+ *
+ * Trailing blanks are stripped so "stats " and "stats" are the same command.
+ */
+static void dispatch_command() {
+    while (line_length > 0 && (line_buffer[line_length - 1] == ' ' || line_buffer[line_length - 1] == '\t')) {
+        line_length--;
+    }
+    line_buffer[line_length] = '\0';
+
+    if (line_length == 0) {
+        return;
+    }
+    serial_link_stats.commands_received++;
+    if (strcmp(line_buffer, SERIAL_KEEPALIVE_COMMAND) == 0) {
+        serial_link_stats.keepalives_received++;
+    }
+    if (command_handler) {
+        command_handler(line_buffer);
+    }
+}
+
+/**
+ * @brief Hand a keep-alive frame to the command handler
+ */
+static void dispatch_keepalive() {
+    serial_link_stats.keepalives_received++;
+    if (command_handler) {
+        command_handler(SERIAL_KEEPALIVE_COMMAND);
+    }
+}
+
+/**
+ * @brief Handle a terminated line: classify, decode and dispatch it
+ * @param handler Sample callback
+ */
+static void finish_line(sample_handler_t handler) {
+    // Skip leading blanks, e.g. from hosts that indent pretty-printed JSON
+    size_t start = 0;
+    while (start < line_length && (line_buffer[start] == ' ' || line_buffer[start] == '\t')) {
+        start++;
+    }
+    if (start > 0) {
+        line_length -= start;
+        memmove(line_buffer, line_buffer + start, line_length);
+    }
+
+    if (line_overflow) {
+        serial_link_stats.lines_overlong++;
+    } else if (line_has_garbage) {
+        serial_link_stats.lines_garbage++;
+    } else if (line_length > 0 && line_buffer[0] != '{') {
+        dispatch_command();
+    } else if (line_length > 0) {
+        serial_link_stats.lines_received++;
+        line_buffer[line_length] = '\0';
+
+        sensor_sample_t sample;
+        sample.rx_us = chunk_rx_us;
+        if (serial_link_parse_json(line_buffer, line_length, &sample)) {
+            dispatch_sample(&sample, handler);
+        } else {
+            serial_link_stats.lines_garbage++;
+        }
+    }
+
+    reset_assembler();
+}
+
+/**
+ * @brief Handle a complete binary frame: check CRC, decode and dispatch it
+ * @param handler Sample callback
+ */
+static void finish_frame(sample_handler_t handler) {
+    uint8_t payload_length = frame_buffer[1];
+    size_t crc_offset = SAMPLE_FRAME_HEADER_SIZE + payload_length;
+    uint16_t received_crc = (uint16_t)frame_buffer[crc_offset] |
+                            ((uint16_t)frame_buffer[crc_offset + 1] << 8);
+
+    // CRC covers LENGTH, TYPE and PAYLOAD
+    if (sample_frame_crc16(&frame_buffer[1], (size_t)payload_length + 2) != received_crc) {
+        serial_link_stats.frames_crc_error++;
+    } else {
+        serial_link_stats.frames_received++;
+
+        sensor_sample_t sample;
+        sample.rx_us = chunk_rx_us;
+        if (frame_buffer[2] == SAMPLE_FRAME_TYPE_KEEPALIVE && payload_length == 0) {
+            dispatch_keepalive();
+        } else if (serial_link_parse_frame(frame_buffer[2], &frame_buffer[SAMPLE_FRAME_HEADER_SIZE],
+                                    payload_length, &sample)) {
+            dispatch_sample(&sample, handler);
+        } else {
+            serial_link_stats.frames_invalid++;
+        }
+    }
+
+    reset_assembler();
+}
+
+/**
+ * @brief Feed one byte of a text line
+ * @param c Received byte
+ * @param handler Sample callback
+ */
+static void feed_text(uint8_t c, sample_handler_t handler) {
+    if (c == '\n') {
+        finish_line(handler);
+    } else if (c == '\r') {
+        // Ignore carriage returns from CRLF line endings
+    } else if (line_length >= SERIAL_LINE_BUFFER_SIZE - 1) {
+        line_overflow = true;  // Keep discarding until the next newline
+    } else {
+        if (c < 0x20 && c != '\t') {
+            line_has_garbage = true;
+        }
+        line_buffer[line_length++] = (char)c;
+    }
+}
+
+/**
+ * @brief Feed one byte of a binary frame
+ * @param c Received byte
+ * @param handler Sample callback
+ */
+static void feed_frame(uint8_t c, sample_handler_t handler) {
+    frame_buffer[frame_length++] = c;
+
+    if (frame_length == 2) {
+        // LENGTH byte received - validate before collecting the rest
+        if (c > SAMPLE_FRAME_MAX_PAYLOAD) {
+            serial_link_stats.frames_invalid++;
+            reset_assembler();  // Resynchronize on the next sync byte
+            return;
+        }
+        frame_expected = SAMPLE_FRAME_HEADER_SIZE + c + SAMPLE_FRAME_CRC_SIZE;
+    } else if (frame_expected > 0 && frame_length >= frame_expected) {
+        finish_frame(handler);
+    }
+}
+
+// ============================================================================
+// SERIAL LINK FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Reset assembler state and counters
+ */
+void serial_link_init() {
+    reset_assembler();
+    seq_synced = false;
+    last_seq = 0;
+    acks_enabled = false;
+    ack_forced = false;
+    acked_seq = 0;
+    memset(&serial_link_stats, 0, sizeof(serial_link_stats));
+}
+
+/**
+ * @brief Register the handler for command lines
+ */
+void serial_link_set_command_handler(command_handler_t handler) {
+    command_handler = handler;
+}
+
+/**
+ * @brief Forget the sequence of the previous host
+ */
+void serial_link_reset_sequence() {
+    if (seq_synced) {
+        serial_link_stats.seq_resyncs++;
+    }
+    seq_synced = false;
+    last_seq = 0;
+    acked_seq = 0;
+}
+
+/**
+ * @brief Enable or disable credit acks for a streaming host
+ */
+void serial_link_set_acks(bool enabled) {
+    acks_enabled = enabled;
+    ack_forced = enabled;
+}
+
+/**
+ * @brief Check whether an ack should be sent now
+ *
+ * Due when the last accepted update is SERIAL_ACK_INTERVAL past the last
+ * ack, or behind it (the host restarted its sequence). A host that keeps
+ * sending until its credits run out always reaches the interval, so the
+ * window never stalls.
+ */
+bool serial_link_ack_due(uint32_t *seq) {
+    if (!acks_enabled) {
+        return false;
+    }
+    if (!ack_forced) {
+        int32_t unacked = (int32_t)(last_seq - acked_seq);
+        if (!seq_synced || (unacked >= 0 && unacked < SERIAL_ACK_INTERVAL)) {
+            return false;
+        }
+    }
+    ack_forced = false;
+    acked_seq = last_seq;
+    *seq = last_seq;
+    return true;
+}
+
+/**
+ * @brief Merge a newer sample into an older one
+ */
+void serial_link_merge_sample(sensor_sample_t *into, const sensor_sample_t *newer) {
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        if (newer->present & (1u << id)) {
+            into->values[id] = newer->values[id];
+        }
+    }
+    into->present |= newer->present;
+    if (newer->time[0] != '\0') {
+        memcpy(into->time, newer->time, sizeof(into->time));
+    }
+    if (newer->has_seq) {
+        into->seq = newer->seq;
+        into->has_seq = true;
+    }
+    into->rx_us = newer->rx_us;
+    into->host_ts = newer->host_ts;
+    into->has_ts = newer->has_ts;
+}
+
+/**
+ * @brief Drain available serial bytes and dispatch complete lines and frames
+ *
+ * Reads only what Serial.available() reports (bounded by
+ * SERIAL_MAX_BYTES_PER_POLL), so the call never blocks. A partially received
+ * line or frame stays in its static buffer until the rest arrives on a
+ * later poll.
+ *
+ * @param handler Callback invoked for each decoded sample
+ */
+void serial_link_poll(sample_handler_t handler) {
+    uint8_t chunk[64];
+    size_t budget = SERIAL_MAX_BYTES_PER_POLL;
+
+    while (budget > 0) {
+        int available = Serial.available();
+        if (available <= 0) {
+            break;
+        }
+
+        size_t count = (size_t)available;
+        if (count > sizeof(chunk)) count = sizeof(chunk);
+        if (count > budget) count = budget;
+
+        count = Serial.read(chunk, count);
+        if (count == 0) {
+            break;
+        }
+        chunk_rx_us = micros();  // Receive stamp of the lines and frames this chunk completes
+        budget -= count;
+        serial_link_stats.bytes_received += count;
+
+        for (size_t i = 0; i < count; i++) {
+            uint8_t c = chunk[i];
+
+            switch (link_state) {
+                case LINK_STATE_IDLE:
+                    if (c == SAMPLE_FRAME_SYNC) {
+                        link_state = LINK_STATE_FRAME;
+                        feed_frame(c, handler);
+                    } else if (c != '\n' && c != '\r') {
+                        link_state = LINK_STATE_TEXT;
+                        feed_text(c, handler);
+                    }
+                    break;
+
+                case LINK_STATE_TEXT:
+                    feed_text(c, handler);
+                    break;
+
+                case LINK_STATE_FRAME:
+                    feed_frame(c, handler);
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decode a JSON sample line in place
+ *
+ * Uses ArduinoJson's zero-copy mode: string values point into the line
+ * buffer, which is why the buffer must be mutable. Fields are mapped to
+ * metrics through metric_lookup_key(); unknown fields are ignored. Without
+ * a "seq" field the line is a full sample and metrics that are not sent
+ * read as 0; with one it is a partial update of the fields present. An
+ * optional "ts" field is a host stamp echoed once the sample is on the panel.
+ * Expected format: {"time":"HH:MM:SS","cpu_load":0-100,"cpu_temp":0-100}
+ *              or: {"seq":N,"cpu_load":0-100}
+ *              or: {"seq":N,"ts":N,"cpu_load":0-100}
+ *
+ * @param line Mutable, NUL-terminated line buffer (modified by the parser)
+ * @param length Line length in bytes
+ * @param sample Output sample structure
+ * @return true if the line was valid JSON
+ */
+bool serial_link_parse_json(char *line, size_t length, sensor_sample_t *sample) {
+    // Parse JSON data with 256-byte buffer (sufficient for expected format)
+    uint32_t parse_start = PERF_TIMESTAMP();
+    StaticJsonDocument<256> json_doc;
+    DeserializationError error = deserializeJson(json_doc, line, length);
+    PERF_RECORD(PERF_JSON_PARSE, parse_start);
+    if (error) {
+        return false;
+    }
+
+    // Extract data fields from JSON in a single pass over the object
+    sample->time[0] = '\0';
+    memset(sample->values, 0, sizeof(sample->values));
+    sample->present = 0;
+    sample->has_seq = false;
+    sample->has_ts = false;
+
+    for (JsonPair field : json_doc.as<JsonObject>()) {
+        const char *key = field.key().c_str();
+        if (strcmp(key, "seq") == 0) {
+            sample->seq = field.value().as<uint32_t>();
+            sample->has_seq = true;
+            continue;
+        }
+        if (strcmp(key, "ts") == 0) {
+            sample->host_ts = field.value().as<uint32_t>();
+            sample->has_ts = true;
+            continue;
+        }
+        if (strcmp(key, "time") == 0) {
+            const char *time_text = field.value().as<const char *>();  // Time string "HH:MM:SS"
+            if (time_text) {
+                strlcpy(sample->time, time_text, sizeof(sample->time));
+            }
+            continue;
+        }
+
+        int metric = metric_lookup_key(key);
+        if (metric != METRIC_UNKNOWN) {
+            sample->values[metric] = field.value().as<int32_t>();
+            sample->present |= 1u << metric;
+        }
+    }
+
+    if (!sample->has_seq) {
+        sample->present = SAMPLE_ALL_METRICS;
+    }
+    return true;
+}
+
+/**
+ * @brief Format a wire time as sample text
+ */
+static void format_frame_time(uint8_t hour, uint8_t minute, uint8_t second, sensor_sample_t *sample) {
+    if (hour == SAMPLE_FRAME_NO_TIME) {
+        sample->time[0] = '\0';
+    } else if (second == SAMPLE_FRAME_NO_SECONDS) {
+        snprintf(sample->time, sizeof(sample->time), "%02u:%02u", (unsigned)hour, (unsigned)minute);
+    } else {
+        snprintf(sample->time, sizeof(sample->time), "%02u:%02u:%02u",
+                 (unsigned)hour, (unsigned)minute, (unsigned)second);
+    }
+}
+
+/**
+ * @brief Decode a delta frame: header, then the flagged fields in bit order
+ * @return true if the payload length matches the flagged fields
+ */
+static bool parse_delta_frame(const uint8_t *payload, size_t length, sensor_sample_t *sample) {
+    if (length < sizeof(delta_frame_header_t)) {
+        return false;
+    }
+    const delta_frame_header_t *header = (const delta_frame_header_t *)payload;
+    uint16_t fields = header->fields;
+    size_t offset = sizeof(delta_frame_header_t);
+
+    sample->time[0] = '\0';
+    memset(sample->values, 0, sizeof(sample->values));
+    sample->present = 0;
+    sample->seq = header->seq;
+    sample->has_seq = true;
+    sample->has_ts = false;
+
+    if (fields & SAMPLE_DELTA_TIME) {
+        if (offset + 3 > length) {
+            return false;
+        }
+        format_frame_time(payload[offset], payload[offset + 1], payload[offset + 2], sample);
+        offset += 3;
+    }
+    for (int metric = 0; metric < SAMPLE_DELTA_MAX_METRICS; metric++) {
+        if (!(fields & SAMPLE_DELTA_METRIC(metric))) {
+            continue;
+        }
+        if (offset + sizeof(int16_t) > length) {
+            return false;
+        }
+        int16_t value = (int16_t)(payload[offset] | (payload[offset + 1] << 8));
+        offset += sizeof(int16_t);
+        if (metric < METRIC_COUNT) {  // Metrics this build does not know are skipped
+            sample->values[metric] = value;
+            sample->present |= 1u << metric;
+        }
+    }
+    return offset == length;
+}
+
+/**
+ * @brief Decode a CRC-checked binary frame
+ *
+ * The payload is read through a packed struct view of the receive buffer;
+ * nothing is copied except the final field values. Sample frames are full
+ * samples, delta frames partial updates.
+ *
+ * @param type Frame type byte
+ * @param payload Pointer to payload bytes inside the receive buffer
+ * @param length Payload length in bytes
+ * @param sample Output sample structure
+ * @return true if the frame carried a sample
+ */
+bool serial_link_parse_frame(uint8_t type, const uint8_t *payload, size_t length, sensor_sample_t *sample) {
+    if (type == SAMPLE_FRAME_TYPE_DELTA) {
+        return parse_delta_frame(payload, length, sample);
+    }
+    if (type != SAMPLE_FRAME_TYPE_SAMPLE || length != sizeof(sample_frame_payload_t)) {
+        return false;
+    }
+
+    const sample_frame_payload_t *view = (const sample_frame_payload_t *)payload;
+
+    format_frame_time(view->hour, view->minute, view->second, sample);
+    memset(sample->values, 0, sizeof(sample->values));
+    sample->values[METRIC_CPU_LOAD] = view->cpu_load;
+    sample->values[METRIC_CPU_TEMP] = view->cpu_temp;
+    sample->present = SAMPLE_ALL_METRICS;
+    sample->has_seq = false;
+    sample->has_ts = false;
+
+    return true;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file arduino_sim.cpp
+ * @brief Arduino core shim for the native simulator build
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include <Arduino.h>
+
+// ============================================================================
+// GLOBAL VARIABLES
+// ============================================================================
+
+SimSerial Serial;  ///< Global serial instance
+
+static uint64_t sim_time_us = 0;  ///< Simulated time since start
+
+// ============================================================================
+// VIRTUAL CLOCK
+// ============================================================================
+
+uint32_t millis() {
+  return (uint32_t)(sim_time_us / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)sim_time_us;
+}
+
+void delay(uint32_t ms) {
+  sim_clock_advance(ms);
+}
+
+void sim_clock_advance(uint32_t ms) {
+  sim_time_us += (uint64_t)ms * 1000;
+}
+
+uint32_t getCpuFrequencyMhz() {
+  return SIM_CPU_MHZ;
+}
+
+// ============================================================================
+// PRINT
+// ============================================================================
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t written = 0;
+  while (written < size && write(buffer[written])) {
+    written++;
+  }
+  return written;
+}
+
+/**
+ * @brief Format into a stack buffer and write it (longer output is truncated)
+ */
+size_t Print::printf(const char *format, ...) {
+  char buffer[512];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length <= 0) {
+    return 0;
+  }
+  if ((size_t)length >= sizeof(buffer)) {
+    length = sizeof(buffer) - 1;
+  }
+  return write((const uint8_t *)buffer, (size_t)length);
+}
+
+// ============================================================================
+// SERIAL
+// ============================================================================
+
+size_t SimSerial::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t SimSerial::write(const uint8_t *buffer, size_t size) {
+  if (!quiet_) {
+    fwrite(buffer, 1, size, stdout);
+  }
+  return size;
+}
+
+int SimSerial::available() {
+  return (int)rx_count_;
+}
+
+int SimSerial::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t SimSerial::read(uint8_t *buffer, size_t size) {
+  size_t count = size < rx_count_ ? size : rx_count_;
+  for (size_t i = 0; i < count; i++) {
+    buffer[i] = rx_[rx_head_];
+    rx_head_ = (rx_head_ + 1) % SIM_SERIAL_RX_SIZE;
+  }
+  rx_count_ -= count;
+  return count;
+}
+
+size_t SimSerial::feed(const void *data, size_t size) {
+  const uint8_t *bytes = (const uint8_t *)data;
+  size_t count = 0;
+  while (count < size && rx_count_ < SIM_SERIAL_RX_SIZE) {
+    rx_[(rx_head_ + rx_count_) % SIM_SERIAL_RX_SIZE] = bytes[count++];
+    rx_count_++;
+  }
+  return count;
+}
@@ -0,0 +1,345 @@
+/**
+ * @file display_sim.cpp
+ * @brief Headless display driver for the native simulator build
+ *
+ * Implements display_driver.h on a 240x240 in-memory panel. LVGL renders
+ * through the same buffer modes as the firmware (partial stripes or full
+ * frame direct mode) and the flush copies into the panel memory, so the
+ * render path and the refresh statistics match the hardware; only the SPI
+ * transfer is missing. The round-panel culling and tile diffing of the
+ * firmware driver are not applied: every invalidated pixel is rendered.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "display_driver.h"
+#include "display_sim.h"
+#include "perf_stats.h"
+#include "latency_trace.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+// ============================================================================
+// GLOBAL VARIABLES
+// ============================================================================
+
+const uint16_t SCREEN_WIDTH = 240;   ///< Display width in pixels
+const uint16_t SCREEN_HEIGHT = 240;  ///< Display height in pixels
+
+display_refresh_stats_t display_refresh_stats;  ///< Refresh counters
+
+static lv_color_t panel_memory[240 * 240];  ///< Simulated panel frame memory
+
+static lv_disp_draw_buf_t draw_buf;                 ///< LVGL draw buffer descriptor
+static lv_disp_drv_t disp_drv;                      ///< LVGL display driver
+static lv_color_t *draw_buffers[2] = {NULL, NULL};  ///< Stripe buffers (NULL in direct mode)
+
+static uint32_t frame_flush_cycles = 0;         ///< Cycles spent in flush_cb during the current refresh
+static uint32_t frame_flush_px = 0;             ///< Pixels flushed during the current refresh
+static uint32_t frame_first_flush_us = 0;       ///< micros() at the first flush of the refresh
+static display_frame_hook_t frame_hook = NULL;  ///< Optional refresh observer
+
+static uint32_t refresh_active_ms = DISPLAY_REFR_ACTIVE_MS;  ///< Period while animating
+static uint32_t refresh_idle_ms = DISPLAY_REFR_IDLE_MS;      ///< Period while idle
+static bool refresh_active = false;                          ///< Active period selected
+
+static bool low_power = false;     ///< Blanked low-power mode active
+static bool backlight = false;     ///< Simulated backlight state
+
+// ============================================================================
+// LVGL CALLBACKS
+// ============================================================================
+
+/**
+ * @brief LVGL flush callback - copies the rendered area into panel memory
+ *
+ * In direct mode LVGL renders into panel memory itself, so only the pixel
+ * count is recorded.
+ */
+void display_flush_callback(lv_disp_drv_t *display_driver, const lv_area_t *update_area, lv_color_t *color_buffer) {
+  uint32_t flush_start = perf_stats_cycles();
+  if (frame_flush_px == 0) {
+    frame_first_flush_us = micros();
+  }
+
+  int32_t w = update_area->x2 - update_area->x1 + 1;
+  int32_t h = update_area->y2 - update_area->y1 + 1;
+
+  if (!display_driver->direct_mode) {
+    for (int32_t y = 0; y < h; y++) {
+      memcpy(&panel_memory[(update_area->y1 + y) * SCREEN_WIDTH + update_area->x1],
+             &color_buffer[y * w], w * sizeof(lv_color_t));
+    }
+  }
+
+  uint32_t flush_cycles = perf_stats_cycles() - flush_start;
+  PERF_RECORD_CYCLES(PERF_FLUSH, flush_cycles);
+  frame_flush_cycles += flush_cycles;
+  frame_flush_px += (uint32_t)(w * h);
+
+  lv_disp_flush_ready(display_driver);
+}
+
+/**
+ * @brief LVGL monitor callback - records pixels refreshed per frame
+ */
+static void display_monitor_callback(lv_disp_drv_t *display_driver, uint32_t time, uint32_t px) {
+  display_refresh_stats.frames++;
+  display_refresh_stats.last_frame_px = px;
+  display_refresh_stats.last_frame_ms = time;
+  display_refresh_stats.total_px += px;
+  if (px > display_refresh_stats.max_frame_px) {
+    display_refresh_stats.max_frame_px = px;
+  }
+}
+
+/**
+ * @brief Instrumented replacement for LVGL's display refresh timer callback
+ *
+ * Same measurement as the firmware driver: complete refresh time, render
+ * time without flushes, pixels flushed and the latency trace.
+ */
+static void display_refresh_timer_callback(lv_timer_t *timer) {
+  frame_flush_cycles = 0;
+  frame_flush_px = 0;
+
+  uint32_t frame_start = perf_stats_cycles();
+  _lv_disp_refr_timer(timer);
+  uint32_t frame_cycles = perf_stats_cycles() - frame_start;
+
+  if (frame_flush_px == 0) {
+    return;
+  }
+
+  latency_trace_frame_flushed(frame_first_flush_us, micros());
+  PERF_RECORD_CYCLES(PERF_FRAME_TOTAL, frame_cycles);
+  PERF_RECORD_CYCLES(PERF_FRAME_RENDER, frame_cycles - frame_flush_cycles);
+  PERF_RECORD_VALUE(PERF_FRAME_PIXELS, frame_flush_px);
+#if PERF_STATS_ENABLE
+  perf_stats_frame_done();
+#endif
+
+  if (frame_hook) {
+    uint32_t mhz = getCpuFrequencyMhz();
+    frame_hook(frame_cycles / mhz, frame_flush_cycles / mhz, frame_flush_px);
+  }
+}
+
+// ============================================================================
+// SYSTEM INITIALIZATION
+// ============================================================================
+
+/**
+ * @brief Initialize LVGL with the simulated panel
+ */
+void display_init() {
+  backlight_init();
+  lv_init();
+  lvgl_timer_init();
+
+  lv_disp_drv_init(&disp_drv);
+
+  bool configured = false;
+  if (DISPLAY_FULL_FRAME) {
+    configured = display_configure_full_frame(DISPLAY_FULL_FRAME == 2);
+  }
+  if (!configured) {
+    display_configure_buffers(DISPLAY_BUFFER_LINES, DISPLAY_DOUBLE_BUFFER);
+  }
+
+  disp_drv.flush_cb = display_flush_callback;
+  disp_drv.monitor_cb = display_monitor_callback;
+  disp_drv.draw_buf = &draw_buf;
+  disp_drv.hor_res = SCREEN_WIDTH;
+  disp_drv.ver_res = SCREEN_HEIGHT;
+  lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+  lv_timer_set_cb(disp->refr_timer, display_refresh_timer_callback);
+  display_set_refresh_period(refresh_idle_ms);
+}
+
+/**
+ * @brief No tick timer: the simulator calls lv_tick_inc() as it advances time
+ */
+void lvgl_timer_init() {
+}
+
+// ============================================================================
+// RUNTIME RECONFIGURATION
+// ============================================================================
+
+/**
+ * @brief Replace the LVGL draw buffers and redraw everything
+ */
+static void install_buffers(lv_color_t *buf, lv_color_t *buf2, uint32_t pixels, bool direct_mode) {
+  heap_caps_free(draw_buffers[0]);
+  heap_caps_free(draw_buffers[1]);
+
+  draw_buffers[0] = direct_mode ? NULL : buf;
+  draw_buffers[1] = buf2;
+  lv_disp_draw_buf_init(&draw_buf, buf, buf2, pixels);
+  disp_drv.direct_mode = direct_mode;
+
+  if (lv_disp_get_default()) {
+    lv_obj_invalidate(lv_scr_act());
+  }
+}
+
+/**
+ * @brief Allocate partial stripe buffers
+ *
+ * With double buffering LVGL alternates between two buffers; the flush
+ * completes immediately, so this only changes buffer reuse, not overlap.
+ */
+bool display_configure_buffers(uint16_t buffer_lines, bool double_buffer) {
+  const uint32_t buffer_pixels = (uint32_t)SCREEN_WIDTH * buffer_lines;
+  const size_t buffer_bytes = buffer_pixels * sizeof(lv_color_t);
+
+  lv_color_t *buf = (lv_color_t *)heap_caps_malloc(buffer_bytes, MALLOC_CAP_DMA);
+  lv_color_t *buf2 = double_buffer ? (lv_color_t *)heap_caps_malloc(buffer_bytes, MALLOC_CAP_DMA) : NULL;
+  if (!buf || (double_buffer && !buf2)) {
+    heap_caps_free(buf);
+    heap_caps_free(buf2);
+    Serial.printf("Display buffer allocation failed (%u lines)\n", (unsigned)buffer_lines);
+    return false;
+  }
+
+  install_buffers(buf, buf2, buffer_pixels, false);
+  return true;
+}
+
+/**
+ * @brief Render directly into panel memory (memory type is irrelevant here)
+ */
+bool display_configure_full_frame(bool use_psram) {
+  (void)use_psram;
+  install_buffers(panel_memory, NULL, (uint32_t)SCREEN_WIDTH * SCREEN_HEIGHT, true);
+  return true;
+}
+
+/**
+ * @brief No SPI bus in the simulator
+ */
+void display_set_spi_frequency(uint32_t freq_write_hz) {
+  (void)freq_write_hz;
+}
+
+/**
+ * @brief Change the LVGL display refresh period
+ */
+void display_set_refresh_period(uint32_t period_ms) {
+  lv_disp_t *disp = lv_disp_get_default();
+  if (disp && disp->refr_timer) {
+    lv_timer_set_period(disp->refr_timer, period_ms);
+  }
+}
+
+/**
+ * @brief Set the refresh periods used while animating and while idle
+ */
+void display_set_refresh_policy(uint32_t active_ms, uint32_t idle_ms) {
+  refresh_active_ms = active_ms;
+  refresh_idle_ms = idle_ms;
+  display_set_refresh_period(refresh_active ? active_ms : idle_ms);
+}
+
+/**
+ * @brief Switch between the active and idle refresh period
+ */
+void display_set_refresh_active(bool active) {
+  if (active == refresh_active) {
+    return;
+  }
+  refresh_active = active;
+  display_set_refresh_period(active ? refresh_active_ms : refresh_idle_ms);
+
+  lv_disp_t *disp = lv_disp_get_default();
+  if (disp && disp->refr_timer) {
+    lv_timer_ready(disp->refr_timer);
+  }
+}
+
+/**
+ * @brief Register an observer for completed refreshes
+ */
+void display_set_frame_hook(display_frame_hook_t hook) {
+  frame_hook = hook;
+}
+
+// ============================================================================
+// LOW-POWER MODE
+// ============================================================================
+
+/**
+ * @brief Enter the blanked low-power mode (the simulator stops the LVGL tick)
+ */
+void display_enter_low_power() {
+  if (low_power) {
+    return;
+  }
+  low_power = true;
+  Serial.println("Low-power mode: tick stopped");
+}
+
+/**
+ * @brief Leave the blanked low-power mode
+ */
+void display_exit_low_power() {
+  if (!low_power) {
+    return;
+  }
+  low_power = false;
+  Serial.println("Low-power mode left");
+}
+
+/**
+ * @brief Whether the low-power mode is active
+ */
+bool display_low_power_active() {
+  return low_power;
+}
+
+// ============================================================================
+// BACKLIGHT CONTROL FUNCTIONS
+// ============================================================================
+
+void backlight_init() {
+  backlight = true;
+}
+
+void backlight_on() {
+  backlight = true;
+  Serial.println("Backlight turned on");
+}
+
+void backlight_off() {
+  backlight = false;
+  Serial.println("Backlight turned off");
+}
+
+bool display_sim_backlight_on() {
+  return backlight;
+}
+
+// ============================================================================
+// FRAME DUMP
+// ============================================================================
+
+/**
+ * @brief Write panel memory as RGB888 PPM (black while the backlight is off)
+ */
+bool display_sim_write_ppm(const char *path) {
+  FILE *file = fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+
+  fprintf(file, "P6\n%u %u\n255\n", (unsigned)SCREEN_WIDTH, (unsigned)SCREEN_HEIGHT);
+  for (uint32_t i = 0; i < (uint32_t)SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+    uint32_t rgb = backlight ? lv_color_to32(panel_memory[i]) : 0;
+    uint8_t pixel[3] = {(uint8_t)(rgb >> 16), (uint8_t)(rgb >> 8), (uint8_t)rgb};
+    fwrite(pixel, 1, sizeof(pixel), file);
+  }
+  return fclose(file) == 0;
+}
@@ -0,0 +1,369 @@
+/**
+ * @file sim_main.cpp
+ * @brief Native simulator: replays a recorded host stream through the UI
+ *
+ * Runs the firmware's serial link, sample queue, system manager and UI
+ * code on the desktop against LVGL with a headless framebuffer (see
+ * display_sim.cpp). Both firmware tasks run in one loop on a virtual clock
+ * that jumps straight to the next recorded line or LVGL / system manager
+ * deadline, so minutes of recording replay in well under a second while
+ * every timeout, animation and refresh happens at its simulated time.
+ * The binary is meant to run under perf, callgrind or a sanitizer.
+ *
+ * Recording format, one host line per line:
+ *
+ *   <ms><TAB><line>
+ *
+ * where ms is the send time since the start of the recording. Lines
+ * without a timestamp are sent 1000 ms after the previous one, so a plain
+ * capture of the JSON stream replays at one sample per second. Lines
+ * starting with '#' are comments.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+// Unit tests (pio test -e native) link the sources with their own main()
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+#include <errno.h>
+#include <getopt.h>
+#include <time.h>
+#include "display_driver.h"
+#include "display_sim.h"
+#include "ui_components.h"
+#include "system_manager.h"
+#include "serial_link.h"
+#include "sample_queue.h"
+#include "sample_apply.h"
+#include "perf_stats.h"
+#include "latency_trace.h"
+#include "metric_registry.h"
+#include "metric_history.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define SIM_LINE_SIZE        256    ///< Longest recorded line (longer lines are cut)
+#define SIM_DEFAULT_STEP_MS  1000   ///< Send time of lines without a timestamp
+#define SIM_DEFAULT_TAIL_MS  90000  ///< Simulated time after the last line (blank timeout runs out)
+#define SIM_DUMP_PATH_SIZE   512    ///< Frame dump path buffer
+
+/**
+ * @struct sim_options_t
+ * @brief Command line options
+ */
+typedef struct {
+  const char *recording;  ///< Recording file ("-" = stdin)
+  const char *dump_dir;   ///< Directory for PPM frame dumps (NULL = none)
+  unsigned dump_every_ms; ///< Simulated time between frame dumps
+  unsigned tail_ms;       ///< Simulated time to run after the last line
+  double speed;           ///< Replay speed relative to real time (0 = unthrottled)
+  bool quiet;             ///< Suppress firmware log output during the replay
+} sim_options_t;
+
+/**
+ * @struct sim_replay_t
+ * @brief Recording reader state (one line of look-ahead)
+ */
+typedef struct {
+  FILE *file;                    ///< Open recording
+  char line[SIM_LINE_SIZE + 2];  ///< Next line to send, with '\n'
+  size_t length;                 ///< Bytes in line
+  size_t sent;                   ///< Bytes of line already fed to Serial
+  uint32_t due_ms;               ///< Simulated send time of line
+  bool pending;                  ///< line holds an unsent line
+  uint32_t lines;                ///< Lines sent so far
+} sim_replay_t;
+
+static sim_replay_t replay;
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+/**
+ * @brief Read the next recorded line into the look-ahead slot
+ */
+static void replay_next_line() {
+  char buffer[SIM_LINE_SIZE + 2];
+  replay.pending = false;
+
+  while (fgets(buffer, sizeof(buffer), replay.file)) {
+    size_t length = strcspn(buffer, "\r\n");
+    if (buffer[length] == '\0' && !feof(replay.file)) {
+      // Cut overlong lines; skip the rest of them
+      int c;
+      while ((c = fgetc(replay.file)) != EOF && c != '\n') {
+      }
+    }
+    buffer[length] = '\0';
+    if (length == 0 || buffer[0] == '#') {
+      continue;
+    }
+
+    const char *text = buffer;
+    char *end;
+    unsigned long ms = strtoul(buffer, &end, 10);
+    if (end != buffer && *end == '\t') {
+      replay.due_ms = (uint32_t)ms;
+      text = end + 1;
+    } else {
+      replay.due_ms += replay.lines > 0 ? SIM_DEFAULT_STEP_MS : 0;
+    }
+
+    replay.length = (size_t)snprintf(replay.line, sizeof(replay.line), "%s\n", text);
+    replay.sent = 0;
+    replay.pending = true;
+    return;
+  }
+}
+
+/**
+ * @brief Feed every line that is due into the simulated serial port
+ *
+ * A line that does not fit into the receive buffer is continued after the
+ * serial link has drained it.
+ */
+static void replay_feed(uint32_t now_ms) {
+  while (replay.pending && (int32_t)(now_ms - replay.due_ms) >= 0) {
+    replay.sent += Serial.feed(replay.line + replay.sent, replay.length - replay.sent);
+    if (replay.sent < replay.length) {
+      return;
+    }
+    replay.lines++;
+    replay_next_line();
+  }
+}
+
+// ============================================================================
+// SAMPLE PROCESSING
+// ============================================================================
+
+/**
+ * @brief Queue a decoded sample (the render pass pops it right after)
+ */
+static void enqueue_sample(const sensor_sample_t *sample) {
+  sample_queue_push_latest(sample);
+}
+
+/**
+ * @brief Handle recorded command lines
+ *
+ * Only the keep-alive changes display state; commands that report or
+ * reconfigure the hardware are ignored.
+ */
+static void handle_command(const char *command) {
+  if (strcmp(command, SERIAL_KEEPALIVE_COMMAND) == 0) {
+    sample_apply_keepalive();
+  }
+}
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+
+static void print_usage(const char *program) {
+  printf("Usage: %s [options] RECORDING\n"
+         "  -s, --speed X         replay speed, 1 = real time (default 0 = as fast as possible)\n"
+         "  -t, --tail MS         simulated time after the last line (default %d)\n"
+         "  -o, --dump-dir DIR    write PPM frames of the panel into DIR\n"
+         "  -e, --dump-every MS   simulated time between frames (default 1000)\n"
+         "  -q, --quiet           hide firmware log output\n"
+         "  -h, --help            show this help\n",
+         program, SIM_DEFAULT_TAIL_MS);
+}
+
+/**
+ * @brief Parse the command line
+ * @return false if the program should exit
+ */
+static bool parse_options(int argc, char **argv, sim_options_t *options) {
+  static const struct option long_options[] = {
+    { "speed",      required_argument, NULL, 's' },
+    { "tail",       required_argument, NULL, 't' },
+    { "dump-dir",   required_argument, NULL, 'o' },
+    { "dump-every", required_argument, NULL, 'e' },
+    { "quiet",      no_argument,       NULL, 'q' },
+    { "help",       no_argument,       NULL, 'h' },
+    { NULL, 0, NULL, 0 },
+  };
+
+  options->dump_dir = NULL;
+  options->dump_every_ms = 1000;
+  options->tail_ms = SIM_DEFAULT_TAIL_MS;
+  options->speed = 0;
+  options->quiet = false;
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "s:t:o:e:qh", long_options, NULL)) != -1) {
+    switch (opt) {
+      case 's': options->speed = atof(optarg); break;
+      case 't': options->tail_ms = (unsigned)strtoul(optarg, NULL, 10); break;
+      case 'o': options->dump_dir = optarg; break;
+      case 'e': options->dump_every_ms = (unsigned)strtoul(optarg, NULL, 10); break;
+      case 'q': options->quiet = true; break;
+      default:
+        print_usage(argv[0]);
+        return false;
+    }
+  }
+  if (optind != argc - 1 || options->speed < 0 || options->dump_every_ms == 0) {
+    print_usage(argv[0]);
+    return false;
+  }
+  options->recording = argv[optind];
+  return true;
+}
+
+// ============================================================================
+// SIMULATION LOOP
+// ============================================================================
+
+/**
+ * @brief Advance simulated time, optionally throttled to the replay speed
+ *
+ * The LVGL tick only runs outside the low-power mode, as on the hardware.
+ */
+static void advance_time(uint32_t ms, double speed) {
+  sim_clock_advance(ms);
+  if (!display_low_power_active()) {
+    lv_tick_inc(ms);
+  }
+  if (speed > 0) {
+    uint64_t ns = (uint64_t)(ms * 1000000.0 / speed);
+    struct timespec pause = { (time_t)(ns / 1000000000ULL), (long)(ns % 1000000000ULL) };
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &pause, &pause) == EINTR) {
+    }
+  }
+}
+
+static uint64_t monotonic_us() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000 + (uint64_t)(now.tv_nsec / 1000);
+}
+
+int main(int argc, char **argv) {
+  sim_options_t options;
+  if (!parse_options(argc, argv, &options)) {
+    return EXIT_FAILURE;
+  }
+
+  replay.file = strcmp(options.recording, "-") == 0 ? stdin : fopen(options.recording, "r");
+  if (!replay.file) {
+    fprintf(stderr, "Cannot open %s: %s\n", options.recording, strerror(errno));
+    return EXIT_FAILURE;
+  }
+  replay_next_line();
+  Serial.set_quiet(options.quiet);
+
+  // Same order as setup() in main.cpp
+  metric_registry_init();
+  metric_history_init();
+  display_init();
+  ui_init();
+  system_manager_init();
+  serial_link_init();
+  serial_link_set_command_handler(handle_command);
+  sample_queue_init();
+  perf_stats_init();
+
+  uint64_t wall_start_us = monotonic_us();
+  uint32_t end_ms = 0;
+  uint32_t next_dump_ms = 0;
+  uint32_t dumps = 0;
+  bool building_ui = true;
+
+  for (;;) {
+    uint32_t now = millis();
+
+    // Ingest pass
+    replay_feed(now);
+    serial_link_poll(enqueue_sample);
+    sample_queue_flush();
+
+    // Render pass, as render_task() in main.cpp
+    if (!building_ui) {
+      sensor_sample_t sample;
+      if (sample_queue_pop_latest(&sample)) {
+        sample_apply(&sample);
+      }
+      system_periodic_update();
+    }
+
+    uint32_t lvgl_ms = LV_NO_TIMER_READY;
+    if (!display_low_power_active()) {
+      uint32_t handler_start = PERF_TIMESTAMP();
+      lvgl_ms = lv_timer_handler();
+      PERF_RECORD(PERF_LVGL_HANDLER, handler_start);
+      latency_trace_send_echo();
+    }
+
+    if (building_ui) {
+      building_ui = ui_build_step();
+    }
+
+    if (options.dump_dir && (int32_t)(now - next_dump_ms) >= 0) {
+      char path[SIM_DUMP_PATH_SIZE];
+      snprintf(path, sizeof(path), "%s/frame_%08lu.ppm", options.dump_dir, (unsigned long)now);
+      if (!display_sim_write_ppm(path)) {
+        fprintf(stderr, "Cannot write %s: %s\n", path, strerror(errno));
+        options.dump_dir = NULL;
+      }
+      dumps++;
+      next_dump_ms = now + options.dump_every_ms;
+    }
+
+    // Stop once the recording is consumed and the tail has run out
+    if (!replay.pending && Serial.available() == 0) {
+      if (end_ms == 0) {
+        end_ms = now + options.tail_ms;
+      }
+      if ((int32_t)(now - end_ms) >= 0) {
+        break;
+      }
+    }
+
+    // Jump to the earliest of: next line, LVGL timer, system deadline,
+    // frame dump, end of tail
+    uint32_t wait_ms = building_ui ? 0 : system_ms_until_next_deadline();
+    if (lvgl_ms < wait_ms) wait_ms = lvgl_ms;
+    if (replay.pending) {
+      uint32_t line_ms = (int32_t)(replay.due_ms - now) > 0 ? replay.due_ms - now : 0;
+      if (line_ms < wait_ms) wait_ms = line_ms;
+    }
+    if (options.dump_dir && next_dump_ms - now < wait_ms) wait_ms = next_dump_ms - now;
+    if (end_ms != 0 && end_ms - now < wait_ms) wait_ms = end_ms - now;
+    advance_time(wait_ms > 0 ? wait_ms : 1, options.speed);
+  }
+
+  uint64_t wall_us = monotonic_us() - wall_start_us;
+  uint32_t sim_ms = millis();
+
+  Serial.set_quiet(false);
+  Serial.println();
+  perf_stats_print(Serial);
+  latency_trace_print(Serial);
+  Serial.printf("Replay: %lu lines, %lu samples decoded, %lu coalesced\n",
+                (unsigned long)replay.lines, (unsigned long)serial_link_stats.samples_decoded,
+                (unsigned long)sample_queue_coalesced());
+  Serial.printf("Frames: %lu, %llu px rendered (max %lu px in one frame)\n",
+                (unsigned long)display_refresh_stats.frames,
+                (unsigned long long)display_refresh_stats.total_px,
+                (unsigned long)display_refresh_stats.max_frame_px);
+  if (dumps > 0) {
+    Serial.printf("Dumped %lu frames\n", (unsigned long)dumps);
+  }
+  Serial.printf("Simulated %lu ms in %llu ms wall time (%.1fx)\n", (unsigned long)sim_ms,
+                (unsigned long long)(wall_us / 1000), wall_us > 0 ? sim_ms * 1000.0 / wall_us : 0.0);
+
+  if (replay.file != stdin) {
+    fclose(replay.file);
+  }
+  return EXIT_SUCCESS;
+}
+
+#endif // PIO_UNIT_TESTING
@@ -0,0 +1,27 @@
+/**
+ * @file sprite_gauge_sim.cpp
+ * @brief Sprite meter renderer stub for the native simulator build
+ *
+ * The sprite renderer needs LovyanGFX, which is not built natively.
+ * Attaching always fails, so the UI falls back to the lv_meter needle.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "sprite_gauge.h"
+
+bool sprite_gauge_attach(meter_layer_cache_t *cache, const meter_config_t *config, lv_coord_t needle_length) {
+    (void)cache;
+    (void)config;
+    (void)needle_length;
+    return false;
+}
+
+void sprite_gauge_draw(const meter_layer_cache_t *cache, lv_draw_ctx_t *draw_ctx,
+                       const lv_point_t *center, int32_t angle) {
+    (void)cache;
+    (void)draw_ctx;
+    (void)center;
+    (void)angle;
+}
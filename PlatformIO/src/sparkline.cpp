@@ -0,0 +1,239 @@
+/**
+ * @file sparkline.cpp
+ * @brief Implementation of the scrolling sparkline widget
+ *
+ * The widget is a plain object whose LV_EVENT_DRAW_MAIN handler blits its
+ * RGB565 buffer with lv_draw_img (same approach as the time display). The
+ * buffer is column-aligned to absolute history indexes: the right-most
+ * column is point shown_total - 1, so a sync only has to move the rows by
+ * the number of new points and draw those columns.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "sparkline.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+// ============================================================================
+// WIDGET STATE
+// ============================================================================
+
+/**
+ * @struct sparkline_t
+ * @brief Buffer and data source of one sparkline
+ */
+typedef struct {
+    lv_obj_t *obj;              ///< Widget object (NULL = free slot)
+    lv_img_dsc_t image;         ///< Image descriptor of the buffer
+    lv_color_t *pixels;         ///< width x height pixel buffer
+    lv_coord_t width;           ///< Buffer width (columns)
+    lv_coord_t height;          ///< Buffer height (rows)
+    lv_color_t avg_color;       ///< Average line color
+    lv_color_t range_color;     ///< Min..max band color
+    metric_id_t metric;         ///< Metric shown
+    history_tier_t tier;        ///< History tier shown
+    int32_t value_min;          ///< Value at the bottom row
+    int32_t value_max;          ///< Value at the top row
+    uint32_t shown_total;       ///< History total at the last sync
+} sparkline_t;
+
+static sparkline_t sparklines[SPARKLINE_MAX_INSTANCES];  ///< Sparkline instances
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Row of a value (0 = top), clamped to the buffer
+ */
+static lv_coord_t value_to_row(const sparkline_t *s, int32_t value) {
+    int32_t row = lv_map(value, s->value_min, s->value_max, s->height - 1, 0);
+    return (lv_coord_t)LV_CLAMP(0, row, s->height - 1);
+}
+
+/**
+ * @brief Fill columns [x, x + count) with the background
+ */
+static void clear_columns(sparkline_t *s, lv_coord_t x, lv_coord_t count) {
+    lv_color_t black = lv_color_black();
+    for (lv_coord_t y = 0; y < s->height; y++) {
+        lv_color_t *row = &s->pixels[y * s->width];
+        for (lv_coord_t i = x; i < x + count; i++) {
+            row[i] = black;
+        }
+    }
+}
+
+/**
+ * @brief Draw history point index into column x (column already cleared)
+ */
+static void draw_column(sparkline_t *s, lv_coord_t x, uint32_t index) {
+    history_point_t point;
+    if (!metric_history_get(s->metric, s->tier, index, &point) || point.avg == HISTORY_GAP) {
+        return;
+    }
+
+    lv_coord_t top = value_to_row(s, point.max);
+    lv_coord_t bottom = value_to_row(s, point.min);
+    for (lv_coord_t y = top; y <= bottom; y++) {
+        s->pixels[y * s->width + x] = s->range_color;
+    }
+    s->pixels[value_to_row(s, point.avg) * s->width + x] = s->avg_color;
+}
+
+/**
+ * @brief Redraw all columns from the history
+ */
+static void rebuild(sparkline_t *s, uint32_t total) {
+    clear_columns(s, 0, s->width);
+    uint32_t count = total < (uint32_t)s->width ? total : s->width;
+    for (uint32_t i = 0; i < count; i++) {
+        draw_column(s, s->width - count + i, total - count + i);
+    }
+}
+
+/**
+ * @brief Shift the buffer left by count columns and draw the newest points
+ */
+static void scroll(sparkline_t *s, uint32_t total, lv_coord_t count) {
+    lv_coord_t keep = s->width - count;
+    for (lv_coord_t y = 0; y < s->height; y++) {
+        lv_color_t *row = &s->pixels[y * s->width];
+        memmove(row, row + count, keep * sizeof(lv_color_t));
+    }
+    clear_columns(s, keep, count);
+    for (lv_coord_t i = 0; i < count; i++) {
+        draw_column(s, keep + i, total - count + i);
+    }
+}
+
+/**
+ * @brief Instance of a widget object
+ */
+static sparkline_t *find_sparkline(lv_obj_t *obj) {
+    for (int i = 0; i < SPARKLINE_MAX_INSTANCES; i++) {
+        if (obj && sparklines[i].obj == obj) {
+            return &sparklines[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Draw event handler - blits the pixel buffer
+ */
+static void sparkline_event_callback(lv_event_t *e) {
+    sparkline_t *s = (sparkline_t *)lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_area_t area;
+    area.x1 = obj->coords.x1;
+    area.y1 = obj->coords.y1;
+    area.x2 = area.x1 + s->width - 1;
+    area.y2 = area.y1 + s->height - 1;
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    lv_draw_img(draw_ctx, &img_dsc, &area, &s->image);
+}
+
+// ============================================================================
+// SPARKLINE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Create a sparkline widget
+ */
+lv_obj_t *sparkline_create(lv_obj_t *parent, lv_coord_t width, lv_coord_t height,
+                           lv_color_t avg_color, lv_color_t range_color) {
+    sparkline_t *s = NULL;
+    for (int i = 0; i < SPARKLINE_MAX_INSTANCES && !s; i++) {
+        if (!sparklines[i].obj) s = &sparklines[i];
+    }
+    if (!s) {
+        return NULL;
+    }
+
+    uint32_t size = (uint32_t)width * height * sizeof(lv_color_t);
+    lv_color_t *pixels = (lv_color_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!pixels) {
+        pixels = (lv_color_t *)heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    if (!pixels) {
+        Serial.println("Sparkline buffer allocation failed");
+        return NULL;
+    }
+
+    memset(s, 0, sizeof(*s));
+    s->pixels = pixels;
+    s->width = width;
+    s->height = height;
+    s->avg_color = avg_color;
+    s->range_color = range_color;
+    s->value_max = 100;
+    clear_columns(s, 0, width);
+
+    s->image.header.cf = LV_IMG_CF_TRUE_COLOR;
+    s->image.header.w = width;
+    s->image.header.h = height;
+    s->image.data_size = size;
+    s->image.data = (const uint8_t *)pixels;
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, width, height);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(obj, sparkline_event_callback, LV_EVENT_DRAW_MAIN, s);
+
+    s->obj = obj;
+    return obj;
+}
+
+/**
+ * @brief Select the history shown and its value range, and redraw it
+ */
+void sparkline_set_source(lv_obj_t *obj, metric_id_t metric, history_tier_t tier,
+                          int32_t value_min, int32_t value_max) {
+    sparkline_t *s = find_sparkline(obj);
+    if (!s) {
+        return;
+    }
+
+    s->metric = metric;
+    s->tier = tier;
+    s->value_min = value_min;
+    s->value_max = value_max > value_min ? value_max : value_min + 1;
+    s->shown_total = metric_history_total(metric, tier);
+    rebuild(s, s->shown_total);
+    lv_obj_invalidate(obj);
+}
+
+/**
+ * @brief Scroll in the points added to the history since the last call
+ */
+bool sparkline_sync(lv_obj_t *obj) {
+    sparkline_t *s = find_sparkline(obj);
+    if (!s) {
+        return false;
+    }
+
+    uint32_t total = metric_history_total(s->metric, s->tier);
+    uint32_t added = total - s->shown_total;
+    if (added == 0) {
+        return false;
+    }
+
+    if (added >= (uint32_t)s->width) {
+        rebuild(s, total);
+    } else {
+        scroll(s, total, (lv_coord_t)added);
+    }
+    s->shown_total = total;
+
+    // Every column moved, so the whole (small) widget is redrawn
+    lv_obj_invalidate(obj);
+    return true;
+}
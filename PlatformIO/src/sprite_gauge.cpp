@@ -0,0 +1,120 @@
+/**
+ * @file sprite_gauge.cpp
+ * @brief Implementation of the LovyanGFX sprite meter renderer
+ *
+ * LVGL renders every refresh area into a draw buffer of lv_color_t pixels.
+ * A destination sprite is pointed at that buffer with setBuffer() and clipped
+ * to the area LVGL is currently redrawing. The face sprite is pushed with
+ * black as the transparent color (same rule as the chroma-keyed LVGL path),
+ * then the needle sprite is rotated about its inner end with
+ * pushRotateZoomWithAA().
+ *
+ * All sprites use the byte order of lv_color_t so no conversion happens on
+ * the way into the draw buffer.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "sprite_gauge.h"
+#include <LovyanGFX.hpp>
+
+// ============================================================================
+// RENDERER STATE
+// ============================================================================
+
+#if LV_COLOR_16_SWAP
+#define SPRITE_GAUGE_DEPTH lgfx::rgb565_2Byte       ///< Byte-swapped RGB565, as LVGL renders it
+#else
+#define SPRITE_GAUGE_DEPTH lgfx::rgb565_nonswapped  ///< Native RGB565, as LVGL renders it
+#endif
+
+#define SPRITE_GAUGE_TRANSPARENT ((uint32_t)0)      ///< Black pixels are not drawn
+
+/**
+ * @struct sprite_gauge_t
+ * @brief Sprites of one meter
+ */
+struct sprite_gauge_t {
+    const meter_layer_cache_t *owner;  ///< Cache this slot belongs to (NULL = free)
+    LGFX_Sprite face;                  ///< Wraps the cached static layer buffer
+    LGFX_Sprite needle;                ///< Horizontal needle, pivot at its inner end
+};
+
+static sprite_gauge_t sprite_gauges[UI_MAX_METERS];  ///< One slot per meter cache
+static LGFX_Sprite draw_target;                      ///< Wraps LVGL's current draw buffer
+
+// ============================================================================
+// SPRITE GAUGE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Prepare the sprite renderer for a cached meter
+ *
+ * The face sprite shares the cache pixel buffer (no copy). The needle is
+ * drawn once as a horizontal bar pointing right, one transparent pixel row
+ * above and below for anti-aliased rotation.
+ */
+bool sprite_gauge_attach(meter_layer_cache_t *cache, const meter_config_t *config, lv_coord_t needle_length) {
+    if (!cache->buffer || needle_length <= 0) {
+        return false;
+    }
+
+    // Slot already owned by this cache, otherwise the first free one
+    sprite_gauge_t *gauge = NULL;
+    for (int i = 0; i < UI_MAX_METERS && !gauge; i++) {
+        if (sprite_gauges[i].owner == cache) gauge = &sprite_gauges[i];
+    }
+    for (int i = 0; i < UI_MAX_METERS && !gauge; i++) {
+        if (!sprite_gauges[i].owner) gauge = &sprite_gauges[i];
+    }
+    if (!gauge) {
+        return false;
+    }
+    gauge->owner = cache;
+
+    gauge->face.setBuffer(cache->buffer, cache->image.header.w, cache->image.header.h, SPRITE_GAUGE_DEPTH);
+
+    lv_coord_t needle_height = config->needle_width + 2;
+    gauge->needle.deleteSprite();
+    gauge->needle.setColorDepth(SPRITE_GAUGE_DEPTH);
+    gauge->needle.setPsram(false);  // Read for every pixel of every frame
+    if (!gauge->needle.createSprite(needle_length + 1, needle_height)) {
+        return false;
+    }
+    gauge->needle.fillScreen(SPRITE_GAUGE_TRANSPARENT);
+    gauge->needle.fillRect(0, 1, needle_length + 1, config->needle_width,
+                           (uint32_t)(lv_color_to32(config->colors.needle) & 0xFFFFFF));
+    gauge->needle.setPivot(0, (needle_height - 1) / 2.0f);
+
+    cache->sprite = gauge;
+    return true;
+}
+
+/**
+ * @brief Draw face and needle of a sprite-rendered meter
+ */
+void sprite_gauge_draw(const meter_layer_cache_t *cache, lv_draw_ctx_t *draw_ctx,
+                       const lv_point_t *center, int32_t angle) {
+    sprite_gauge_t *gauge = cache->sprite;
+    const lv_area_t *buf_area = draw_ctx->buf_area;
+    const lv_area_t *clip = draw_ctx->clip_area;
+
+    // Point the destination sprite at the buffer LVGL is rendering into
+    draw_target.setBuffer(draw_ctx->buf, lv_area_get_width(buf_area), lv_area_get_height(buf_area),
+                          SPRITE_GAUGE_DEPTH);
+    draw_target.setClipRect(clip->x1 - buf_area->x1, clip->y1 - buf_area->y1,
+                            lv_area_get_width(clip), lv_area_get_height(clip));
+
+    // Dial face: cached static layer at its offset within the meter
+    lv_obj_t *meter = cache->meter;
+    gauge->face.pushSprite(&draw_target,
+                           meter->coords.x1 + cache->offset_x - buf_area->x1,
+                           meter->coords.y1 + cache->offset_y - buf_area->y1,
+                           SPRITE_GAUGE_TRANSPARENT);
+
+    // Needle: rotated about the scale center
+    gauge->needle.pushRotateZoomWithAA(&draw_target,
+                                       center->x - buf_area->x1, center->y - buf_area->y1,
+                                       (float)angle, 1.0f, 1.0f, SPRITE_GAUGE_TRANSPARENT);
+}
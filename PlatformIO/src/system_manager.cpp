@@ -12,8 +12,13 @@
 
 #include "system_manager.h"
 #include "ui_components.h"
+#include "ui_theme.h"
 #include "display_driver.h"
+#include "serial_link.h"
+#include "sample_queue.h"
+#include "time_display.h"
 #include <Arduino.h>
+#include <stdarg.h>
 
 // ============================================================================
 // SYSTEM STATE VARIABLES
@@ -23,17 +28,97 @@
 unsigned long sys_last_data_received_time = 0;   ///< Timestamp of last valid data reception
 bool sys_first_data_received = false;            ///< Flag: true after first valid JSON data
 
-// Meter hiding system state
-unsigned long sys_cpu_temp_zero_start_time = 0;  ///< Timestamp when CPU temp became 0
-unsigned long sys_cpu_load_zero_start_time = 0;  ///< Timestamp when CPU load became 0
-bool sys_cpu_temp_meter_hidden = false;          ///< Flag: true when temp meter is hidden
-bool sys_cpu_load_meter_hidden = false;          ///< Flag: true when load meter is hidden
-int sys_last_cpu_temp = -1;                      ///< Last received CPU temp (-1 = uninitialized)
-int sys_last_cpu_load = -1;                      ///< Last received CPU load (-1 = uninitialized)
-
 // Display power management state
 bool sys_display_blanked = false;                ///< Flag: true when display is blanked
 
+// ============================================================================
+// DEADLINE TABLE
+// ============================================================================
+
+/**
+ * @enum system_deadline_id_t
+ * @brief One-shot timeouts of the system manager
+ * 
+ * Every timeout is an entry with an absolute due time. Events arm, rearm or
+ * cancel entries; system_periodic_update() only looks at them once the
+ * earliest one has expired.
+ */
+typedef enum {
+    SYSTEM_DEADLINE_DATA_TIMEOUT = 0,   ///< Blank the display (armed while data flows)
+    SYSTEM_DEADLINE_METER_HIDE,         ///< Hide a meter (+ metric_id_t, armed while the value is zero)
+    SYSTEM_DEADLINE_COUNT = SYSTEM_DEADLINE_METER_HIDE + METRIC_COUNT
+} system_deadline_id_t;
+
+static_assert((int)SYSTEM_DEADLINE_COUNT <= 32, "deadline mask holds 32 entries");
+
+static uint32_t deadline_due[SYSTEM_DEADLINE_COUNT];  ///< Absolute due time of each entry (millis)
+static uint32_t deadline_armed = 0;                   ///< Bit (1 << system_deadline_id_t) of every armed entry
+static uint32_t deadline_next_due = 0;                ///< Earliest due time of the armed entries
+
+/**
+ * @brief Recompute the earliest due time of the armed entries
+ * 
+ * Due times are compared relative to now, so millis() wrap-around is harmless.
+ */
+static void deadline_update_next() {
+    uint32_t now = millis();
+    int32_t earliest = INT32_MAX;
+    for (int id = 0; id < SYSTEM_DEADLINE_COUNT; id++) {
+        if (deadline_armed & (1u << id)) {
+            int32_t remaining = (int32_t)(deadline_due[id] - now);
+            if (remaining < earliest) {
+                earliest = remaining;
+                deadline_next_due = deadline_due[id];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Arm or rearm a deadline
+ * @param id Entry to arm
+ * @param timeout_ms Time from now until it expires
+ */
+static void deadline_arm(int id, uint32_t timeout_ms) {
+    uint32_t due = millis() + timeout_ms;
+    bool was_next = (deadline_armed & (1u << id)) && deadline_due[id] == deadline_next_due;
+    
+    deadline_due[id] = due;
+    if (!deadline_armed || (int32_t)(due - deadline_next_due) < 0) {
+        deadline_armed |= 1u << id;
+        deadline_next_due = due;
+        return;
+    }
+    deadline_armed |= 1u << id;
+    if (was_next) {
+        deadline_update_next();  // The earliest entry moved later
+    }
+}
+
+/**
+ * @brief Cancel a deadline (no effect if it is not armed)
+ */
+static void deadline_cancel(int id) {
+    if (!(deadline_armed & (1u << id))) {
+        return;
+    }
+    deadline_armed &= ~(1u << id);
+    if (deadline_armed && deadline_due[id] == deadline_next_due) {
+        deadline_update_next();
+    }
+}
+
+/**
+ * @brief Run the action of an expired deadline
+ */
+static void deadline_expired(int id) {
+    if (id == SYSTEM_DEADLINE_DATA_TIMEOUT) {
+        system_blank_entire_display();
+    } else {
+        system_set_meter_hidden((metric_id_t)(id - SYSTEM_DEADLINE_METER_HIDE), true);
+    }
+}
+
 // ============================================================================
 // SYSTEM INITIALIZATION
 // ============================================================================
@@ -50,17 +135,19 @@ void system_manager_init() {
     sys_last_data_received_time = 0;
     sys_first_data_received = false;
     
-    // Reset meter hiding system state
-    sys_cpu_temp_zero_start_time = 0;
-    sys_cpu_load_zero_start_time = 0;
-    sys_cpu_temp_meter_hidden = false;
-    sys_cpu_load_meter_hidden = false;
-    sys_last_cpu_temp = -1;  // -1 indicates uninitialized
-    sys_last_cpu_load = -1;  // -1 indicates uninitialized
+    // Reset meter hiding system state of every metric
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        metric_table.zero_start_time[id] = 0;
+        metric_table.hidden[id] = false;
+        metric_table.last_value[id] = -1;  // -1 indicates uninitialized
+    }
     
     // Reset display power management state
     sys_display_blanked = false;
     
+    // Nothing is armed before the first sample
+    deadline_armed = 0;
+    
     Serial.println("System Manager initialized - ready for data processing");
 }
 
@@ -74,7 +161,7 @@ void system_manager_init() {
  * This is the main entry point for all system data processing. It coordinates
  * all subsystems and ensures proper state management across the entire system.
  */
-void system_process_data(int cpu_temp, int cpu_load) {
+void system_process_data(const int32_t *values, uint32_t present) {
     // Update data reception timestamp for timeout monitoring
     sys_last_data_received_time = millis();
     
@@ -89,7 +176,23 @@ void system_process_data(int cpu_temp, int cpu_load) {
     }
     
     // Update automatic meter hiding system with new values
-    system_update_meter_values(cpu_temp, cpu_load);
+    system_update_meter_values(values, present);
+    
+    // Restart the data timeout
+    deadline_arm(SYSTEM_DEADLINE_DATA_TIMEOUT, DISPLAY_BLANK_TIMEOUT_MS);
+}
+
+/**
+ * @brief Refresh the data timeout for a keep-alive
+ * 
+ * Only extends an active display: before the first sample there are no
+ * values to hold, and a blanked display waits for a full sample.
+ */
+void system_process_keepalive() {
+    if (sys_first_data_received && !sys_display_blanked) {
+        sys_last_data_received_time = millis();
+        deadline_arm(SYSTEM_DEADLINE_DATA_TIMEOUT, DISPLAY_BLANK_TIMEOUT_MS);
+    }
 }
 
 /**
@@ -114,143 +217,60 @@ void system_handle_first_data() {
  * Implements the automatic meter hiding algorithm that automatically hides
  * meters showing zero values for extended periods, improving the user experience
  * by reducing visual clutter when certain metrics are not relevant.
- */
-void system_update_meter_values(int cpu_temp, int cpu_load) {
-    unsigned long current_time = millis();
-    
-    // ========================================================================
-    // CPU TEMPERATURE METER LOGIC
-    // ========================================================================
-    
-    if (cpu_temp == 0) {
-        // Temperature value is zero
-        if (sys_last_cpu_temp != 0) {
-            // Just became zero, start the hiding timer
-            sys_cpu_temp_zero_start_time = current_time;
-            Serial.println("CPU temperature became zero - starting timer");
-        }
-        // Check if it's been zero for more than the timeout period
-        if (current_time - sys_cpu_temp_zero_start_time >= METER_HIDE_TIMEOUT_MS) {
-            system_hide_cpu_temp_meter();
-        }
-    } else {
-        // Temperature value is non-zero
-        if (sys_cpu_temp_meter_hidden) {
-            system_show_cpu_temp_meter();
-        }
-        sys_cpu_temp_zero_start_time = 0; // Reset timer when value becomes non-zero
-    }
-    
-    // ========================================================================
-    // CPU LOAD METER LOGIC
-    // ========================================================================
-    
-    if (cpu_load == 0) {
-        // Load value is zero
-        if (sys_last_cpu_load != 0) {
-            // Just became zero, start the hiding timer
-            sys_cpu_load_zero_start_time = current_time;
-            Serial.println("CPU load became zero - starting timer");
-        }
-        // Check if it's been zero for more than the timeout period
-        if (current_time - sys_cpu_load_zero_start_time >= METER_HIDE_TIMEOUT_MS) {
-            system_hide_cpu_load_meter();
-        }
-    } else {
-        // Load value is non-zero
-        if (sys_cpu_load_meter_hidden) {
-            system_show_cpu_load_meter();
-        }
-        sys_cpu_load_zero_start_time = 0; // Reset timer when value becomes non-zero
-    }
-    
-    // Update last known values for next comparison
-    sys_last_cpu_temp = cpu_temp;
-    sys_last_cpu_load = cpu_load;
-}
-
-/**
- * @brief Check if meters should be hidden due to prolonged zero values
  * 
- * Performs periodic checks of the meter hiding conditions. This function is
- * called regularly from the main loop to ensure timely hiding of meters that
- * have been showing zero values for the configured timeout period.
+ * One pass over the metric table; the same rule applies to every metric.
+ * Metrics missing from a partial update keep their value and timers. A
+ * value becoming zero arms the metric's hide deadline, a non-zero value
+ * cancels it; the deadline table hides the meter when it expires.
  */
-void system_check_meter_hiding_conditions() {
+void system_update_meter_values(const int32_t *values, uint32_t present) {
     unsigned long current_time = millis();
     
-    // Check CPU temperature meter hiding condition
-    if (sys_last_cpu_temp == 0 && sys_cpu_temp_zero_start_time > 0) {
-        if (current_time - sys_cpu_temp_zero_start_time >= METER_HIDE_TIMEOUT_MS) {
-            system_hide_cpu_temp_meter();
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        if (!(present & (1u << id))) {
+            continue;
         }
-    }
-    
-    // Check CPU load meter hiding condition
-    if (sys_last_cpu_load == 0 && sys_cpu_load_zero_start_time > 0) {
-        if (current_time - sys_cpu_load_zero_start_time >= METER_HIDE_TIMEOUT_MS) {
-            system_hide_cpu_load_meter();
+        int32_t value = values[id];
+        
+        if (value == 0) {
+            // Value is zero
+            if (metric_table.last_value[id] != 0) {
+                // Just became zero, start the hiding timer
+                metric_table.zero_start_time[id] = current_time;
+                deadline_arm(SYSTEM_DEADLINE_METER_HIDE + id, METER_HIDE_TIMEOUT_MS);
+                Serial.printf("%s became zero - starting timer\n", metric_descriptors[id].name);
+            }
+        } else {
+            // Value is non-zero
+            if (metric_table.hidden[id]) {
+                system_set_meter_hidden((metric_id_t)id, false);
+            }
+            metric_table.zero_start_time[id] = 0; // Reset timer when value becomes non-zero
+            deadline_cancel(SYSTEM_DEADLINE_METER_HIDE + id);
         }
+        
+        // Update last known value for next comparison
+        metric_table.last_value[id] = value;
     }
 }
 
 /**
- * @brief Hide CPU temperature meter
- * 
- * Coordinates the hiding of the CPU temperature meter by calling the appropriate
- * UI function and updating system state. Provides centralized control over
- * meter visibility with proper logging.
- */
-void system_hide_cpu_temp_meter() {
-    if (!sys_cpu_temp_meter_hidden) {
-        ui_hide_cpu_temp_meter();  // Call UI function to hide the widget
-        sys_cpu_temp_meter_hidden = true;
-        Serial.println("CPU temperature meter hidden (zero for >1 minute)");
-    }
-}
-
-/**
- * @brief Show CPU temperature meter
- * 
- * Coordinates the showing of the CPU temperature meter by calling the appropriate
- * UI function and updating system state. Provides centralized control over
- * meter visibility with proper logging.
- */
-void system_show_cpu_temp_meter() {
-    if (sys_cpu_temp_meter_hidden) {
-        ui_show_cpu_temp_meter();  // Call UI function to show the widget
-        sys_cpu_temp_meter_hidden = false;
-        Serial.println("CPU temperature meter shown (non-zero data received)");
-    }
-}
-
-/**
- * @brief Hide CPU load meter
+ * @brief Hide or show a metric's meter
  * 
- * Coordinates the hiding of the CPU load meter by calling the appropriate
- * UI function and updating system state. Provides centralized control over
- * meter visibility with proper logging.
+ * Coordinates meter visibility by calling the appropriate UI function and
+ * updating system state. Provides centralized control over meter visibility
+ * with proper logging.
  */
-void system_hide_cpu_load_meter() {
-    if (!sys_cpu_load_meter_hidden) {
-        ui_hide_cpu_load_meter();  // Call UI function to hide the widget
-        sys_cpu_load_meter_hidden = true;
-        Serial.println("CPU load meter hidden (zero for >1 minute)");
+void system_set_meter_hidden(metric_id_t metric, bool hidden) {
+    if (metric_table.hidden[metric] == hidden) {
+        return;
     }
-}
-
-/**
- * @brief Show CPU load meter
- * 
- * Coordinates the showing of the CPU load meter by calling the appropriate
- * UI function and updating system state. Provides centralized control over
- * meter visibility with proper logging.
- */
-void system_show_cpu_load_meter() {
-    if (sys_cpu_load_meter_hidden) {
-        ui_show_cpu_load_meter();  // Call UI function to show the widget
-        sys_cpu_load_meter_hidden = false;
-        Serial.println("CPU load meter shown (non-zero data received)");
+    ui_set_meter_hidden(metric, hidden);  // Call UI function to change the widget
+    metric_table.hidden[metric] = hidden;
+    if (hidden) {
+        Serial.printf("%s meter hidden (zero for >1 minute)\n", metric_descriptors[metric].name);
+    } else {
+        Serial.printf("%s meter shown (non-zero data received)\n", metric_descriptors[metric].name);
     }
 }
 
@@ -258,40 +278,23 @@ void system_show_cpu_load_meter() {
 // DISPLAY POWER MANAGEMENT
 // ============================================================================
 
-/**
- * @brief Check for data timeout and blank display if needed
- * 
- * Monitors the time since last data reception and automatically blanks the
- * display after the configured timeout period. This conserves power and
- * provides visual feedback that the system has lost connection to the data source.
- */
-void system_check_data_timeout() {
-    unsigned long current_time = millis();
-    
-    // Only check timeout if we have received data before (avoid blanking during startup)
-    if (sys_first_data_received && sys_last_data_received_time > 0) {
-        unsigned long time_since_last_data = current_time - sys_last_data_received_time;
-        
-        // Check if no data has been received for more than the timeout period
-        if (time_since_last_data >= DISPLAY_BLANK_TIMEOUT_MS) {
-            system_blank_entire_display();
-        }
-    }
-}
-
 /**
  * @brief Blank entire display to save power
  * 
  * Coordinates complete display blanking by calling the appropriate UI function,
- * turning off the backlight, and updating system state. This provides a clear 
+ * turning off the backlight, entering the low-power mode (see
+ * display_enter_low_power()) and updating system state. This provides a clear 
  * indication that the system has lost connection to the data source while 
  * conserving power.
  */
 void system_blank_entire_display() {
     if (!sys_display_blanked) {
         ui_blank_entire_display();  // Call UI function to hide all elements
+        lv_refr_now(NULL);           // Panel keeps a black frame while asleep
         backlight_off();             // Turn off backlight to save power
+        display_enter_low_power();   // Stop tick and rendering, panel sleep, slow CPU
         sys_display_blanked = true;
+        deadline_cancel(SYSTEM_DEADLINE_DATA_TIMEOUT);  // Rearmed by the next sample
         Serial.println("Display blanked - no data received for >1 minute");
     }
 }
@@ -305,7 +308,9 @@ void system_blank_entire_display() {
  */
 void system_show_entire_display() {
     if (sys_display_blanked) {
+        display_exit_low_power();  // Restore CPU clock, panel and tick
         ui_show_entire_display();  // Call UI function to show all elements
+        lv_refr_now(NULL);         // Draw the restored frame before it becomes visible
         backlight_on();             // Turn on backlight to restore visibility
         sys_display_blanked = false;
         Serial.println("Display restored - new data received");
@@ -317,44 +322,128 @@ void system_show_entire_display() {
 // ============================================================================
 
 /**
- * @brief Perform periodic system maintenance tasks
+ * @brief Run the system manager deadlines that have expired
  * 
- * Handles all periodic system management tasks that need to be performed
- * regularly. This function should be called from the main loop to ensure
- * proper system operation.
+ * Called on every render task pass. Until the earliest armed deadline is
+ * due this is a single comparison; the table is only scanned when at least
+ * one entry has expired. Expired entries are disarmed before their actions
+ * run, so an action may arm new deadlines.
  */
 void system_periodic_update() {
-    // Check if meters should be hidden due to prolonged zero values
-    system_check_meter_hiding_conditions();
+    if (!deadline_armed) {
+        return;
+    }
+    uint32_t now = millis();
+    if ((int32_t)(deadline_next_due - now) > 0) {
+        return;
+    }
     
-    // Check if display should be blanked due to data timeout
-    system_check_data_timeout();
+    uint32_t expired = 0;
+    for (int id = 0; id < SYSTEM_DEADLINE_COUNT; id++) {
+        if ((deadline_armed & (1u << id)) && (int32_t)(deadline_due[id] - now) <= 0) {
+            expired |= 1u << id;
+        }
+    }
+    deadline_armed &= ~expired;
+    deadline_update_next();
     
-    // Additional periodic tasks can be added here as the system grows
+    for (int id = 0; id < SYSTEM_DEADLINE_COUNT; id++) {
+        if (expired & (1u << id)) {
+            deadline_expired(id);
+        }
+    }
+}
+
+/**
+ * @brief Time until the next system manager timeout can expire
+ * 
+ * Lets the render task sleep exactly until something can change instead of
+ * polling. The earliest due time is kept up to date by the deadline table,
+ * so this is constant time.
+ * 
+ * @return Milliseconds until the earliest armed deadline, UINT32_MAX if none
+ */
+uint32_t system_ms_until_next_deadline() {
+    if (!deadline_armed) {
+        return UINT32_MAX;
+    }
+    int32_t remaining = (int32_t)(deadline_next_due - millis());
+    return remaining > 0 ? (uint32_t)remaining : 0;
 }
 
 /**
- * @brief Get system status information
+ * @brief Append printf-formatted text to a status buffer
  * 
- * Returns a formatted string containing current system state information
- * for debugging and monitoring purposes. Useful for troubleshooting and
- * system health monitoring.
+ * Keeps the buffer NUL-terminated and stops writing once it is full.
+ * 
+ * @return New length (capped at size - 1)
  */
-String system_get_status() {
-    String status = "System Status:\n";
-    status += "  First data received: " + String(sys_first_data_received ? "Yes" : "No") + "\n";
-    status += "  Display blanked: " + String(sys_display_blanked ? "Yes" : "No") + "\n";
-    status += "  CPU temp meter hidden: " + String(sys_cpu_temp_meter_hidden ? "Yes" : "No") + "\n";
-    status += "  CPU load meter hidden: " + String(sys_cpu_load_meter_hidden ? "Yes" : "No") + "\n";
-    status += "  Last CPU temp: " + String(sys_last_cpu_temp) + "\n";
-    status += "  Last CPU load: " + String(sys_last_cpu_load) + "\n";
+static size_t status_append(char *buffer, size_t size, size_t length, const char *format, ...) {
+    if (length + 1 >= size) {
+        return length;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + length, size - length, format, args);
+    va_end(args);
+    if (written < 0) {
+        return length;
+    }
+    length += (size_t)written;
+    return length < size ? length : size - 1;
+}
+
+/**
+ * @brief Format system status information
+ * 
+ * Writes the current system state for debugging and monitoring purposes
+ * into a caller-provided buffer with snprintf; no heap allocation.
+ */
+size_t system_format_status(char *buffer, size_t size) {
+    size_t n = 0;
+    buffer[0] = '\0';
+    n = status_append(buffer, size, n, "System Status:\n");
+    n = status_append(buffer, size, n, "  First data received: %s\n", sys_first_data_received ? "Yes" : "No");
+    n = status_append(buffer, size, n, "  Display blanked: %s\n", sys_display_blanked ? "Yes" : "No");
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        n = status_append(buffer, size, n, "  %s: last %ld, meter hidden: %s\n", metric_descriptors[id].name,
+                          (long)metric_table.last_value[id], metric_table.hidden[id] ? "Yes" : "No");
+    }
     
     if (sys_last_data_received_time > 0) {
-        unsigned long time_since_data = millis() - sys_last_data_received_time;
-        status += "  Time since last data: " + String(time_since_data) + "ms\n";
+        n = status_append(buffer, size, n, "  Time since last data: %lums\n",
+                          (unsigned long)(millis() - sys_last_data_received_time));
     } else {
-        status += "  Time since last data: Never\n";
+        n = status_append(buffer, size, n, "  Time since last data: Never\n");
     }
     
-    return status;
+    uint32_t next_deadline_ms = system_ms_until_next_deadline();
+    if (next_deadline_ms != UINT32_MAX) {
+        n = status_append(buffer, size, n, "  Next deadline: %lums (%u armed)\n", (unsigned long)next_deadline_ms,
+                          (unsigned)__builtin_popcount(deadline_armed));
+    } else {
+        n = status_append(buffer, size, n, "  Next deadline: None\n");
+    }
+    
+    n = status_append(buffer, size, n, "  Lines received: %lu\n", (unsigned long)serial_link_stats.lines_received);
+    n = status_append(buffer, size, n, "  Overlong lines: %lu\n", (unsigned long)serial_link_stats.lines_overlong);
+    n = status_append(buffer, size, n, "  Garbage lines: %lu\n", (unsigned long)serial_link_stats.lines_garbage);
+    n = status_append(buffer, size, n, "  Frame CRC errors: %lu\n", (unsigned long)serial_link_stats.frames_crc_error);
+    n = status_append(buffer, size, n, "  Invalid frames: %lu\n", (unsigned long)serial_link_stats.frames_invalid);
+    n = status_append(buffer, size, n, "  Commands received: %lu\n", (unsigned long)serial_link_stats.commands_received);
+    n = status_append(buffer, size, n, "  Keep-alives received: %lu\n", (unsigned long)serial_link_stats.keepalives_received);
+    n = status_append(buffer, size, n, "  Sequence: %lu lost, %lu late, %lu restarts\n",
+                      (unsigned long)serial_link_stats.seq_lost, (unsigned long)serial_link_stats.seq_stale,
+                      (unsigned long)serial_link_stats.seq_resyncs);
+    n = status_append(buffer, size, n, "  Queue drops: %lu, coalesced: %lu\n",
+                      (unsigned long)sample_queue_dropped(), (unsigned long)sample_queue_coalesced());
+    n = status_append(buffer, size, n, "  Credit acks sent: %lu\n", (unsigned long)serial_link_stats.acks_sent);
+    n = status_append(buffer, size, n, "  Frames: %lu\n", (unsigned long)display_refresh_stats.frames);
+    n = status_append(buffer, size, n, "  Last frame pixels: %lu\n", (unsigned long)display_refresh_stats.last_frame_px);
+    n = status_append(buffer, size, n, "  Max frame pixels: %lu\n", (unsigned long)display_refresh_stats.max_frame_px);
+    n = status_append(buffer, size, n, "  Needle invalidated pixels: %lu\n", (unsigned long)ui_needle_invalidated_px);
+    n = status_append(buffer, size, n, "  Time invalidated pixels: %lu\n", (unsigned long)time_display_invalidated_px());
+    n = status_append(buffer, size, n, "  Meter style variants: %u\n", (unsigned)ui_theme_meter_style_count());
+    
+    return n;
 }
@@ -0,0 +1,262 @@
+/**
+ * @file time_display.cpp
+ * @brief Implementation of the cached-glyph digital time widget
+ *
+ * Glyph cache:
+ * - Every character of TIME_DISPLAY_GLYPHS is rendered once through a
+ *   temporary label and captured with lv_snapshot as an opaque RGB565 image
+ * - All digits share one cell width (the widest digit), so cell positions
+ *   do not move when digits change; the colon has its own narrower width
+ *
+ * Updates:
+ * - Identical text: nothing happens
+ * - Same cell layout (length and colon positions): only changed cells are
+ *   invalidated, e.g. one digit per second for "HH:MM:SS"
+ * - Different layout: the whole widget is invalidated once
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "time_display.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+// ============================================================================
+// WIDGET STATE
+// ============================================================================
+
+#define GLYPH_COUNT (sizeof(TIME_DISPLAY_GLYPHS) - 1)
+
+/**
+ * @struct time_display_t
+ * @brief Glyph cache and current layout of the time widget
+ */
+typedef struct {
+    lv_obj_t *obj;                                ///< Widget object
+    lv_img_dsc_t glyphs[GLYPH_COUNT];             ///< Cached glyph images
+    uint8_t *glyph_buffers[GLYPH_COUNT];          ///< Pixel storage of the glyph images
+    lv_coord_t digit_width;                       ///< Cell width of digits
+    lv_coord_t colon_width;                       ///< Cell width of the colon
+    lv_coord_t cell_height;                       ///< Height of all cells
+    char text[TIME_DISPLAY_MAX_CHARS + 1];        ///< Text currently shown
+    lv_area_t cells[TIME_DISPLAY_MAX_CHARS];      ///< Cell areas relative to the widget
+    uint8_t cell_count;                           ///< Valid entries in cells[]
+    uint32_t invalidated_px;                      ///< Diagnostics counter
+} time_display_t;
+
+static time_display_t time_display;  ///< The single time display instance
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Index of a character in the glyph cache
+ * @return Glyph index, or -1 if the character is not cached
+ */
+static int glyph_index(char c) {
+    const char *pos = strchr(TIME_DISPLAY_GLYPHS, c);
+    return (c != '\0' && pos) ? (int)(pos - TIME_DISPLAY_GLYPHS) : -1;
+}
+
+/**
+ * @brief Cell width used for a character
+ */
+static lv_coord_t cell_width_for(char c) {
+    return c == ':' ? time_display.colon_width : time_display.digit_width;
+}
+
+/**
+ * @brief Render all glyphs into the cache via a temporary label
+ * @return true if every glyph was captured
+ */
+static bool render_glyph_cache(lv_obj_t *parent, const lv_font_t *font,
+                               lv_color_t text_color, lv_color_t bg_color) {
+    lv_obj_t *label = lv_label_create(parent);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_set_style_text_color(label, text_color, 0);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_bg_color(label, bg_color, 0);
+    lv_obj_set_style_bg_opa(label, LV_OPA_COVER, 0);
+    lv_obj_set_style_pad_all(label, 0, 0);
+
+    bool ok = true;
+    for (size_t i = 0; i < GLYPH_COUNT && ok; i++) {
+        char text[2] = { TIME_DISPLAY_GLYPHS[i], '\0' };
+        lv_label_set_text(label, text);
+        lv_obj_set_size(label, cell_width_for(text[0]), time_display.cell_height);
+        lv_obj_update_layout(label);
+
+        uint32_t size = lv_snapshot_buf_size_needed(label, LV_IMG_CF_TRUE_COLOR);
+        uint8_t *buffer = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_8BIT);
+        ok = buffer &&
+             lv_snapshot_take_to_buf(label, LV_IMG_CF_TRUE_COLOR, &time_display.glyphs[i], buffer, size) == LV_RES_OK;
+        if (!ok) {
+            heap_caps_free(buffer);
+            buffer = NULL;
+        }
+        time_display.glyph_buffers[i] = buffer;
+    }
+
+    lv_obj_del(label);
+    return ok;
+}
+
+/**
+ * @brief Compute cell areas for a text and resize the widget if needed
+ * @param text Text to lay out
+ * @param count Number of characters
+ */
+static void layout_cells(const char *text, uint8_t count) {
+    lv_coord_t total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        total += cell_width_for(text[i]);
+    }
+
+    lv_obj_t *obj = time_display.obj;
+    lv_obj_update_layout(obj);
+    if (total > lv_obj_get_width(obj)) {
+        lv_obj_set_width(obj, total);
+        lv_obj_center(obj);
+        lv_obj_update_layout(obj);
+    }
+
+    lv_coord_t x = (lv_obj_get_width(obj) - total) / 2;
+    lv_coord_t y = (lv_obj_get_height(obj) - time_display.cell_height) / 2;
+    for (uint8_t i = 0; i < count; i++) {
+        lv_coord_t w = cell_width_for(text[i]);
+        time_display.cells[i].x1 = x;
+        time_display.cells[i].y1 = y;
+        time_display.cells[i].x2 = x + w - 1;
+        time_display.cells[i].y2 = y + time_display.cell_height - 1;
+        x += w;
+    }
+    time_display.cell_count = count;
+}
+
+/**
+ * @brief Invalidate one cell area
+ * @param cell Cell area relative to the widget
+ */
+static void invalidate_cell(const lv_area_t *cell) {
+    lv_obj_t *obj = time_display.obj;
+    lv_area_t area = *cell;
+    lv_area_move(&area, obj->coords.x1, obj->coords.y1);
+    lv_obj_invalidate_area(obj, &area);
+    time_display.invalidated_px += lv_area_get_size(&area);
+}
+
+/**
+ * @brief Draw event handler - blits cached glyphs into their cells
+ *
+ * The background is drawn by the base object; cells with characters that
+ * are not cached are left blank.
+ */
+static void time_display_event_callback(lv_event_t *e) {
+    if (lv_event_get_code(e) != LV_EVENT_DRAW_MAIN) {
+        return;
+    }
+
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+
+    for (uint8_t i = 0; i < time_display.cell_count; i++) {
+        int glyph = glyph_index(time_display.text[i]);
+        if (glyph < 0 || !time_display.glyph_buffers[glyph]) {
+            continue;
+        }
+
+        lv_area_t area = time_display.cells[i];
+        lv_area_move(&area, obj->coords.x1, obj->coords.y1);
+
+        lv_area_t visible;
+        if (_lv_area_intersect(&visible, &area, draw_ctx->clip_area)) {
+            lv_draw_img(draw_ctx, &img_dsc, &area, &time_display.glyphs[glyph]);
+        }
+    }
+}
+
+// ============================================================================
+// TIME DISPLAY FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Create the time widget and render its glyph cache
+ */
+lv_obj_t *time_display_create(lv_obj_t *parent, lv_coord_t width, lv_coord_t height,
+                              const lv_font_t *font, lv_color_t text_color, lv_color_t bg_color,
+                              lv_style_t *face_style) {
+    memset(&time_display, 0, sizeof(time_display));
+
+    // Fixed cell sizes: widest digit for all digits, colon on its own
+    for (const char *c = "0123456789"; *c; c++) {
+        lv_coord_t w = lv_font_get_glyph_width(font, *c, '\0');
+        if (w > time_display.digit_width) time_display.digit_width = w;
+    }
+    time_display.colon_width = lv_font_get_glyph_width(font, ':', '\0');
+    time_display.cell_height = lv_font_get_line_height(font);
+
+    if (!render_glyph_cache(parent, font, text_color, bg_color)) {
+        Serial.println("Time display glyph cache allocation failed");
+    }
+
+    // Plain background object; glyphs are drawn by the event callback
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, width, height);
+    lv_obj_center(obj);
+    lv_obj_add_style(obj, face_style, 0);  // Shared, no local style properties
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(obj, time_display_event_callback, LV_EVENT_DRAW_MAIN, NULL);
+
+    time_display.obj = obj;
+    return obj;
+}
+
+/**
+ * @brief Update the displayed text, redrawing only changed cells
+ */
+void time_display_set_text(lv_obj_t *obj, const char *text) {
+    if (obj != time_display.obj || !text) {
+        return;
+    }
+
+    char next[TIME_DISPLAY_MAX_CHARS + 1];
+    strlcpy(next, text, sizeof(next));
+    uint8_t count = (uint8_t)strlen(next);
+
+    if (strcmp(next, time_display.text) == 0) {
+        return;  // Identical text - nothing to redraw
+    }
+
+    // Layout is unchanged if length and colon positions match
+    bool same_layout = count == time_display.cell_count;
+    for (uint8_t i = 0; same_layout && i < count; i++) {
+        same_layout = (next[i] == ':') == (time_display.text[i] == ':');
+    }
+
+    if (same_layout) {
+        for (uint8_t i = 0; i < count; i++) {
+            if (next[i] != time_display.text[i]) {
+                invalidate_cell(&time_display.cells[i]);
+            }
+        }
+    } else {
+        layout_cells(next, count);
+        lv_obj_invalidate(obj);
+        time_display.invalidated_px += lv_area_get_size(&obj->coords);
+    }
+
+    memcpy(time_display.text, next, sizeof(next));
+}
+
+/**
+ * @brief Pixels invalidated by time updates since boot
+ */
+uint32_t time_display_invalidated_px() {
+    return time_display.invalidated_px;
+}
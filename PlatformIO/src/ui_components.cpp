@@ -9,26 +9,35 @@
  * 
  * Key Implementation Features:
  * - Configurable analog meters with LVGL
+ * - Pre-rendered static meter layers so needle animation only redraws the needle
+ * - Optional LovyanGFX sprite renderer per meter (see sprite_gauge.h)
+ * - Trend view with scrolling sparklines of the metric history
  * - Windows-style boot animation with rotating arc
  * - Automatic meter hiding after 1 minute of zero values
  * - Display blanking after 1 minute of no data
  * - Efficient memory and processing management
- * - High-contrast color scheme and styling
+ * - High-contrast color scheme with shared static styles (see ui_theme.h)
  * 
  * @author ESP32-S3 Display Project
  * @date 2025
  */
 
 #include "ui_components.h"
+#include "ui_theme.h"
+#include "time_display.h"
+#include "sprite_gauge.h"
+#include "sparkline.h"
+#include "needle_spring.h"
+#include "display_driver.h"
+#include "ui_fonts.h"
 #include <Arduino.h>
+#include <esp_heap_caps.h>
 
 // ============================================================================
 // GLOBAL UI OBJECT HANDLES
 // ============================================================================
 
-lv_obj_t *cpu_temp_meter;              ///< CPU temperature analog meter widget
-lv_obj_t *cpu_load_meter;              ///< CPU load analog meter widget
-lv_obj_t *time_label;                  ///< Digital time display label
+lv_obj_t *time_label;                  ///< Digital time display (cached-glyph time widget)
 lv_obj_t *center_button;               ///< Central circular button (time background)
 
 // ============================================================================
@@ -44,12 +53,12 @@ lv_anim_t boot_anim;                       ///< Main rotation animation structur
 // NEEDLE ANIMATION SYSTEM VARIABLES
 // ============================================================================
 
-lv_anim_t cpu_temp_needle_anim;            ///< Animation for CPU temperature needle
-lv_anim_t cpu_load_needle_anim;            ///< Animation for CPU load needle
+// Animation slots and current needle positions are kept per metric in
+// metric_table (metric_registry.h)
 
-// Current needle position tracking for smooth animations
-static int32_t cpu_temp_current_value = 30;  ///< Current CPU temperature needle position
-static int32_t cpu_load_current_value = 30;  ///< Current CPU load needle position
+#define NEEDLE_AA_MARGIN 2                   ///< Extra pixels around needle bounds for anti-aliasing
+
+uint32_t ui_needle_invalidated_px = 0;       ///< Total pixels invalidated by needle moves
 
 // Note: System state variables moved to system_manager.cpp for better architecture
 
@@ -59,6 +68,22 @@ static int32_t cpu_load_current_value = 30;  ///< Current CPU load needle positi
 
 static int default_meter_value = 30;        ///< Default meter value for initialization
 
+#if UI_METER_STATIC_CACHE
+static meter_layer_cache_t meter_caches[UI_MAX_METERS];  ///< Static layer cache per meter
+#endif
+
+// ============================================================================
+// VIEW STATE
+// ============================================================================
+
+static ui_view_t ui_view = UI_VIEW_METERS;         ///< Current screen layout
+static history_tier_t trend_tier = HISTORY_TIER_10S; ///< Tier shown by the trend view
+static bool ui_screen_shown = false;               ///< Main UI visible (booted, not blanked)
+static lv_obj_t *trend_panel = NULL;               ///< Container of the trend view
+static lv_obj_t *trend_captions[METRIC_COUNT];     ///< Metric name and tier per sparkline
+static lv_obj_t *trend_charts[METRIC_COUNT];       ///< Sparkline per metric
+static int ui_build_stage = 0;                     ///< Next ui_build_step() stage
+
 // ============================================================================
 // CORE UI FUNCTIONS
 // ============================================================================
@@ -72,34 +97,21 @@ static int default_meter_value = 30;        ///< Default meter value for initial
  */
 void apply_dark_theme() {
   // Set pure black background for the main screen
-  lv_obj_set_style_bg_color(lv_scr_act(), METER_BLACK, LV_PART_MAIN);
+  lv_obj_add_style(lv_scr_act(), &ui_theme.screen, LV_PART_MAIN);
 }
 
 /**
  * @brief Apply visual styling to a meter widget based on configuration
  * 
- * Applies comprehensive styling to an LVGL meter widget using the provided
- * configuration structure. This includes background colors, transparency,
- * borders, and text colors for different meter parts.
+ * Attaches the shared styles of the configuration variant (background,
+ * transparency, border and tick label color, see ui_theme.h) in place of
+ * the variant attached before.
  * 
  * @param meter Pointer to LVGL meter object to style
  * @param config Pointer to meter configuration containing style parameters
  */
 void apply_meter_style(lv_obj_t *meter, const meter_config_t *config) {
-    // Apply background styling
-    lv_obj_set_style_bg_color(meter, config->colors.background, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(meter, LV_OPA_TRANSP, LV_PART_MAIN);  // Transparent background
-    
-    // Apply border styling
-    lv_obj_set_style_border_width(meter, config->border_width, LV_PART_MAIN);
-    
-    // Apply text color for tick labels
-    lv_obj_set_style_text_color(meter, config->colors.tick_labels, LV_PART_TICKS);
-    
-    // Optional: Add border color if border is enabled
-    if (config->border_width > 0) {
-        lv_obj_set_style_border_color(meter, config->colors.minor_ticks, LV_PART_MAIN);
-    }
+    ui_theme_apply_meter(meter, config);
 }
 
 /**
@@ -131,48 +143,46 @@ void create_button_and_label() {
   lv_obj_set_size(center_button, 130, 130);          // Set to 130x130px square
   lv_obj_align(center_button, LV_ALIGN_CENTER, 0, 0); // Center on screen
 
-  // Define custom style for perfectly circular black button
-  static lv_style_t style_black_btn;
-  lv_style_init(&style_black_btn);
-  lv_style_set_bg_color(&style_black_btn, METER_BLACK);    // Pure black background
-  lv_style_set_radius(&style_black_btn, 65);              // 65px radius = perfect circle
-  lv_style_set_shadow_width(&style_black_btn, 0);         // No shadow for clean look
-  lv_style_set_border_width(&style_black_btn, 0);         // No border
-  lv_style_set_outline_width(&style_black_btn, 0);        // No outline
-
-  // Apply the custom style to the button
-  lv_obj_add_style(center_button, &style_black_btn, LV_PART_MAIN);
+  // Apply the shared perfectly circular black button style
+  lv_obj_add_style(center_button, &ui_theme.round_button, LV_PART_MAIN);
 
   // ========================================================================
   // CREATE TIME DISPLAY LABEL
   // ========================================================================
   
-  time_label = lv_label_create(lv_scr_act());         // Create label on main screen
+  // 100x60px area centered over the button: black background, golden amber
+  // 32px digits (closest to desired 20px) drawn from a pre-rendered glyph cache
+  time_label = time_display_create(lv_scr_act(), 100, 60, UI_FONT_TIME,
+                                   METER_GOLDEN_AMBER, METER_BLACK, &ui_theme.time_face);
     
   // Set initial placeholder text
-  lv_label_set_text(time_label, "16:24");
-    
-  // Configure label size and position
-  lv_obj_set_size(time_label, 100, 60);               // 100x60px label area
-  lv_obj_center(time_label);                          // Center on screen (over button)
-    
-  // Configure text alignment within label
-  lv_obj_set_style_text_align(time_label, LV_TEXT_ALIGN_CENTER, 0);
-    
-  // Configure label background (black to match button)
-  lv_obj_set_style_bg_color(time_label, METER_BLACK, 0);
-  lv_obj_set_style_bg_opa(time_label, LV_OPA_COVER, 0);  // Full opacity background
-    
-  // Configure text appearance
-  lv_obj_set_style_text_color(time_label, METER_GOLDEN_AMBER, 0);  // Golden amber text
-  lv_obj_set_style_text_font(time_label, &lv_font_montserrat_32, 0); // 32px font (closest to desired 20px)
-    
-  // Add padding for better text positioning
-  lv_obj_set_style_pad_all(time_label, 5, 0);
+  ui_set_time_text("16:24");
 }
 
+/**
+ * @brief Show a new time text, redrawing only the digits that changed
+ * 
+ * Identical text is ignored, so calling this for every sample is cheap.
+ * 
+ * @param text Time text ("HH:MM" or "HH:MM:SS")
+ */
+void ui_set_time_text(const char *text) {
+  time_display_set_text(time_label, text);
+}
 
-lv_obj_t* create_simple_meter_with_config(const meter_config_t *config) {
+
+// ============================================================================
+// METER CONSTRUCTION
+// ============================================================================
+
+/**
+ * @brief Create a styled meter with an empty scale (no ticks, zones or needle)
+ * 
+ * @param config Pointer to meter configuration structure
+ * @param scale_out Receives the created scale
+ * @return lv_obj_t* Pointer to created meter widget
+ */
+static lv_obj_t* create_meter_base(const meter_config_t *config, lv_meter_scale_t **scale_out) {
     // Create the meter gauge
     lv_obj_t *meter = lv_meter_create(lv_scr_act());
     lv_obj_center(meter);
@@ -185,7 +195,19 @@ lv_obj_t* create_simple_meter_with_config(const meter_config_t *config) {
     lv_meter_scale_t *scale = lv_meter_add_scale(meter);
     lv_meter_set_scale_range(meter, scale, config->scale_min, config->scale_max, 
                             config->scale_angle, config->scale_rotation);
-    
+
+    *scale_out = scale;
+    return meter;
+}
+
+/**
+ * @brief Add the static parts of a meter: ticks, labels and colored zones
+ * 
+ * @param meter Pointer to meter widget
+ * @param scale Scale to attach the elements to
+ * @param config Pointer to meter configuration structure
+ */
+static void add_meter_static_content(lv_obj_t *meter, lv_meter_scale_t *scale, const meter_config_t *config) {
     // Set scale ticks
     lv_meter_set_scale_ticks(meter, scale, config->tick_count, config->tick_width, 
                             config->tick_length, config->colors.minor_ticks);
@@ -220,6 +242,248 @@ lv_obj_t* create_simple_meter_with_config(const meter_config_t *config) {
                                                               false, 0);
     lv_meter_set_indicator_start_value(meter, red_lines, config->red_zone_start);
     lv_meter_set_indicator_end_value(meter, red_lines, config->red_zone_end);
+}
+
+/**
+ * @brief Needle geometry of a meter at a given value
+ * 
+ * Mirrors the geometry lv_meter uses to draw needle lines: scale center,
+ * needle radius and the value-to-angle mapping.
+ * 
+ * @param meter Pointer to meter widget
+ * @param needle Needle line indicator
+ * @param value Scale value the needle points to
+ * @param center Output scale center in screen coordinates
+ * @param angle Output needle angle in degrees
+ * @param r_out Output needle length in pixels
+ */
+static void get_needle_geometry(lv_obj_t *meter, lv_meter_indicator_t *needle, int32_t value,
+                                lv_point_t *center, int32_t *angle, int32_t *r_out) {
+    lv_meter_scale_t *scale = needle->scale;
+
+    lv_area_t scale_area;
+    lv_obj_get_content_coords(meter, &scale_area);
+    lv_coord_t r_edge = lv_area_get_width(&scale_area) / 2;
+    center->x = scale_area.x1 + r_edge;
+    center->y = scale_area.y1 + r_edge;
+
+    *angle = lv_map(value, scale->min, scale->max, scale->rotation, scale->rotation + scale->angle_range);
+    *r_out = r_edge + scale->r_mod + needle->type_data.needle_line.r_mod;
+}
+
+// ============================================================================
+// METER STATIC LAYER CACHE
+// ============================================================================
+
+#if UI_METER_STATIC_CACHE
+
+/**
+ * @brief Find the cache slot of a meter, or a free slot when meter is NULL
+ */
+static meter_layer_cache_t* find_meter_cache(lv_obj_t *meter) {
+    for (int i = 0; i < UI_MAX_METERS; i++) {
+        if (meter_caches[i].meter == meter) {
+            return &meter_caches[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Render the static layer of a meter into its cache buffer
+ * 
+ * Builds a temporary meter containing only the static content, snapshots it
+ * into an RGB565 buffer (PSRAM preferred) and deletes it again. The snapshot
+ * is then cropped to the bounding box of non-black pixels: a half-circle
+ * scale only needs about half of the meter area, and the blit during needle
+ * animation only has to cover what is really drawn.
+ * 
+ * @param cache Cache slot to fill (previous buffer is released)
+ * @param config Pointer to meter configuration structure
+ * @return true on success, false if memory was not available
+ */
+static bool render_meter_cache(meter_layer_cache_t *cache, const meter_config_t *config) {
+    // Build a throw-away meter with the static content only
+    lv_meter_scale_t *scale;
+    lv_obj_t *source = create_meter_base(config, &scale);
+    add_meter_static_content(source, scale, config);
+    lv_obj_update_layout(source);
+
+    uint32_t size = lv_snapshot_buf_size_needed(source, LV_IMG_CF_TRUE_COLOR);
+    uint32_t caps = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+    uint8_t *buffer = (uint8_t *)heap_caps_malloc(size, caps);
+    if (!buffer) {
+        caps = MALLOC_CAP_8BIT;
+        buffer = (uint8_t *)heap_caps_malloc(size, caps);
+    }
+
+    lv_img_dsc_t snapshot;
+    bool ok = buffer &&
+              lv_snapshot_take_to_buf(source, LV_IMG_CF_TRUE_COLOR, &snapshot, buffer, size) == LV_RES_OK;
+
+    // Snapshot area is the object extended by its extra draw size on all sides
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(source);
+    lv_obj_del(source);
+
+    if (!ok) {
+        heap_caps_free(buffer);
+        return false;
+    }
+
+    // Find bounding box of drawn (non-black) pixels
+    lv_coord_t w = snapshot.header.w;
+    lv_coord_t h = snapshot.header.h;
+    const lv_color_t *pixels = (const lv_color_t *)buffer;
+    lv_coord_t min_x = w, min_y = h, max_x = -1, max_y = -1;
+    for (lv_coord_t y = 0; y < h; y++) {
+        for (lv_coord_t x = 0; x < w; x++) {
+            if (pixels[y * w + x].full != 0) {
+                if (x < min_x) min_x = x;
+                if (x > max_x) max_x = x;
+                if (y < min_y) min_y = y;
+                if (y > max_y) max_y = y;
+            }
+        }
+    }
+    if (max_x < 0) {
+        min_x = min_y = max_x = max_y = 0;  // Nothing drawn - keep a single black pixel
+    }
+
+    // Compact the cropped rows to the start of the buffer (in place, moving forward)
+    lv_coord_t crop_w = max_x - min_x + 1;
+    lv_coord_t crop_h = max_y - min_y + 1;
+    lv_color_t *dest = (lv_color_t *)buffer;
+    for (lv_coord_t y = 0; y < crop_h; y++) {
+        memmove(&dest[y * crop_w], &pixels[(y + min_y) * w + min_x], crop_w * sizeof(lv_color_t));
+    }
+    uint32_t crop_size = (uint32_t)crop_w * crop_h * sizeof(lv_color_t);
+    // Same caps as the allocation, so a PSRAM buffer is never moved to SRAM
+    uint8_t *shrunk = (uint8_t *)heap_caps_realloc(buffer, crop_size, caps);
+    if (shrunk) {
+        buffer = shrunk;
+    }
+
+    // Replace the previous layer
+    if (cache->buffer) {
+        heap_caps_free(cache->buffer);
+    }
+    cache->buffer = buffer;
+    cache->config = config;
+    cache->offset_x = min_x - ext;
+    cache->offset_y = min_y - ext;
+    cache->ext_draw_size = ext;
+
+    memset(&cache->image, 0, sizeof(cache->image));
+    cache->image.header.cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;  // Black is transparent
+    cache->image.header.always_zero = 0;
+    cache->image.header.w = crop_w;
+    cache->image.header.h = crop_h;
+    cache->image.data_size = crop_size;
+    cache->image.data = buffer;
+
+    return true;
+}
+
+/**
+ * @brief Meter event handler that draws the cached static layer
+ * 
+ * LV_EVENT_DRAW_MAIN_BEGIN runs before the meter's own DRAW_MAIN handler
+ * draws the needle, so the cached scale always ends up underneath it. With
+ * the sprite renderer attached, face and needle are both composited here and
+ * lv_meter's needle is transparent.
+ * LV_EVENT_REFR_EXT_DRAW_SIZE keeps room for labels outside the meter.
+ */
+static void meter_cache_event_callback(lv_event_t *e) {
+    meter_layer_cache_t *cache = (meter_layer_cache_t *)lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
+        lv_event_set_ext_draw_size(e, cache->ext_draw_size);
+    } else if (code == LV_EVENT_DRAW_MAIN_BEGIN && cache->buffer) {
+        lv_obj_t *meter = lv_event_get_target(e);
+        lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+
+        lv_meter_indicator_t *needle = (lv_meter_indicator_t *)lv_obj_get_user_data(meter);
+        if (cache->sprite && needle) {
+            lv_point_t center;
+            int32_t angle, r_out;
+            get_needle_geometry(meter, needle, needle->end_value, &center, &angle, &r_out);
+            sprite_gauge_draw(cache, draw_ctx, &center, angle);
+            return;
+        }
+
+        lv_area_t area;
+        area.x1 = meter->coords.x1 + cache->offset_x;
+        area.y1 = meter->coords.y1 + cache->offset_y;
+        area.x2 = area.x1 + cache->image.header.w - 1;
+        area.y2 = area.y1 + cache->image.header.h - 1;
+
+        lv_draw_img_dsc_t img_dsc;
+        lv_draw_img_dsc_init(&img_dsc);
+        lv_draw_img(draw_ctx, &img_dsc, &area, &cache->image);
+    }
+}
+
+/**
+ * @brief Attach or detach the sprite renderer according to the cache's config
+ * 
+ * Falls back to the lv_meter needle when the sprites cannot be allocated.
+ * 
+ * @param cache Cache slot of the meter (rendered)
+ * @param needle Needle line indicator of the meter
+ */
+static void update_meter_renderer(meter_layer_cache_t *cache, lv_meter_indicator_t *needle) {
+    bool use_sprite = false;
+    if (cache->config->renderer == METER_RENDERER_SPRITE) {
+        lv_point_t center;
+        int32_t angle, r_out;
+        lv_obj_update_layout(cache->meter);
+        get_needle_geometry(cache->meter, needle, needle->end_value, &center, &angle, &r_out);
+        use_sprite = sprite_gauge_attach(cache, cache->config, r_out);
+        if (!use_sprite) {
+            Serial.println("Sprite gauge allocation failed - using lv_meter needle");
+        }
+    }
+
+    if (!use_sprite) {
+        cache->sprite = NULL;
+    }
+    needle->opa = use_sprite ? LV_OPA_TRANSP : LV_OPA_COVER;  // Transparent needles are skipped by lv_meter
+}
+
+#endif // UI_METER_STATIC_CACHE
+
+/**
+ * @brief Create a complete analog meter widget with specified configuration
+ * 
+ * With UI_METER_STATIC_CACHE enabled the live meter only owns the needle;
+ * scale, ticks, zones and labels are drawn from a layer rendered once at
+ * creation time. If the cache buffer cannot be allocated the meter falls
+ * back to drawing everything through lv_meter. Configurations with
+ * renderer = METER_RENDERER_SPRITE additionally draw through sprite_gauge.
+ * 
+ * @param config Pointer to meter configuration structure
+ * @return lv_obj_t* Pointer to created meter widget
+ */
+lv_obj_t* create_simple_meter_with_config(const meter_config_t *config) {
+    lv_meter_scale_t *scale;
+    lv_obj_t *meter = NULL;
+
+#if UI_METER_STATIC_CACHE
+    meter_layer_cache_t *cache = find_meter_cache(NULL);
+    if (cache && render_meter_cache(cache, config)) {
+        meter = create_meter_base(config, &scale);
+        lv_meter_set_scale_ticks(meter, scale, 0, 0, 0, config->colors.minor_ticks);  // Drawn from cache
+        cache->meter = meter;
+        lv_obj_add_event_cb(meter, meter_cache_event_callback, LV_EVENT_ALL, cache);
+        lv_obj_refresh_ext_draw_size(meter);
+    }
+#endif
+
+    if (!meter) {
+        meter = create_meter_base(config, &scale);
+        add_meter_static_content(meter, scale, config);
+    }
 
     // Add needle line indicator
     lv_meter_indicator_t *needle_indicator = lv_meter_add_needle_line(meter, scale, 
@@ -231,30 +495,194 @@ lv_obj_t* create_simple_meter_with_config(const meter_config_t *config) {
     // Store the needle indicator in the meter's user data for later access
     lv_obj_set_user_data(meter, needle_indicator);
 
+#if UI_METER_STATIC_CACHE
+    if (cache && cache->meter == meter) {
+        update_meter_renderer(cache, needle_indicator);
+    }
+#endif
+
     return meter;
 }
 
-// Initialize all UI components
+/**
+ * @brief Update the scale, needle and cached layer of a meter to a configuration
+ * 
+ * Everything but the styles; without a cache the meter keeps its original
+ * static content.
+ */
+static void update_meter_config(lv_obj_t *meter, const meter_config_t *config) {
+    lv_meter_indicator_t *needle = (lv_meter_indicator_t*)lv_obj_get_user_data(meter);
+    if (needle) {
+        lv_meter_set_scale_range(meter, needle->scale, config->scale_min, config->scale_max,
+                                 config->scale_angle, config->scale_rotation);
+        needle->type_data.needle_line.width = config->needle_width;
+        needle->type_data.needle_line.color = config->colors.needle;
+        needle->type_data.needle_line.r_mod = config->needle_offset;
+    }
+#if UI_METER_STATIC_CACHE
+    meter_layer_cache_t *cache = find_meter_cache(meter);
+    if (cache) {
+        render_meter_cache(cache, config);  // Keeps the old layer on failure
+        lv_obj_refresh_ext_draw_size(meter);
+        if (needle) {
+            update_meter_renderer(cache, needle);  // Face sprite must wrap the new buffer
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Re-render a meter's static layer after its configuration changed
+ * 
+ * Updates the scale geometry and needle appearance of the live meter and
+ * re-renders its cached static layer, followed by a single invalidation.
+ * Without a cache the meter keeps its original static content.
+ * 
+ * @param meter Pointer to meter widget created by create_simple_meter_with_config()
+ * @param config New meter configuration (must stay valid while in use)
+ */
+void ui_meter_set_config(lv_obj_t *meter, const meter_config_t *config) {
+    if (!meter || !config) return;
+
+    apply_meter_style(meter, config);
+    update_meter_config(meter, config);
+    lv_obj_invalidate(meter);
+}
+
+/**
+ * @brief Switch every meter of one configuration to another
+ * 
+ * The meters keep their shared style pair, which ui_theme_set() changes
+ * once for all of them; only the scales and cached layers are updated per
+ * meter. If the pair cannot be changed, or a meter of another configuration
+ * shares it, each meter gets the new pair via ui_meter_set_config().
+ * 
+ * @param from Configuration to replace
+ * @param to New configuration (must stay valid while in use)
+ */
+void ui_meters_set_config(const meter_config_t *from, const meter_config_t *to) {
+    if (!from || !to) return;
+
+    bool shared = false;
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        const meter_config_t *config = metric_table.config[id];
+        if (config != from && metric_table.meter[id] && ui_theme_meter_style_shared(config, from)) {
+            shared = true;
+        }
+    }
+
+    bool restyled = !shared && ui_theme_set(from, to);
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        if (metric_table.config[id] != from) continue;
+        metric_table.config[id] = to;
+        lv_obj_t *meter = metric_table.meter[id];
+        if (!meter) continue;
+        if (restyled) {
+            update_meter_config(meter, to);  // Invalidated by the style change
+        } else {
+            ui_meter_set_config(meter, to);
+        }
+    }
+}
+
+// ============================================================================
+// TREND VIEW
+// ============================================================================
+
+/**
+ * @brief Set or clear the hidden flag of an object (NULL is ignored)
+ */
+static void set_obj_hidden(lv_obj_t *obj, bool hidden) {
+    if (!obj) return;
+    if (hidden) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+/**
+ * @brief Show the widgets of the current view and hide the others
+ */
+static void apply_view() {
+    bool meters = ui_view == UI_VIEW_METERS;
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        set_obj_hidden(metric_table.meter[id], !meters || metric_table.hidden[id]);
+    }
+    set_obj_hidden(center_button, !meters);
+    set_obj_hidden(time_label, !meters);
+    set_obj_hidden(trend_panel, meters);
+
+    if (!meters) {
+        ui_trend_sync();  // Catch up on points added while not shown
+    }
+}
+
+/**
+ * @brief Create the (hidden) trend view: caption and sparkline per metric
+ * 
+ * The rows are stacked in a centered column that fits inside the round
+ * panel. Sources are assigned when the view is selected.
+ */
+static void create_trend_view() {
+    trend_panel = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(trend_panel);
+    lv_obj_set_size(trend_panel, UI_TREND_CHART_WIDTH, LV_SIZE_CONTENT);
+    lv_obj_center(trend_panel);
+    lv_obj_add_style(trend_panel, &ui_theme.trend_column, 0);
+    lv_obj_clear_flag(trend_panel, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_color_t range_color = lv_color_mix(METER_GOLDEN_AMBER, METER_BLACK, LV_OPA_40);
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        trend_captions[id] = lv_label_create(trend_panel);
+        lv_obj_add_style(trend_captions[id], &ui_theme.caption, 0);
+        lv_label_set_text(trend_captions[id], metric_descriptors[id].name);
+
+        trend_charts[id] = sparkline_create(trend_panel, UI_TREND_CHART_WIDTH, UI_TREND_CHART_HEIGHT,
+                                            METER_GOLDEN_AMBER, range_color);
+    }
+
+    lv_obj_add_flag(trend_panel, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Initialize the UI up to the running boot animation
 void ui_init() {
+  ui_theme_init();
   apply_dark_theme();
   
-  // Create main UI components
-  cpu_temp_meter = create_simple_meter_with_config(&cpu_temp_meter_config);
-  cpu_load_meter = create_simple_meter_with_config(&cpu_load_meter_config);
-  create_button_and_label();
-  
-  // Initialize needle animation system
-  init_needle_animations();
-  
-  // Initially hide main UI elements
-  lv_obj_add_flag(cpu_temp_meter, LV_OBJ_FLAG_HIDDEN);
-  lv_obj_add_flag(cpu_load_meter, LV_OBJ_FLAG_HIDDEN);
-  lv_obj_add_flag(center_button, LV_OBJ_FLAG_HIDDEN);
-  lv_obj_add_flag(time_label, LV_OBJ_FLAG_HIDDEN);
-  
-  // Create and show boot animation
+  // Create and show boot animation; the rest is built by ui_build_step()
   create_boot_animation();
   show_boot_animation();
+  ui_build_stage = 0;
+}
+
+/**
+ * @brief Create the next part of the main UI below the boot animation
+ * 
+ * One meter (including its cached layer render) per call, then the button
+ * and time label, then the trend view. Everything is created hidden; the
+ * boot animation stays the top-most object and keeps covering the screen.
+ */
+bool ui_build_step() {
+  int stage = ui_build_stage;
+  if (stage < METRIC_COUNT) {
+    lv_obj_t *meter = create_simple_meter_with_config(metric_table.config[stage]);
+    lv_obj_add_flag(meter, LV_OBJ_FLAG_HIDDEN);
+    metric_table.meter[stage] = meter;
+  } else if (stage == METRIC_COUNT) {
+    create_button_and_label();
+    lv_obj_add_flag(center_button, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(time_label, LV_OBJ_FLAG_HIDDEN);
+  } else if (stage == METRIC_COUNT + 1) {
+    create_trend_view();
+    init_needle_animations();
+    lv_obj_move_foreground(boot_animation_container);
+  } else {
+    return false;
+  }
+
+  ui_build_stage++;
+  return ui_build_stage <= METRIC_COUNT + 1;
 }
 
 
@@ -263,116 +691,141 @@ void ui_init() {
 // ============================================================================
 
 /**
- * @brief Animation callback for smooth needle movement
+ * @brief Compute the screen area covered by a needle line at a given value
  * 
- * This callback function is called by LVGL during animation to update
- * the needle position with interpolated values between start and end.
+ * Bounding box of the needle line from get_needle_geometry() plus half the
+ * line width and an anti-aliasing margin.
  * 
- * @param meter_and_needle Pointer to structure containing meter and needle pointers
- * @param animated_value Current interpolated value during animation
+ * @param meter Pointer to meter widget
+ * @param needle Needle line indicator
+ * @param value Scale value the needle points to
+ * @param area Output bounding box in screen coordinates
  */
-static void needle_animation_callback(void * meter_and_needle, int32_t animated_value) {
-    // Cast the user data back to get meter and needle pointers
-    lv_obj_t *meter = (lv_obj_t*)meter_and_needle;
-    if (meter) {
-        lv_meter_indicator_t *needle = (lv_meter_indicator_t*)lv_obj_get_user_data(meter);
-        if (needle) {
-            lv_meter_set_indicator_value(meter, needle, animated_value);
-        }
+static void get_needle_area(lv_obj_t *meter, lv_meter_indicator_t *needle, int32_t value, lv_area_t *area) {
+    lv_point_t center;
+    int32_t angle, r_out;
+    get_needle_geometry(meter, needle, value, &center, &angle, &r_out);
+
+    lv_point_t end;
+    end.x = (lv_trigo_cos(angle) * r_out) / LV_TRIGO_SIN_MAX + center.x;
+    end.y = (lv_trigo_sin(angle) * r_out) / LV_TRIGO_SIN_MAX + center.y;
+
+    lv_coord_t margin = needle->type_data.needle_line.width / 2 + NEEDLE_AA_MARGIN;
+    area->x1 = LV_MIN(center.x, end.x) - margin;
+    area->y1 = LV_MIN(center.y, end.y) - margin;
+    area->x2 = LV_MAX(center.x, end.x) + margin;
+    area->y2 = LV_MAX(center.y, end.y) + margin;
+}
+
+/**
+ * @brief Move a needle and invalidate only the pixels it sweeps
+ * 
+ * Unlike lv_meter_set_indicator_value(), which may invalidate the whole
+ * 235x235 meter, this invalidates only the old and new needle bounding
+ * boxes. When they overlap enough that their union is no larger than the
+ * two boxes combined, a single merged area is invalidated instead, so the
+ * move produces as few flush areas as possible.
+ * 
+ * @param meter Pointer to meter widget
+ * @param needle Needle line indicator
+ * @param value New scale value
+ */
+static void set_needle_value(lv_obj_t *meter, lv_meter_indicator_t *needle, int32_t value) {
+    if (needle->end_value == value) return;
+
+    lv_area_t old_area, new_area;
+    get_needle_area(meter, needle, needle->end_value, &old_area);
+    get_needle_area(meter, needle, value, &new_area);
+
+    needle->start_value = value;
+    needle->end_value = value;
+
+    lv_area_t joined;
+    _lv_area_join(&joined, &old_area, &new_area);
+    uint32_t separate_px = lv_area_get_size(&old_area) + lv_area_get_size(&new_area);
+    uint32_t joined_px = lv_area_get_size(&joined);
+
+    if (joined_px <= separate_px) {
+        lv_obj_invalidate_area(meter, &joined);
+        ui_needle_invalidated_px += joined_px;
+    } else {
+        lv_obj_invalidate_area(meter, &old_area);
+        lv_obj_invalidate_area(meter, &new_area);
+        ui_needle_invalidated_px += separate_px;
     }
 }
 
 /**
- * @brief Initialize needle animation system
+ * @brief Update meter needle position to display new value (no animation)
  * 
- * Sets up animation structures for both CPU temperature and load meters.
- * This prepares the animation system but doesn't start any animations.
+ * @param meter Pointer to meter widget
+ * @param value New value to display (0-100)
  */
-void init_needle_animations() {
-    // Verify meters exist before setting up animations
-    if (!cpu_temp_meter || !cpu_load_meter) {
-        return;
+void update_simple_meter_needle(lv_obj_t *meter, int32_t value) {
+    if (!meter) return;
+
+    lv_meter_indicator_t *needle = (lv_meter_indicator_t*)lv_obj_get_user_data(meter);
+    if (needle) {
+        set_needle_value(meter, needle, value);
     }
-    
-    // Initialize CPU temperature needle animation
-    lv_anim_init(&cpu_temp_needle_anim);
-    lv_anim_set_var(&cpu_temp_needle_anim, cpu_temp_meter);
-    lv_anim_set_exec_cb(&cpu_temp_needle_anim, needle_animation_callback);
-    lv_anim_set_path_cb(&cpu_temp_needle_anim, lv_anim_path_ease_out);  // Smooth easing
-    
-    // Initialize CPU load needle animation
-    lv_anim_init(&cpu_load_needle_anim);
-    lv_anim_set_var(&cpu_load_needle_anim, cpu_load_meter);
-    lv_anim_set_exec_cb(&cpu_load_needle_anim, needle_animation_callback);
-    lv_anim_set_path_cb(&cpu_load_needle_anim, lv_anim_path_ease_out);  // Smooth easing
 }
 
 /**
- * @brief Animation completion callback to update current value tracking
+ * @brief Select the display refresh rate from the running animations
+ * 
+ * Needle moves and the boot spinner refresh at DISPLAY_REFR_ACTIVE_MS;
+ * with no animation left the display falls back to DISPLAY_REFR_IDLE_MS.
+ */
+static void update_refresh_activity() {
+    display_set_refresh_active(lv_anim_count_running() > 0 || needle_spring_running());
+}
+
+/**
+ * @brief Needle spring callback - moves a needle to its animated value
  * 
- * Called when needle animation completes to update the tracked current value.
- * This ensures the next animation starts from the correct position.
+ * Only the area swept by the needle is invalidated.
  * 
- * @param anim Pointer to the completed animation structure
+ * @param slot Metric whose needle moved
+ * @param value Current animated value
  */
-static void needle_animation_complete_callback(lv_anim_t * anim) {
-    lv_obj_t *meter = (lv_obj_t*)anim->var;
-    
-    // The final value is already updated in our tracking variables
-    // during the update_meter_needle_animated function, so no need
-    // to update again here. This callback is just for cleanup if needed.
+static void needle_spring_apply_callback(uint8_t slot, int32_t value) {
+    update_simple_meter_needle(metric_table.meter[slot], value);
+}
+
+/**
+ * @brief Initialize needle animation system
+ * 
+ * Starts the spring engine and places every needle at its current value.
+ * This prepares the animation system but doesn't start any animations.
+ */
+void init_needle_animations() {
+    needle_spring_init(needle_spring_apply_callback, update_refresh_activity, DISPLAY_REFR_ACTIVE_MS);
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        needle_spring_set((uint8_t)id, metric_table.needle_value[id]);
+    }
 }
 
 /**
  * @brief Update meter needle with smooth animation
  * 
- * Animates the needle from its current position to the new target value
- * over the specified duration. If an animation is already running, it
- * will be stopped and a new one started.
+ * Pulls the needle towards the new target value. A needle that is still
+ * moving continues from its displayed position and speed, so frequent
+ * samples neither restart nor jump the animation.
  * 
- * @param meter Pointer to meter widget
+ * @param metric Metric whose meter is updated
  * @param new_value Target value to animate to (0-100)
- * @param duration Animation duration in milliseconds
+ * @param duration Settling time in milliseconds
  */
-void update_meter_needle_animated(lv_obj_t *meter, int32_t new_value, uint32_t duration) {
-    if (!meter) return;
-    
-    lv_meter_indicator_t *needle = (lv_meter_indicator_t*)lv_obj_get_user_data(meter);
-    if (!needle) return;
-    
-    // Get current needle value as starting point and determine animation structure
-    int32_t current_value = 0;
-    lv_anim_t *anim = NULL;
-    
-    if (meter == cpu_temp_meter) {
-        anim = &cpu_temp_needle_anim;
-        current_value = cpu_temp_current_value;
-        // Update tracking for next animation
-        cpu_temp_current_value = new_value;
-    } else if (meter == cpu_load_meter) {
-        anim = &cpu_load_needle_anim;
-        current_value = cpu_load_current_value;
-        // Update tracking for next animation
-        cpu_load_current_value = new_value;
-    }
+void update_meter_needle_animated(metric_id_t metric, int32_t new_value, uint32_t duration) {
+    if (!metric_table.meter[metric]) return;
     
-    if (!anim) return;
+    // Skip animation if the target hasn't changed
+    if (metric_table.needle_value[metric] == new_value) return;
+    metric_table.needle_value[metric] = new_value;
     
-    // Skip animation if the value hasn't changed
-    if (current_value == new_value) return;
-    
-    // Stop any existing animation for this meter
-    lv_anim_del(meter, needle_animation_callback);
-    
-    // Configure the animation
-    lv_anim_set_var(anim, meter);
-    lv_anim_set_values(anim, current_value, new_value);
-    lv_anim_set_time(anim, duration);
-    lv_anim_set_repeat_count(anim, 1);  // Run once
-    lv_anim_set_ready_cb(anim, needle_animation_complete_callback);  // Update tracking when done
-    
-    // Start the animation
-    lv_anim_start(anim);
+    // Retarget at the active refresh rate
+    needle_spring_retarget((uint8_t)metric, new_value, duration);
+    update_refresh_activity();
 }
 
 // Boot animation callback function for rotation
@@ -389,15 +842,12 @@ void create_boot_animation() {
     lv_obj_set_size(boot_animation_container, LV_HOR_RES, LV_VER_RES);
     lv_obj_center(boot_animation_container);
     
-    // Make container transparent with black background
-    lv_obj_set_style_bg_color(boot_animation_container, METER_BLACK, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(boot_animation_container, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_width(boot_animation_container, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(boot_animation_container, 0, LV_PART_MAIN);
+    // Opaque black container without border or padding
+    lv_obj_add_style(boot_animation_container, &ui_theme.overlay, LV_PART_MAIN);
     
     // Create the spinning arc (similar to Windows boot animation)
     boot_spinner = lv_arc_create(boot_animation_container);
-    lv_obj_set_size(boot_spinner, 130, 130);  // 130x130 size
+    lv_obj_set_size(boot_spinner, DISPLAY_SPLASH_SIZE, DISPLAY_SPLASH_SIZE);  // Same as the splash
     lv_obj_center(boot_spinner);
     
     // Configure arc appearance
@@ -405,24 +855,15 @@ void create_boot_animation() {
     lv_arc_set_value(boot_spinner, 0);
     lv_arc_set_bg_angles(boot_spinner, 0, 360);
     
-    // Style the arc with thick lines
-    lv_obj_set_style_arc_width(boot_spinner, 8, LV_PART_MAIN);  // 8px thick
-    lv_obj_set_style_arc_color(boot_spinner, METER_BLACK, LV_PART_MAIN);
-    
-    lv_obj_set_style_arc_width(boot_spinner, 8, LV_PART_INDICATOR);  // 8px thick
-    lv_obj_set_style_arc_color(boot_spinner, METER_GOLDEN_AMBER, LV_PART_INDICATOR);
+    // Thick black track without background, golden amber segment
+    lv_obj_add_style(boot_spinner, &ui_theme.spinner_track, LV_PART_MAIN);
+    lv_obj_add_style(boot_spinner, &ui_theme.spinner_indicator, LV_PART_INDICATOR);
     
     // Hide the knob (we don't want the draggable handle)
-    lv_obj_set_style_bg_opa(boot_spinner, LV_OPA_TRANSP, LV_PART_KNOB);
-    lv_obj_set_style_border_width(boot_spinner, 0, LV_PART_KNOB);
-    lv_obj_set_style_pad_all(boot_spinner, 0, LV_PART_KNOB);
-    
-    // Remove background
-    lv_obj_set_style_bg_opa(boot_spinner, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(boot_spinner, 0, LV_PART_MAIN);
+    lv_obj_add_style(boot_spinner, &ui_theme.spinner_knob, LV_PART_KNOB);
     
     // Set initial arc to show 120-degree segment
-    lv_arc_set_angles(boot_spinner, 0, 120);
+    lv_arc_set_angles(boot_spinner, 0, DISPLAY_SPLASH_ARC);
     
     // Create the rotation animation for the 120-degree arc
     lv_anim_init(&boot_anim);
@@ -439,20 +880,20 @@ void show_boot_animation() {
     if (boot_animation_container) {
         lv_obj_clear_flag(boot_animation_container, LV_OBJ_FLAG_HIDDEN);
         lv_anim_start(&boot_anim);
+        update_refresh_activity();
     }
 }
 
 // Hide boot animation and show main UI
 void hide_boot_animation() {
     if (boot_animation_container) {
-        lv_anim_del(&boot_anim, NULL);
+        lv_anim_del(boot_spinner, boot_animation_callback);
+        update_refresh_activity();
         lv_obj_add_flag(boot_animation_container, LV_OBJ_FLAG_HIDDEN);
         
-        // Show main UI elements
-        if (cpu_temp_meter) lv_obj_clear_flag(cpu_temp_meter, LV_OBJ_FLAG_HIDDEN);
-        if (cpu_load_meter) lv_obj_clear_flag(cpu_load_meter, LV_OBJ_FLAG_HIDDEN);
-        if (center_button) lv_obj_clear_flag(center_button, LV_OBJ_FLAG_HIDDEN);
-        if (time_label) lv_obj_clear_flag(time_label, LV_OBJ_FLAG_HIDDEN);
+        // Show main UI elements of the current view
+        ui_screen_shown = true;
+        apply_view();
     }
 }
 
@@ -461,51 +902,20 @@ void hide_boot_animation() {
 // ============================================================================
 
 /**
- * @brief Hide CPU temperature meter widget (UI-only operation)
+ * @brief Hide or show a metric's meter widget (UI-only operation)
  * 
  * Pure UI function that only handles the LVGL widget visibility.
- * Called by system manager when system logic determines meter should be hidden.
- */
-void ui_hide_cpu_temp_meter() {
-    if (cpu_temp_meter) {
-        lv_obj_add_flag(cpu_temp_meter, LV_OBJ_FLAG_HIDDEN);
-    }
-}
-
-/**
- * @brief Show CPU temperature meter widget (UI-only operation)
+ * Called by system manager when system logic determines a meter's visibility.
  * 
- * Pure UI function that only handles the LVGL widget visibility.
- * Called by system manager when system logic determines meter should be shown.
+ * @param metric Metric whose meter is changed
+ * @param hidden true to hide, false to show
  */
-void ui_show_cpu_temp_meter() {
-    if (cpu_temp_meter) {
-        lv_obj_clear_flag(cpu_temp_meter, LV_OBJ_FLAG_HIDDEN);
-    }
-}
-
-/**
- * @brief Hide CPU load meter widget (UI-only operation)
- * 
- * Pure UI function that only handles the LVGL widget visibility.
- * Called by system manager when system logic determines meter should be hidden.
- */
-void ui_hide_cpu_load_meter() {
-    if (cpu_load_meter) {
-        lv_obj_add_flag(cpu_load_meter, LV_OBJ_FLAG_HIDDEN);
-    }
-}
-
-/**
- * @brief Show CPU load meter widget (UI-only operation)
- * 
- * Pure UI function that only handles the LVGL widget visibility.
- * Called by system manager when system logic determines meter should be shown.
- */
-void ui_show_cpu_load_meter() {
-    if (cpu_load_meter) {
-        lv_obj_clear_flag(cpu_load_meter, LV_OBJ_FLAG_HIDDEN);
+void ui_set_meter_hidden(metric_id_t metric, bool hidden) {
+    lv_obj_t *meter = metric_table.meter[metric];
+    if (!meter) {
+        return;
     }
+    set_obj_hidden(meter, hidden || ui_view != UI_VIEW_METERS);
 }
 
 // ============================================================================
@@ -520,10 +930,13 @@ void ui_show_cpu_load_meter() {
  */
 void ui_blank_entire_display() {
     // Hide all UI elements
-    if (cpu_temp_meter) lv_obj_add_flag(cpu_temp_meter, LV_OBJ_FLAG_HIDDEN);
-    if (cpu_load_meter) lv_obj_add_flag(cpu_load_meter, LV_OBJ_FLAG_HIDDEN);
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        if (metric_table.meter[id]) lv_obj_add_flag(metric_table.meter[id], LV_OBJ_FLAG_HIDDEN);
+    }
     if (center_button) lv_obj_add_flag(center_button, LV_OBJ_FLAG_HIDDEN);
     if (time_label) lv_obj_add_flag(time_label, LV_OBJ_FLAG_HIDDEN);
+    if (trend_panel) lv_obj_add_flag(trend_panel, LV_OBJ_FLAG_HIDDEN);
+    ui_screen_shown = false;
 }
 
 /**
@@ -531,12 +944,54 @@ void ui_blank_entire_display() {
  * 
  * Pure UI function that only handles LVGL widget visibility.
  * Called by system manager when system logic determines display should be restored.
- * Note: System manager handles individual meter state logic separately.
+ * Meters hidden by the zero-value rule stay hidden.
  */
 void ui_show_entire_display() {
-    // Show all UI elements - system manager will handle individual meter states
-    if (cpu_temp_meter) lv_obj_clear_flag(cpu_temp_meter, LV_OBJ_FLAG_HIDDEN);
-    if (cpu_load_meter) lv_obj_clear_flag(cpu_load_meter, LV_OBJ_FLAG_HIDDEN);
-    if (center_button) lv_obj_clear_flag(center_button, LV_OBJ_FLAG_HIDDEN);
-    if (time_label) lv_obj_clear_flag(time_label, LV_OBJ_FLAG_HIDDEN);
+    // Show the current view; meters hidden by the zero-value rule stay hidden
+    ui_screen_shown = true;
+    apply_view();
+}
+
+// ============================================================================
+// VIEW FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Switch between the meter and trend views
+ * 
+ * Selecting the trend view (again) rebuilds the sparklines from the history
+ * of the requested tier; afterwards they only scroll in new points.
+ * 
+ * @param view View to show
+ * @param tier History tier shown by the trend view
+ */
+void ui_set_view(ui_view_t view, history_tier_t tier) {
+    ui_view = view;
+    trend_tier = tier;
+
+    if (view == UI_VIEW_TREND) {
+        for (int id = 0; id < METRIC_COUNT; id++) {
+            const meter_config_t *config = metric_table.config[id];
+            lv_label_set_text_fmt(trend_captions[id], "%s (%s)", metric_descriptors[id].name,
+                                  metric_history_tier_name(tier));
+            sparkline_set_source(trend_charts[id], (metric_id_t)id, tier,
+                                 config->scale_min, config->scale_max);
+        }
+    }
+
+    if (ui_screen_shown) {
+        apply_view();
+    }
+}
+
+/**
+ * @brief Scroll new history points into the trend view
+ */
+void ui_trend_sync() {
+    if (!ui_screen_shown || ui_view != UI_VIEW_TREND) {
+        return;
+    }
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        sparkline_sync(trend_charts[id]);
+    }
 }
@@ -0,0 +1,268 @@
+/**
+ * @file ui_theme.cpp
+ * @brief Implementation of the shared UI styles
+ *
+ * Local style properties (lv_obj_set_style_*) allocate a style per object
+ * and part from the LVGL heap. The styles here live in static memory and
+ * are only referenced by the objects, so the heap keeps one style list
+ * entry per attached style instead.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "ui_theme.h"
+#include "display_driver.h"
+#include "ui_fonts.h"
+#include <Arduino.h>
+
+// ============================================================================
+// STYLE STATE
+// ============================================================================
+
+/**
+ * @struct meter_style_t
+ * @brief Style pair of one meter configuration variant
+ *
+ * The variant is identified by the configuration fields the styles are
+ * built from, not by the configuration pointer, so equal-looking meters
+ * share one pair.
+ */
+typedef struct {
+    lv_style_t main;          ///< LV_PART_MAIN: transparent background and border
+    lv_style_t ticks;         ///< LV_PART_TICKS: tick label color
+    lv_color_t background;    ///< Variant key: colors.background
+    lv_color_t tick_labels;   ///< Variant key: colors.tick_labels
+    lv_color_t border_color;  ///< Variant key: colors.minor_ticks (only with a border)
+    lv_coord_t border_width;  ///< Variant key: border_width
+} meter_style_t;
+
+ui_theme_t ui_theme;  ///< Fixed styles
+
+static meter_style_t meter_styles[UI_THEME_MAX_METER_STYLES];  ///< Meter style variants
+static uint8_t meter_style_count = 0;                          ///< Variants in use
+static bool theme_ready = false;                               ///< ui_theme_init() done
+
+// ============================================================================
+// FIXED STYLES
+// ============================================================================
+
+/**
+ * @brief Create the fixed styles
+ *
+ * Same properties the widgets previously set locally: pure black
+ * background, golden amber accents, no borders, shadows or padding.
+ */
+void ui_theme_init() {
+    if (theme_ready) {
+        return;
+    }
+
+    lv_style_init(&ui_theme.screen);
+    lv_style_set_bg_color(&ui_theme.screen, METER_BLACK);
+
+    lv_style_init(&ui_theme.overlay);
+    lv_style_set_bg_color(&ui_theme.overlay, METER_BLACK);
+    lv_style_set_bg_opa(&ui_theme.overlay, LV_OPA_COVER);
+    lv_style_set_border_width(&ui_theme.overlay, 0);
+    lv_style_set_pad_all(&ui_theme.overlay, 0);
+
+    lv_style_init(&ui_theme.spinner_track);
+    lv_style_set_arc_width(&ui_theme.spinner_track, DISPLAY_SPLASH_WIDTH);
+    lv_style_set_arc_color(&ui_theme.spinner_track, METER_BLACK);
+    lv_style_set_bg_opa(&ui_theme.spinner_track, LV_OPA_TRANSP);
+    lv_style_set_border_width(&ui_theme.spinner_track, 0);
+
+    lv_style_init(&ui_theme.spinner_indicator);
+    lv_style_set_arc_width(&ui_theme.spinner_indicator, DISPLAY_SPLASH_WIDTH);
+    lv_style_set_arc_color(&ui_theme.spinner_indicator, METER_GOLDEN_AMBER);
+
+    lv_style_init(&ui_theme.spinner_knob);
+    lv_style_set_bg_opa(&ui_theme.spinner_knob, LV_OPA_TRANSP);
+    lv_style_set_border_width(&ui_theme.spinner_knob, 0);
+    lv_style_set_pad_all(&ui_theme.spinner_knob, 0);
+
+    lv_style_init(&ui_theme.round_button);
+    lv_style_set_bg_color(&ui_theme.round_button, METER_BLACK);  // Pure black background
+    lv_style_set_radius(&ui_theme.round_button, 65);             // 65px radius = perfect circle
+    lv_style_set_shadow_width(&ui_theme.round_button, 0);        // No shadow for clean look
+    lv_style_set_border_width(&ui_theme.round_button, 0);        // No border
+    lv_style_set_outline_width(&ui_theme.round_button, 0);       // No outline
+
+    lv_style_init(&ui_theme.time_face);
+    lv_style_set_bg_color(&ui_theme.time_face, METER_BLACK);  // Matches the glyph cache background
+    lv_style_set_bg_opa(&ui_theme.time_face, LV_OPA_COVER);
+
+    lv_style_init(&ui_theme.trend_column);
+    lv_style_set_layout(&ui_theme.trend_column, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&ui_theme.trend_column, LV_FLEX_FLOW_COLUMN);
+    lv_style_set_flex_main_place(&ui_theme.trend_column, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_cross_place(&ui_theme.trend_column, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_track_place(&ui_theme.trend_column, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_pad_row(&ui_theme.trend_column, 4);
+
+    lv_style_init(&ui_theme.caption);
+    lv_style_set_text_font(&ui_theme.caption, UI_FONT_TEXT);
+    lv_style_set_text_color(&ui_theme.caption, METER_GOLDEN_AMBER);
+
+    meter_style_count = 0;
+    theme_ready = true;
+}
+
+// ============================================================================
+// METER STYLES
+// ============================================================================
+
+/**
+ * @brief Whether a style is in the style list of an object
+ */
+static bool obj_has_style(const lv_obj_t *obj, const lv_style_t *style) {
+    for (uint32_t i = 0; i < obj->style_cnt; i++) {
+        if (obj->styles[i].style == style) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Whether a variant matches the styled fields of a configuration
+ */
+static bool meter_style_matches(const meter_style_t *variant, const meter_config_t *config) {
+    if (variant->border_width != config->border_width) return false;
+    if (lv_color_to32(variant->background) != lv_color_to32(config->colors.background)) return false;
+    if (lv_color_to32(variant->tick_labels) != lv_color_to32(config->colors.tick_labels)) return false;
+    return config->border_width == 0 ||
+           lv_color_to32(variant->border_color) == lv_color_to32(config->colors.minor_ticks);
+}
+
+/**
+ * @brief Find the variant of a configuration
+ * @return Variant, or NULL if none matches
+ */
+static meter_style_t *meter_style_find(const meter_config_t *config) {
+    for (uint8_t i = 0; i < meter_style_count; i++) {
+        if (meter_style_matches(&meter_styles[i], config)) {
+            return &meter_styles[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Set the key and style properties of a variant from a configuration
+ *
+ * Setting a property the style already has replaces its value in place.
+ */
+static void meter_style_build(meter_style_t *variant, const meter_config_t *config) {
+    variant->background = config->colors.background;
+    variant->tick_labels = config->colors.tick_labels;
+    variant->border_color = config->colors.minor_ticks;
+    variant->border_width = config->border_width;
+
+    lv_style_set_bg_color(&variant->main, config->colors.background);
+    lv_style_set_bg_opa(&variant->main, LV_OPA_TRANSP);  // Transparent background
+    lv_style_set_border_width(&variant->main, config->border_width);
+    if (config->border_width > 0) {
+        lv_style_set_border_color(&variant->main, config->colors.minor_ticks);
+    } else {
+        lv_style_remove_prop(&variant->main, LV_STYLE_BORDER_COLOR);
+    }
+
+    lv_style_set_text_color(&variant->ticks, config->colors.tick_labels);
+}
+
+/**
+ * @brief Find the variant of a configuration, creating it if needed
+ * @return Variant, or NULL if the pool is full
+ */
+static meter_style_t *meter_style_get(const meter_config_t *config) {
+    meter_style_t *variant = meter_style_find(config);
+    if (variant) {
+        return variant;
+    }
+    if (meter_style_count >= UI_THEME_MAX_METER_STYLES) {
+        return NULL;
+    }
+
+    variant = &meter_styles[meter_style_count++];
+    lv_style_init(&variant->main);
+    lv_style_init(&variant->ticks);
+    meter_style_build(variant, config);
+    return variant;
+}
+
+/**
+ * @brief Attach the style pair of a meter configuration
+ *
+ * lv_obj_remove_style() and lv_obj_add_style() each refresh the object's
+ * style cache; the meter is redrawn once with the next refresh.
+ */
+bool ui_theme_apply_meter(lv_obj_t *meter, const meter_config_t *config) {
+    meter_style_t *variant = meter_style_get(config);
+    if (variant && obj_has_style(meter, &variant->main)) {
+        return true;
+    }
+
+    for (uint8_t i = 0; i < meter_style_count; i++) {
+        if (&meter_styles[i] != variant) {
+            lv_obj_remove_style(meter, &meter_styles[i].main, LV_PART_MAIN);
+            lv_obj_remove_style(meter, &meter_styles[i].ticks, LV_PART_TICKS);
+        }
+    }
+
+    if (!variant) {
+        Serial.println("Meter style pool full - using local style properties");
+        lv_obj_set_style_bg_color(meter, config->colors.background, LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(meter, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_set_style_border_width(meter, config->border_width, LV_PART_MAIN);
+        lv_obj_set_style_text_color(meter, config->colors.tick_labels, LV_PART_TICKS);
+        if (config->border_width > 0) {
+            lv_obj_set_style_border_color(meter, config->colors.minor_ticks, LV_PART_MAIN);
+        }
+        return false;
+    }
+
+    // Drop properties a pool-full fallback may have set; they would win over the styles
+    lv_obj_remove_local_style_prop(meter, LV_STYLE_BG_COLOR, LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(meter, LV_STYLE_BG_OPA, LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(meter, LV_STYLE_BORDER_WIDTH, LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(meter, LV_STYLE_BORDER_COLOR, LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(meter, LV_STYLE_TEXT_COLOR, LV_PART_TICKS);
+
+    lv_obj_add_style(meter, &variant->main, LV_PART_MAIN);
+    lv_obj_add_style(meter, &variant->ticks, LV_PART_TICKS);
+    return true;
+}
+
+bool ui_theme_meter_style_shared(const meter_config_t *a, const meter_config_t *b) {
+    meter_style_t *variant = meter_style_find(a);
+    return variant && meter_style_matches(variant, b);
+}
+
+/**
+ * @brief Restyle every meter of one configuration variant
+ *
+ * Both styles of the pair sit on the same meters, so reporting the change
+ * of one refreshes and invalidates each of them once.
+ */
+bool ui_theme_set(const meter_config_t *from, const meter_config_t *to) {
+    meter_style_t *variant = meter_style_find(from);
+    if (!variant) {
+        return false;
+    }
+    if (variant == meter_style_find(to)) {
+        return true;  // Same look
+    }
+    if (meter_style_find(to)) {
+        return false;  // Would leave two variants with one key
+    }
+
+    meter_style_build(variant, to);
+    lv_obj_report_style_change(&variant->main);
+    return true;
+}
+
+uint8_t ui_theme_meter_style_count() {
+    return meter_style_count;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_latency_trace.cpp
+ * @brief Unit tests of the latency histograms
+ *
+ * Records stage latencies against the simulator's virtual clock and checks
+ * the reported percentiles: exact small values, the bucket resolution
+ * promised in latency_trace.h, percentile ranks and reset.
+ *
+ * Run with: pio test -e native
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "latency_trace.h"
+
+// ============================================================================
+// TEST HELPERS
+// ============================================================================
+
+/**
+ * @brief Record a parse latency of us microseconds
+ */
+static void record(uint32_t us) {
+    latency_trace_record(LATENCY_PARSE, micros() - us);
+}
+
+static latency_summary_t summarize() {
+    latency_summary_t summary;
+    latency_trace_get(LATENCY_PARSE, &summary);
+    return summary;
+}
+
+void setUp() {
+    latency_trace_reset();
+}
+
+void tearDown() {
+}
+
+// ============================================================================
+// HISTOGRAM TESTS
+// ============================================================================
+
+static void test_empty_stage_reports_zero() {
+    latency_summary_t summary = summarize();
+    TEST_ASSERT_EQUAL_UINT32(0, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.p50_us);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.p99_us);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.max_us);
+}
+
+static void test_small_values_are_exact() {
+    for (uint32_t us = 0; us < LATENCY_SUB_BUCKETS; us++) {
+        record(us);
+    }
+    latency_summary_t summary = summarize();
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_SUB_BUCKETS, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_SUB_BUCKETS / 2 - 1, summary.p50_us);
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_SUB_BUCKETS - 1, summary.p99_us);
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_SUB_BUCKETS - 1, summary.max_us);
+}
+
+static void test_single_value_is_reported_exactly() {
+    // The bucket bound is capped at the largest value recorded
+    const uint32_t values[] = { 9, 100, 1000, 4095, 4096, 65537, 1000000 };
+    for (uint32_t value : values) {
+        latency_trace_reset();
+        record(value);
+        TEST_ASSERT_EQUAL_UINT32(value, summarize().p50_us);
+    }
+}
+
+static void test_bucket_resolution() {
+    // 1/8 of a power of two: the bound is never below the value nor 12.5 % above it
+    for (uint32_t value = 1; value < (1u << LATENCY_MAX_OCTAVE); value += value / 7 + 1) {
+        latency_trace_reset();
+        record(value);
+        record(1u << LATENCY_MAX_OCTAVE);
+        uint32_t bound = summarize().p50_us;
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(value, bound);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(value + value / LATENCY_SUB_BUCKETS, bound);
+    }
+}
+
+static void test_percentile_ranks() {
+    for (int i = 0; i < 98; i++) {
+        record(1000);
+    }
+    record(50000);
+    record(50000);
+    latency_summary_t summary = summarize();
+    TEST_ASSERT_EQUAL_UINT32(100, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(1023, summary.p50_us);  // Upper bound of the 1000 us bucket
+    TEST_ASSERT_EQUAL_UINT32(50000, summary.p99_us);
+    TEST_ASSERT_EQUAL_UINT32(50000, summary.max_us);
+
+    // One outlier in a hundred stays out of p99
+    latency_trace_reset();
+    for (int i = 0; i < 99; i++) {
+        record(1000);
+    }
+    record(50000);
+    TEST_ASSERT_EQUAL_UINT32(1023, summarize().p99_us);
+}
+
+static void test_values_beyond_the_last_octave() {
+    record(20000000);
+    latency_summary_t summary = summarize();
+    TEST_ASSERT_EQUAL_UINT32(1, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(20000000, summary.max_us);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32((1u << LATENCY_MAX_OCTAVE) - 1, summary.p50_us);
+}
+
+static void test_reset_clears_every_stage() {
+    record(100);
+    latency_trace_record(LATENCY_APPLY, micros() - 200);
+    latency_trace_reset();
+    TEST_ASSERT_EQUAL_UINT32(0, summarize().count);
+    latency_summary_t apply;
+    latency_trace_get(LATENCY_APPLY, &apply);
+    TEST_ASSERT_EQUAL_UINT32(0, apply.count);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_stage_reports_zero);
+    RUN_TEST(test_small_values_are_exact);
+    RUN_TEST(test_single_value_is_reported_exactly);
+    RUN_TEST(test_bucket_resolution);
+    RUN_TEST(test_percentile_ranks);
+    RUN_TEST(test_values_beyond_the_last_octave);
+    RUN_TEST(test_reset_clears_every_stage);
+    return UNITY_END();
+}
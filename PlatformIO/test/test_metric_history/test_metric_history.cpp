@@ -0,0 +1,157 @@
+/**
+ * @file test_metric_history.cpp
+ * @brief Unit tests of the tiered metric history
+ *
+ * Adds samples on a virtual timeline and checks the stored points: period
+ * summaries, gaps and held values for periods without samples, exact tier
+ * averages, clamping and ring overwrite.
+ *
+ * Run with: pio test -e native
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include <unity.h>
+#include "metric_history.h"
+
+// ============================================================================
+// TEST HELPERS
+// ============================================================================
+
+static const metric_id_t METRIC = (metric_id_t)0;  ///< Metric under test
+
+/**
+ * @brief Add a sample with every metric at the same value
+ */
+static void add_sample(uint32_t now_ms, int32_t value, const int32_t *held) {
+    int32_t values[METRIC_COUNT];
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        values[id] = value;
+    }
+    metric_history_add(now_ms, values, held);
+}
+
+/**
+ * @brief Read a point that must be stored
+ */
+static history_point_t get_point(history_tier_t tier, uint32_t index) {
+    history_point_t point;
+    TEST_ASSERT_TRUE(metric_history_get(METRIC, tier, index, &point));
+    return point;
+}
+
+void setUp() {
+    metric_history_init();
+}
+
+void tearDown() {
+}
+
+// ============================================================================
+// HISTORY TESTS
+// ============================================================================
+
+static void test_point_stored_when_period_ends() {
+    add_sample(100, 10, NULL);
+    add_sample(500, 30, NULL);
+    add_sample(900, 20, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, metric_history_total(METRIC, HISTORY_TIER_1S));
+
+    add_sample(1100, 50, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, metric_history_total(METRIC, HISTORY_TIER_1S));
+    history_point_t point = get_point(HISTORY_TIER_1S, 0);
+    TEST_ASSERT_EQUAL_INT16(10, point.min);
+    TEST_ASSERT_EQUAL_INT16(30, point.max);
+    TEST_ASSERT_EQUAL_INT16(20, point.avg);
+}
+
+static void test_empty_periods_are_gaps() {
+    add_sample(500, 10, NULL);
+    add_sample(3500, 20, NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, metric_history_total(METRIC, HISTORY_TIER_1S));
+    TEST_ASSERT_EQUAL_INT16(10, get_point(HISTORY_TIER_1S, 0).avg);
+    TEST_ASSERT_EQUAL_INT16(HISTORY_GAP, get_point(HISTORY_TIER_1S, 1).avg);
+    TEST_ASSERT_EQUAL_INT16(HISTORY_GAP, get_point(HISTORY_TIER_1S, 2).avg);
+}
+
+static void test_empty_periods_repeat_held_values() {
+    int32_t held[METRIC_COUNT];
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        held[id] = 42;
+    }
+    add_sample(500, 10, NULL);
+    add_sample(3500, 20, held);
+    TEST_ASSERT_EQUAL_UINT32(3, metric_history_total(METRIC, HISTORY_TIER_1S));
+    for (uint32_t index = 1; index < 3; index++) {
+        history_point_t point = get_point(HISTORY_TIER_1S, index);
+        TEST_ASSERT_EQUAL_INT16(42, point.min);
+        TEST_ASSERT_EQUAL_INT16(42, point.max);
+        TEST_ASSERT_EQUAL_INT16(42, point.avg);
+    }
+}
+
+static void test_tier_average_is_exact() {
+    // Unequal sample counts per second: an average of averages would be 19
+    add_sample(0, 0, NULL);
+    for (uint32_t ms = 1000; ms < 10000; ms += 100) {
+        add_sample(ms, 22, NULL);
+    }
+    add_sample(10000, 0, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, metric_history_total(METRIC, HISTORY_TIER_10S));
+    history_point_t point = get_point(HISTORY_TIER_10S, 0);
+    TEST_ASSERT_EQUAL_INT16(0, point.min);
+    TEST_ASSERT_EQUAL_INT16(22, point.max);
+    TEST_ASSERT_EQUAL_INT16(21, point.avg);  // 90 * 22 / 91
+}
+
+static void test_large_sums_do_not_overflow() {
+    // A minute of samples at 10 ms: the sum wraps negative in 32 bits
+    for (uint32_t ms = 0; ms < 60000; ms += 10) {
+        add_sample(ms, 400000, NULL);
+    }
+    add_sample(60000, 0, NULL);
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, get_point(HISTORY_TIER_1M, 0).avg);
+}
+
+static void test_values_are_clamped() {
+    add_sample(0, 100000, NULL);
+    add_sample(1000, -100000, NULL);
+    add_sample(2000, 0, NULL);
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, get_point(HISTORY_TIER_1S, 0).avg);
+    TEST_ASSERT_EQUAL_INT16(HISTORY_GAP + 1, get_point(HISTORY_TIER_1S, 1).avg);
+}
+
+static void test_ring_keeps_the_newest_points() {
+    for (uint32_t second = 0; second <= HISTORY_CAPACITY + 10; second++) {
+        add_sample(second * 1000, (int32_t)second, NULL);
+    }
+    uint32_t total = metric_history_total(METRIC, HISTORY_TIER_1S);
+    TEST_ASSERT_EQUAL_UINT32(HISTORY_CAPACITY + 10, total);
+
+    history_point_t point;
+    TEST_ASSERT_FALSE(metric_history_get(METRIC, HISTORY_TIER_1S, 9, &point));
+    TEST_ASSERT_FALSE(metric_history_get(METRIC, HISTORY_TIER_1S, total, &point));
+    TEST_ASSERT_EQUAL_INT16(10, get_point(HISTORY_TIER_1S, 10).avg);
+    TEST_ASSERT_EQUAL_INT16((int16_t)(total - 1), get_point(HISTORY_TIER_1S, total - 1).avg);
+}
+
+static void test_tier_keys() {
+    TEST_ASSERT_EQUAL_INT(HISTORY_TIER_1S, metric_history_find_tier("1s"));
+    TEST_ASSERT_EQUAL_INT(HISTORY_TIER_10S, metric_history_find_tier("10s"));
+    TEST_ASSERT_EQUAL_INT(HISTORY_TIER_1M, metric_history_find_tier("1m"));
+    TEST_ASSERT_EQUAL_INT(-1, metric_history_find_tier("1h"));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_point_stored_when_period_ends);
+    RUN_TEST(test_empty_periods_are_gaps);
+    RUN_TEST(test_empty_periods_repeat_held_values);
+    RUN_TEST(test_tier_average_is_exact);
+    RUN_TEST(test_large_sums_do_not_overflow);
+    RUN_TEST(test_values_are_clamped);
+    RUN_TEST(test_ring_keeps_the_newest_points);
+    RUN_TEST(test_tier_keys);
+    return UNITY_END();
+}
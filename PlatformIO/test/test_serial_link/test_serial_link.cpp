@@ -0,0 +1,237 @@
+/**
+ * @file test_serial_link.cpp
+ * @brief Unit tests of the serial link sequence and ack handling
+ *
+ * Feeds host lines through the simulator's Serial shim and checks which
+ * updates serial_link_poll() hands on and how the sequence counters move:
+ * in-order updates, counter wrap, late and repeated updates, gaps, host
+ * restarts and credit acks.
+ *
+ * Run with: pio test -e native
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "serial_link.h"
+
+// ============================================================================
+// TEST HELPERS
+// ============================================================================
+
+static uint32_t delivered = 0;      ///< Samples handed to the handler
+static uint32_t delivered_seq = 0;  ///< Sequence number of the last one
+
+static void count_sample(const sensor_sample_t *sample) {
+    delivered++;
+    delivered_seq = sample->seq;
+}
+
+/**
+ * @brief Send one sequenced update and poll the link
+ * @return true if the update was handed on
+ */
+static bool send_update(uint32_t seq) {
+    char line[64];
+    int length = snprintf(line, sizeof(line), "{\"seq\":%lu,\"cpu_load\":47}\n", (unsigned long)seq);
+    uint32_t before = delivered;
+    Serial.feed(line, (size_t)length);
+    serial_link_poll(count_sample);
+    return delivered == before + 1;
+}
+
+/**
+ * @brief Send updates first..last in order
+ */
+static void send_updates(uint32_t first, uint32_t last) {
+    for (uint32_t seq = first; seq != last + 1; seq++) {
+        send_update(seq);
+    }
+}
+
+void setUp() {
+    Serial.set_quiet(true);  // "resync:" lines
+    serial_link_init();
+    delivered = 0;
+    delivered_seq = 0;
+}
+
+void tearDown() {
+    Serial.set_quiet(false);
+}
+
+// ============================================================================
+// SEQUENCE TESTS
+// ============================================================================
+
+static void test_in_order_updates_are_accepted() {
+    send_updates(1, 10);
+    TEST_ASSERT_EQUAL_UINT32(10, delivered);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_lost);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_stale);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_resyncs);
+}
+
+static void test_counter_wraps_without_loss() {
+    send_updates(0xFFFFFFFDu, 0xFFFFFFFFu);
+    TEST_ASSERT_TRUE(send_update(0));
+    TEST_ASSERT_TRUE(send_update(1));
+    TEST_ASSERT_EQUAL_UINT32(5, delivered);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_lost);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_stale);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_resyncs);
+}
+
+static void test_repeated_update_is_dropped() {
+    send_updates(1, 5);
+    TEST_ASSERT_FALSE(send_update(5));
+    TEST_ASSERT_EQUAL_UINT32(1, serial_link_stats.seq_stale);
+    TEST_ASSERT_TRUE(send_update(6));
+}
+
+static void test_stale_window_edges() {
+    send_updates(1, 100);
+
+    // Up to SERIAL_SEQ_STALE_WINDOW - 1 behind: late, dropped
+    TEST_ASSERT_FALSE(send_update(100 - (SERIAL_SEQ_STALE_WINDOW - 1)));
+    TEST_ASSERT_EQUAL_UINT32(1, serial_link_stats.seq_stale);
+
+    // SERIAL_SEQ_STALE_WINDOW behind: a host restart, accepted
+    TEST_ASSERT_TRUE(send_update(100 - SERIAL_SEQ_STALE_WINDOW));
+    TEST_ASSERT_EQUAL_UINT32(1, serial_link_stats.seq_resyncs);
+    TEST_ASSERT_TRUE(send_update(100 - SERIAL_SEQ_STALE_WINDOW + 1));
+}
+
+static void test_stale_window_across_wrap() {
+    send_updates(0xFFFFFFFEu, 0xFFFFFFFFu);
+    send_updates(0, 2);
+    TEST_ASSERT_FALSE(send_update(0xFFFFFFFFu));
+    TEST_ASSERT_EQUAL_UINT32(1, serial_link_stats.seq_stale);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_resyncs);
+}
+
+static void test_gap_counts_lost_updates() {
+    send_updates(1, 3);
+    TEST_ASSERT_TRUE(send_update(7));
+    TEST_ASSERT_EQUAL_UINT32(3, serial_link_stats.seq_lost);
+    TEST_ASSERT_EQUAL_UINT32(7, delivered_seq);
+}
+
+static void test_restarted_host_is_resynced() {
+    // The old host got not far enough for the restart to leave the window
+    send_updates(1, 20);
+
+    // The new host announces itself with "link" before its first update
+    serial_link_reset_sequence();
+    TEST_ASSERT_EQUAL_UINT32(1, serial_link_stats.seq_resyncs);
+    TEST_ASSERT_TRUE(send_update(1));
+    TEST_ASSERT_TRUE(send_update(2));
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_stale);
+    TEST_ASSERT_EQUAL_UINT32(0, serial_link_stats.seq_lost);
+}
+
+static void test_restart_without_link_looks_late() {
+    // Why a host must send "link": its first updates sit inside the window
+    send_updates(1, 20);
+    TEST_ASSERT_FALSE(send_update(1));
+    TEST_ASSERT_EQUAL_UINT32(1, serial_link_stats.seq_stale);
+}
+
+static void test_unsequenced_lines_bypass_the_sequence() {
+    send_updates(1, 5);
+    const char line[] = "{\"cpu_load\":12}\n";
+    Serial.feed(line, sizeof(line) - 1);
+    serial_link_poll(count_sample);
+    TEST_ASSERT_EQUAL_UINT32(6, delivered);
+    TEST_ASSERT_TRUE(send_update(6));
+}
+
+// ============================================================================
+// ACK TESTS
+// ============================================================================
+
+static void test_no_acks_unless_streaming() {
+    uint32_t seq;
+    send_updates(1, 2 * SERIAL_ACK_INTERVAL);
+    TEST_ASSERT_FALSE(serial_link_ack_due(&seq));
+}
+
+static void test_first_ack_is_due_at_once() {
+    uint32_t seq = 1234;
+    serial_link_set_acks(true);
+    TEST_ASSERT_TRUE(serial_link_ack_due(&seq));
+    TEST_ASSERT_EQUAL_UINT32(0, seq);
+    TEST_ASSERT_FALSE(serial_link_ack_due(&seq));
+}
+
+static void test_ack_every_interval() {
+    uint32_t seq;
+    serial_link_set_acks(true);
+    serial_link_ack_due(&seq);
+
+    send_updates(1, SERIAL_ACK_INTERVAL);
+    TEST_ASSERT_TRUE(serial_link_ack_due(&seq));
+    TEST_ASSERT_EQUAL_UINT32(SERIAL_ACK_INTERVAL, seq);
+
+    send_updates(SERIAL_ACK_INTERVAL + 1, 2 * SERIAL_ACK_INTERVAL - 1);
+    TEST_ASSERT_FALSE(serial_link_ack_due(&seq));
+    send_update(2 * SERIAL_ACK_INTERVAL);
+    TEST_ASSERT_TRUE(serial_link_ack_due(&seq));
+    TEST_ASSERT_EQUAL_UINT32(2 * SERIAL_ACK_INTERVAL, seq);
+}
+
+static void test_ack_after_host_restart() {
+    uint32_t seq;
+    serial_link_set_acks(true);
+    serial_link_ack_due(&seq);
+    send_updates(1, 20);
+    serial_link_ack_due(&seq);
+
+    // The new host sends "link", then "stream" for its first ack
+    serial_link_reset_sequence();
+    TEST_ASSERT_FALSE(serial_link_ack_due(&seq));
+    serial_link_set_acks(true);
+    TEST_ASSERT_TRUE(serial_link_ack_due(&seq));
+
+    // Acks follow its own count, not the one of the old host
+    send_updates(1, SERIAL_ACK_INTERVAL - 1);
+    TEST_ASSERT_FALSE(serial_link_ack_due(&seq));
+    send_update(SERIAL_ACK_INTERVAL);
+    TEST_ASSERT_TRUE(serial_link_ack_due(&seq));
+    TEST_ASSERT_EQUAL_UINT32(SERIAL_ACK_INTERVAL, seq);
+}
+
+static void test_acks_wrap_with_the_counter() {
+    const uint32_t start = 0xFFFFFFFEu;
+    uint32_t seq;
+    serial_link_set_acks(true);
+    send_update(start);
+    serial_link_ack_due(&seq);
+
+    send_updates(start + 1, start + SERIAL_ACK_INTERVAL - 1);
+    TEST_ASSERT_FALSE(serial_link_ack_due(&seq));
+    send_update(start + SERIAL_ACK_INTERVAL);
+    TEST_ASSERT_TRUE(serial_link_ack_due(&seq));
+    TEST_ASSERT_EQUAL_UINT32(start + SERIAL_ACK_INTERVAL, seq);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_in_order_updates_are_accepted);
+    RUN_TEST(test_counter_wraps_without_loss);
+    RUN_TEST(test_repeated_update_is_dropped);
+    RUN_TEST(test_stale_window_edges);
+    RUN_TEST(test_stale_window_across_wrap);
+    RUN_TEST(test_gap_counts_lost_updates);
+    RUN_TEST(test_restarted_host_is_resynced);
+    RUN_TEST(test_restart_without_link_looks_late);
+    RUN_TEST(test_unsequenced_lines_bypass_the_sequence);
+    RUN_TEST(test_no_acks_unless_streaming);
+    RUN_TEST(test_first_ack_is_due_at_once);
+    RUN_TEST(test_ack_every_interval);
+    RUN_TEST(test_ack_after_host_restart);
+    RUN_TEST(test_acks_wrap_with_the_counter);
+    return UNITY_END();
+}
@@ -0,0 +1,56 @@
+/**
+ * @file cpu_stat.h
+ * @brief CPU load from /proc/stat
+ *
+ * The file stays open; every reading is one pread() at offset 0 into a
+ * fixed buffer, and the load is the busy share of the jiffies elapsed
+ * since the previous reading. No memory is allocated.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef CPU_STAT_H
+#define CPU_STAT_H
+
+#include <stdint.h>
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @struct cpu_stat_t
+ * @brief Open /proc/stat and the counters of the previous reading
+ */
+typedef struct {
+    int fd;               ///< /proc/stat descriptor (-1 = closed)
+    uint64_t last_busy;   ///< Busy jiffies at the previous reading
+    uint64_t last_total;  ///< All jiffies at the previous reading
+} cpu_stat_t;
+
+// ============================================================================
+// CPU STAT FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Open /proc/stat and take the first reading
+ * @param stat State to initialize
+ * @return true on success
+ */
+bool cpu_stat_open(cpu_stat_t *stat);
+
+/**
+ * @brief CPU load since the previous call
+ * @param stat Open state
+ * @return Load in percent (0-100), or -1 if /proc/stat could not be read
+ */
+int cpu_stat_read_load(cpu_stat_t *stat);
+
+/**
+ * @brief Close /proc/stat
+ * @param stat Open state
+ */
+void cpu_stat_close(cpu_stat_t *stat);
+
+#endif // CPU_STAT_H
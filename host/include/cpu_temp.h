@@ -0,0 +1,64 @@
+/**
+ * @file cpu_temp.h
+ * @brief CPU temperature from a hwmon temp*_input file
+ *
+ * The sensor is chosen once at startup (or given explicitly) and kept
+ * open; every reading is one pread() at offset 0.
+ *
+ * Autodetection prefers the CPU package sensor of the first known driver
+ * (coretemp, k10temp, zenpower, cpu_thermal, acpitz), using the labelled
+ * package/die input when there is one and temp1_input otherwise.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef CPU_TEMP_H
+#define CPU_TEMP_H
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define CPU_TEMP_PATH_SIZE 128  ///< Longest sensor path
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @struct cpu_temp_t
+ * @brief Open temperature sensor
+ */
+typedef struct {
+    int fd;                         ///< temp*_input descriptor (-1 = closed)
+    char path[CPU_TEMP_PATH_SIZE];  ///< Sensor path, for logging
+} cpu_temp_t;
+
+// ============================================================================
+// CPU TEMPERATURE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Open a temperature sensor
+ * @param temp State to initialize
+ * @param path temp*_input file, or NULL to autodetect the CPU sensor
+ * @return true on success
+ */
+bool cpu_temp_open(cpu_temp_t *temp, const char *path);
+
+/**
+ * @brief Read the temperature
+ * @param temp Open sensor
+ * @param celsius Receives the temperature rounded to whole °C
+ * @return true on success
+ */
+bool cpu_temp_read(const cpu_temp_t *temp, int *celsius);
+
+/**
+ * @brief Close the sensor
+ * @param temp Open sensor
+ */
+void cpu_temp_close(cpu_temp_t *temp);
+
+#endif // CPU_TEMP_H
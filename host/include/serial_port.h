@@ -0,0 +1,107 @@
+/**
+ * @file serial_port.h
+ * @brief Non-blocking raw serial link to the display's USB CDC port
+ *
+ * The port is opened raw at 115200 baud without flow control. Writes never
+ * block for long: if the display stops reading, samples are dropped instead
+ * of stalling the daemon, and the caller is told so. A hard error (the device was unplugged or
+ * re-enumerated) closes the port so the caller can reopen it.
+ *
+ * HUPCL is cleared so closing the port does not drop DTR, which the
+ * ESP32-S3 USB-Serial-JTAG may otherwise take as a reset request.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#ifndef SERIAL_PORT_H
+#define SERIAL_PORT_H
+
+#include <stddef.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define SERIAL_PORT_LINE_SIZE  128   ///< Longest display line passed to the line handler
+#define SERIAL_PORT_MAX_QUEUED 1024  ///< Unsent bytes above which messages are dropped
+#define SERIAL_PORT_WRITE_WAIT_MS 20 ///< Longest wait for room to finish a started message
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * @struct serial_port_t
+ * @brief Open serial port and its input line assembler
+ */
+typedef struct {
+    int fd;                            ///< Device descriptor (-1 = closed)
+    char line[SERIAL_PORT_LINE_SIZE];  ///< Display line under assembly
+    size_t line_length;                ///< Bytes in line (longer lines are cut)
+    bool line_broken;                  ///< A message was cut short; the next write ends it first
+} serial_port_t;
+
+/**
+ * @brief Outcome of serial_port_write()
+ */
+typedef enum {
+    SERIAL_WRITE_SENT = 0,  ///< The whole message is queued for the display
+    SERIAL_WRITE_DROPPED,   ///< Not sent (back-pressure or a full buffer); retry later
+    SERIAL_WRITE_GONE,      ///< The device is gone (the port is closed)
+} serial_write_result_t;
+
+/**
+ * @brief Callback for every complete line received from the display
+ * @param line NUL-terminated line without the line ending
+ */
+typedef void (*serial_line_handler_t)(const char *line);
+
+// ============================================================================
+// SERIAL PORT FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Open and configure the device
+ * @param port Port state
+ * @param device Device path, e.g. /dev/ttyACM0 or a /dev/serial/by-id link
+ * @return true on success
+ */
+bool serial_port_open(serial_port_t *port, const char *device);
+
+/**
+ * @brief Check whether the port is open
+ */
+bool serial_port_is_open(const serial_port_t *port);
+
+/**
+ * @brief Write one complete message
+ * @param port Open port
+ * @param data Bytes to send
+ * @param length Number of bytes
+ * @return SERIAL_WRITE_SENT only if every byte was queued
+ *
+ * While more than SERIAL_PORT_MAX_QUEUED bytes wait in the kernel buffer
+ * (the display is not reading), the message is dropped before any of it
+ * is sent. A message the kernel takes only in part is completed as room
+ * frees up within SERIAL_PORT_WRITE_WAIT_MS; if that fails it counts as
+ * dropped, and the next write starts with a newline so the display
+ * discards the fragment as one broken line.
+ */
+serial_write_result_t serial_port_write(serial_port_t *port, const void *data, size_t length);
+
+/**
+ * @brief Read pending input from the display
+ * @param port Open port
+ * @param echo_fd Descriptor that receives the raw input, or -1
+ * @param handler Receives every complete text line, or NULL
+ * @return false if the device is gone (the port is closed)
+ */
+bool serial_port_drain(serial_port_t *port, int echo_fd, serial_line_handler_t handler);
+
+/**
+ * @brief Close the port
+ */
+void serial_port_close(serial_port_t *port);
+
+#endif // SERIAL_PORT_H
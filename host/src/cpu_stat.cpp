@@ -0,0 +1,107 @@
+/**
+ * @file cpu_stat.cpp
+ * @brief Implementation of the /proc/stat CPU load reader
+ *
+ * Only the aggregate "cpu" line is parsed: user, nice, system, idle,
+ * iowait, irq, softirq and steal. Idle time is idle + iowait; guest time
+ * is already included in user and nice.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "cpu_stat.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+#define CPU_STAT_FIELDS 8  ///< Fields of the cpu line that are summed
+
+/**
+ * @brief Read the aggregate busy and total jiffies
+ * @return true if the cpu line was parsed
+ */
+static bool read_jiffies(int fd, uint64_t *busy, uint64_t *total) {
+    char buffer[256];  // The aggregate line comes first and is far shorter
+    ssize_t length = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 4) {
+        return false;
+    }
+    buffer[length] = '\0';
+    if (strncmp(buffer, "cpu ", 4) != 0) {
+        return false;
+    }
+
+    uint64_t fields[CPU_STAT_FIELDS] = {0};
+    const char *p = buffer + 4;
+    for (int i = 0; i < CPU_STAT_FIELDS; i++) {
+        while (*p == ' ') p++;
+        if (*p < '0' || *p > '9') {
+            break;  // Older kernels have fewer fields
+        }
+        while (*p >= '0' && *p <= '9') {
+            fields[i] = fields[i] * 10 + (uint64_t)(*p++ - '0');
+        }
+    }
+
+    uint64_t sum = 0;
+    for (int i = 0; i < CPU_STAT_FIELDS; i++) {
+        sum += fields[i];
+    }
+    uint64_t idle = fields[3] + fields[4];
+    *total = sum;
+    *busy = sum - idle;
+    return true;
+}
+
+// ============================================================================
+// CPU STAT FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Open /proc/stat and take the first reading
+ */
+bool cpu_stat_open(cpu_stat_t *stat) {
+    stat->fd = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+    if (stat->fd < 0) {
+        return false;
+    }
+    if (!read_jiffies(stat->fd, &stat->last_busy, &stat->last_total)) {
+        cpu_stat_close(stat);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief CPU load since the previous call
+ */
+int cpu_stat_read_load(cpu_stat_t *stat) {
+    uint64_t busy, total;
+    if (!read_jiffies(stat->fd, &busy, &total)) {
+        return -1;
+    }
+
+    uint64_t busy_delta = busy - stat->last_busy;
+    uint64_t total_delta = total - stat->last_total;
+    stat->last_busy = busy;
+    stat->last_total = total;
+    if (total_delta == 0) {
+        return 0;
+    }
+    return (int)((busy_delta * 100 + total_delta / 2) / total_delta);
+}
+
+/**
+ * @brief Close /proc/stat
+ */
+void cpu_stat_close(cpu_stat_t *stat) {
+    if (stat->fd >= 0) {
+        close(stat->fd);
+        stat->fd = -1;
+    }
+}
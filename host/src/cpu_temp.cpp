@@ -0,0 +1,179 @@
+/**
+ * @file cpu_temp.cpp
+ * @brief Implementation of the hwmon CPU temperature reader
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "cpu_temp.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// SENSOR TABLES
+// ============================================================================
+
+#define HWMON_MAX_DEVICES 32  ///< hwmonN directories probed
+#define HWMON_MAX_INPUTS  32  ///< tempN_input files probed per device
+
+/// hwmon driver names of CPU sensors, most preferred first
+static const char *const cpu_drivers[] = {
+    "coretemp", "k10temp", "zenpower", "cpu_thermal", "acpitz",
+};
+
+/// Labels of the package / die input, checked before falling back to the first input
+static const char *const package_labels[] = {
+    "Package id 0", "Tctl", "Tdie", "CPU",
+};
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Read a short sysfs attribute without the trailing newline
+ * @return true if the file exists and was read
+ */
+static bool read_attribute(const char *path, char *out, size_t size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    ssize_t length = pread(fd, out, size - 1, 0);
+    close(fd);
+    if (length < 0) {
+        return false;
+    }
+    out[length] = '\0';
+    out[strcspn(out, "\n")] = '\0';
+    return true;
+}
+
+/**
+ * @brief Preference of a hwmon driver name (lower is better, -1 = not a CPU sensor)
+ */
+static int driver_rank(const char *name) {
+    for (size_t i = 0; i < sizeof(cpu_drivers) / sizeof(cpu_drivers[0]); i++) {
+        if (strcmp(name, cpu_drivers[i]) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Pick the package input of a hwmon device
+ * @return true if the device has a temperature input
+ */
+static bool find_input(int device, char *path, size_t size) {
+    char attr[CPU_TEMP_PATH_SIZE];
+    char label[32];
+    int first = -1;
+
+    for (int input = 1; input <= HWMON_MAX_INPUTS; input++) {
+        snprintf(attr, sizeof(attr), "/sys/class/hwmon/hwmon%d/temp%d_input", device, input);
+        if (access(attr, R_OK) != 0) {
+            continue;
+        }
+        if (first < 0) {
+            first = input;
+        }
+
+        snprintf(attr, sizeof(attr), "/sys/class/hwmon/hwmon%d/temp%d_label", device, input);
+        if (!read_attribute(attr, label, sizeof(label))) {
+            continue;
+        }
+        for (size_t i = 0; i < sizeof(package_labels) / sizeof(package_labels[0]); i++) {
+            if (strcmp(label, package_labels[i]) == 0) {
+                snprintf(path, size, "/sys/class/hwmon/hwmon%d/temp%d_input", device, input);
+                return true;
+            }
+        }
+    }
+
+    if (first < 0) {
+        return false;
+    }
+    snprintf(path, size, "/sys/class/hwmon/hwmon%d/temp%d_input", device, first);
+    return true;
+}
+
+/**
+ * @brief Find the preferred CPU temperature input
+ * @return true if a sensor was found
+ */
+static bool autodetect(char *path, size_t size) {
+    char attr[CPU_TEMP_PATH_SIZE];
+    char name[32];
+    int best_device = -1;
+    int best_rank = -1;
+
+    for (int device = 0; device < HWMON_MAX_DEVICES; device++) {
+        snprintf(attr, sizeof(attr), "/sys/class/hwmon/hwmon%d/name", device);
+        if (!read_attribute(attr, name, sizeof(name))) {
+            continue;
+        }
+        int rank = driver_rank(name);
+        if (rank >= 0 && (best_rank < 0 || rank < best_rank)) {
+            best_device = device;
+            best_rank = rank;
+        }
+    }
+
+    return best_device >= 0 && find_input(best_device, path, size);
+}
+
+// ============================================================================
+// CPU TEMPERATURE FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Open a temperature sensor
+ */
+bool cpu_temp_open(cpu_temp_t *temp, const char *path) {
+    temp->fd = -1;
+    temp->path[0] = '\0';
+
+    if (path) {
+        snprintf(temp->path, sizeof(temp->path), "%s", path);
+    } else if (!autodetect(temp->path, sizeof(temp->path))) {
+        return false;
+    }
+
+    temp->fd = open(temp->path, O_RDONLY | O_CLOEXEC);
+    return temp->fd >= 0;
+}
+
+/**
+ * @brief Read the temperature
+ */
+bool cpu_temp_read(const cpu_temp_t *temp, int *celsius) {
+    char buffer[16];
+    ssize_t length = pread(temp->fd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 0) {
+        return false;
+    }
+    buffer[length] = '\0';
+
+    char *end;
+    long millidegrees = strtol(buffer, &end, 10);
+    if (end == buffer) {
+        return false;
+    }
+    *celsius = (int)((millidegrees + (millidegrees >= 0 ? 500 : -500)) / 1000);
+    return true;
+}
+
+/**
+ * @brief Close the sensor
+ */
+void cpu_temp_close(cpu_temp_t *temp) {
+    if (temp->fd >= 0) {
+        close(temp->fd);
+        temp->fd = -1;
+    }
+}
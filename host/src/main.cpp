@@ -0,0 +1,764 @@
+/**
+ * @file main.cpp
+ * @brief Host collector daemon for the ESP32-S3 PC status display
+ *
+ * Once per interval the daemon reads the CPU load and temperature and
+ * sends them to the display, either as the JSON line the firmware parses
+ *
+ *   {"time":"HH:MM:SS","cpu_load":N,"cpu_temp":N}
+ *
+ * or as a binary sample frame (--binary, see sample_protocol.h).
+ *
+ * Change-driven mode: after connecting, the daemon asks the display for
+ * its "link" capabilities. If the firmware supports keep-alives, only the
+ * fields that moved by at least the deadband (or crossed zero) are sent,
+ * as a sequenced delta update; the clock is sent as "HH:MM" when the
+ * minute changes. While nothing changes, a keep-alive is sent every
+ * heartbeat (a third of the display's blank timeout by default), which
+ * refreshes the timeout without any UI work on the display. The full
+ * state is sent after connecting, after a long silence, and whenever the
+ * display reports a sequence gap ("resync:"). Older firmware gets the
+ * fixed-rate stream.
+ *
+ * Streaming mode (--stream): every interval, down to a few milliseconds,
+ * a full sequenced update is sent under credit-based flow control. The
+ * display acknowledges accepted updates ("ack: seq=S credits=C ...") and
+ * the daemon never has more than the granted credits in flight; ticks
+ * without credit are skipped, so the next update simply carries the
+ * latest values. The display-side backlog stays bounded however busy
+ * either end is.
+ *
+ * Latency mode (--latency): JSON updates carry a "ts" stamp taken when
+ * the values were sampled. The display answers "photon: ts=T us=D" once
+ * the frame showing a stamped update is on the panel, D being its own
+ * receive-to-flush latency. While waiting for the next interval the
+ * daemon then polls the port instead of sleeping, so each echo is timed
+ * on arrival, and every LATENCY_WINDOW echoes it reports p50/p99 of the
+ * round trip and of the on-display part on stderr. The round trip also
+ * contains the echo's way back, so it bounds sample-to-photon from above.
+ *
+ * Built to cost next to nothing on a busy host: all files stay open and
+ * are read with pread(), nothing is allocated or forked after startup,
+ * and the loop sleeps on CLOCK_MONOTONIC absolute deadlines with a
+ * generous timer slack so the kernel can batch the wakeups. If the
+ * display disappears (unplugged, reset, USB re-enumeration) the port is
+ * closed and reopened on the following intervals.
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cpu_stat.h"
+#include "cpu_temp.h"
+#include "serial_port.h"
+#include "sample_protocol.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define DEFAULT_DEVICE       "/dev/ttyACM0"  ///< Display CDC port
+#define DEFAULT_INTERVAL_MS  1000            ///< Sample period
+#define MIN_INTERVAL_MS      50              ///< Shortest accepted period
+#define STREAM_MIN_INTERVAL_MS 5             ///< Shortest accepted period in streaming mode
+#define TIMER_SLACK_PERCENT  5               ///< Wakeup slack as share of the period
+#define DEFAULT_DEADBAND     2               ///< Change that triggers a sample (% load, °C)
+
+#define LINK_QUERY_INTERVAL_MS 2000  ///< Period of "link" queries until the display answers
+#define LINK_QUERY_ATTEMPTS    5     ///< Queries per connection before staying fixed-rate
+#define HEARTBEAT_DIVISOR      3     ///< Keep-alives per display blank timeout
+#define STREAM_ACK_TIMEOUT_MS  1000  ///< Re-request an ack after this long without credit
+#define LATENCY_WINDOW         64    ///< Photon echoes per latency report
+
+/**
+ * @struct options_t
+ * @brief Command line options
+ */
+typedef struct {
+    const char *device;       ///< Serial device path
+    const char *temp_path;    ///< Temperature input, NULL = autodetect
+    unsigned interval_ms;     ///< Sample period
+    unsigned deadband;        ///< Change-driven threshold
+    unsigned heartbeat_ms;    ///< Keep-alive period, 0 = from the display's blank timeout
+    bool binary;              ///< Send binary frames instead of JSON
+    bool fixed_rate;          ///< Never negotiate change-driven mode
+    bool stream;              ///< Stream full updates under credit flow control
+    bool echo;                ///< Copy display output to stdout
+    bool latency;             ///< Stamp updates and report sample-to-photon latency
+} options_t;
+
+/**
+ * @struct link_state_t
+ * @brief Negotiated mode and last transmission of the current connection
+ */
+typedef struct {
+    bool change_driven;       ///< Display supports keep-alives
+    unsigned blank_ms;        ///< Display blank timeout reported by "link"
+    unsigned queries;         ///< "link" queries sent
+    uint64_t last_query_ms;   ///< Time of the last query
+    bool sample_sent;         ///< The full state went out on this connection
+    int sent_load;            ///< Last load sent
+    int sent_temp;            ///< Last temperature sent
+    int sent_minute;          ///< Minute of the day last sent
+    uint64_t last_send_ms;    ///< Time of the last sample or keep-alive
+    bool stream_capable;      ///< Display grants credits ("stream" in the link reply)
+    unsigned credits;         ///< Updates allowed past acked_seq (0 = no ack yet)
+    uint32_t acked_seq;       ///< Last update acknowledged by the display
+    uint64_t last_ack_ms;     ///< Time of the last ack or "stream" request
+} link_state_t;
+
+/**
+ * @struct latency_window_t
+ * @brief Photon echoes collected for the next latency report
+ */
+typedef struct {
+    uint32_t round_trip_us[LATENCY_WINDOW];  ///< Sampling to echo received (host clock)
+    uint32_t display_us[LATENCY_WINDOW];     ///< Receive to photon reported by the display
+    unsigned count;                          ///< Echoes collected
+} latency_window_t;
+
+/// Delta field bits of the metrics sent by this daemon
+#define FIELD_TEMP SAMPLE_DELTA_METRIC(SAMPLE_METRIC_CPU_TEMP)
+#define FIELD_LOAD SAMPLE_DELTA_METRIC(SAMPLE_METRIC_CPU_LOAD)
+#define FIELD_ALL  (SAMPLE_DELTA_TIME | FIELD_TEMP | FIELD_LOAD)
+
+static volatile sig_atomic_t stop_requested = 0;  ///< Set by SIGINT / SIGTERM
+static link_state_t link_state;                   ///< State of the open connection
+static uint32_t next_seq = 1;                     ///< Sequence number of the next delta update
+static uint32_t sample_ts = 0;                    ///< Stamp of the values being sent (--latency)
+static latency_window_t latency_window;           ///< Echoes of the current latency report
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Signal handler - ends the main loop
+ */
+static void handle_stop(int) {
+    stop_requested = 1;
+}
+
+/**
+ * @brief Print the usage text
+ */
+static void print_usage(const char *program) {
+    printf("Usage: %s [options]\n"
+           "  -d, --device PATH     display serial port (default " DEFAULT_DEVICE ")\n"
+           "  -i, --interval MS     sample period in ms (default %d)\n"
+           "  -t, --temp PATH       hwmon temp*_input file (default: autodetect)\n"
+           "  -b, --binary          send binary sample frames instead of JSON\n"
+           "  -D, --deadband N      change that triggers a sample, %% load and degC (default %d)\n"
+           "  -k, --heartbeat MS    keep-alive period (default: display blank timeout / %d)\n"
+           "  -f, --fixed-rate      send every sample, never negotiate change-driven mode\n"
+           "  -s, --stream          full updates every interval with credit flow control\n"
+           "  -e, --echo            copy display output to stdout\n"
+           "  -l, --latency         stamp updates, report sample-to-photon latency every %d echoes\n"
+           "  -h, --help            show this help\n",
+           program, DEFAULT_INTERVAL_MS, DEFAULT_DEADBAND, HEARTBEAT_DIVISOR, LATENCY_WINDOW);
+}
+
+/**
+ * @brief Parse an unsigned option value within [min, max]
+ * @return false (with a message) if the value is invalid
+ */
+static bool parse_unsigned(const char *name, const char *text, unsigned min, unsigned max, unsigned *out) {
+    char *end;
+    unsigned long value = strtoul(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || value < min || value > max) {
+        fprintf(stderr, "Invalid %s: %s (%u-%u)\n", name, text, min, max);
+        return false;
+    }
+    *out = (unsigned)value;
+    return true;
+}
+
+/**
+ * @brief Parse the command line
+ * @return false if the program should exit
+ */
+static bool parse_options(int argc, char **argv, options_t *options, int *exit_code) {
+    static const struct option long_options[] = {
+        { "device",     required_argument, NULL, 'd' },
+        { "interval",   required_argument, NULL, 'i' },
+        { "temp",       required_argument, NULL, 't' },
+        { "binary",     no_argument,       NULL, 'b' },
+        { "deadband",   required_argument, NULL, 'D' },
+        { "heartbeat",  required_argument, NULL, 'k' },
+        { "fixed-rate", no_argument,       NULL, 'f' },
+        { "stream",     no_argument,       NULL, 's' },
+        { "echo",       no_argument,       NULL, 'e' },
+        { "latency",    no_argument,       NULL, 'l' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+
+    options->device = DEFAULT_DEVICE;
+    options->temp_path = NULL;
+    options->interval_ms = DEFAULT_INTERVAL_MS;
+    options->deadband = DEFAULT_DEADBAND;
+    options->heartbeat_ms = 0;
+    options->binary = false;
+    options->fixed_rate = false;
+    options->stream = false;
+    options->echo = false;
+    options->latency = false;
+
+    *exit_code = EXIT_FAILURE;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "d:i:t:bD:k:fselh", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'd': options->device = optarg; break;
+            case 't': options->temp_path = optarg; break;
+            case 'b': options->binary = true; break;
+            case 'f': options->fixed_rate = true; break;
+            case 's': options->stream = true; break;
+            case 'e': options->echo = true; break;
+            case 'l': options->latency = true; break;
+            case 'i':
+                if (!parse_unsigned("interval", optarg, STREAM_MIN_INTERVAL_MS, 60000, &options->interval_ms)) {
+                    return false;
+                }
+                break;
+            case 'D':
+                if (!parse_unsigned("deadband", optarg, 0, 100, &options->deadband)) {
+                    return false;
+                }
+                break;
+            case 'k':
+                if (!parse_unsigned("heartbeat", optarg, 1000, 3600000, &options->heartbeat_ms)) {
+                    return false;
+                }
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                *exit_code = EXIT_SUCCESS;
+                return false;
+            default:
+                print_usage(argv[0]);
+                return false;
+        }
+    }
+    if (options->stream && options->fixed_rate) {
+        fprintf(stderr, "--stream and --fixed-rate exclude each other\n");
+        return false;
+    }
+    if (options->latency && options->binary) {
+        fprintf(stderr, "--latency needs JSON updates, not --binary\n");
+        return false;
+    }
+    if (!options->stream && options->interval_ms < MIN_INTERVAL_MS) {
+        fprintf(stderr, "Invalid interval: %u (%d-60000, or %d with --stream)\n",
+                options->interval_ms, MIN_INTERVAL_MS, STREAM_MIN_INTERVAL_MS);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Monotonic time in milliseconds
+ */
+static uint64_t monotonic_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)(now.tv_nsec / 1000000);
+}
+
+/**
+ * @brief Monotonic time in microseconds, low 32 bits (the "ts" stamp)
+ */
+static uint32_t monotonic_us() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000 + (uint64_t)(now.tv_nsec / 1000));
+}
+
+/**
+ * @brief qsort() comparison of two uint32_t
+ */
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Value at a percentile (1-100) of values, sorting them in place
+ */
+static uint32_t percentile_us(uint32_t *values, unsigned count, unsigned percent) {
+    qsort(values, count, sizeof(values[0]), compare_u32);
+    unsigned rank = (count * percent + 99) / 100;
+    return values[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * @brief Collect a "photon: ts=T us=D" echo and report a full window
+ */
+static void handle_photon(const char *line) {
+    const char *ts_text = strstr(line, " ts=");
+    const char *us_text = strstr(line, " us=");
+    if (!ts_text || !us_text) {
+        return;
+    }
+    uint32_t round_trip = monotonic_us() - (uint32_t)strtoul(ts_text + 4, NULL, 10);
+    latency_window.round_trip_us[latency_window.count] = round_trip;
+    latency_window.display_us[latency_window.count] = (uint32_t)strtoul(us_text + 4, NULL, 10);
+    if (++latency_window.count < LATENCY_WINDOW) {
+        return;
+    }
+
+    unsigned count = latency_window.count;
+    latency_window.count = 0;
+    fprintf(stderr, "Latency over %u updates: sample to photon echo p50 %lu us, p99 %lu us; "
+            "on display p50 %lu us, p99 %lu us\n", count,
+            (unsigned long)percentile_us(latency_window.round_trip_us, count, 50),
+            (unsigned long)percentile_us(latency_window.round_trip_us, count, 99),
+            (unsigned long)percentile_us(latency_window.display_us, count, 50),
+            (unsigned long)percentile_us(latency_window.display_us, count, 99));
+}
+
+/**
+ * @brief Handle a line from the display
+ *
+ * Picks up the "link" reply ("link: keepalive stream blank_timeout_ms=N ..."),
+ * full-state requests ("resync: ..."), credit acks ("ack: seq=S credits=C")
+ * and latency echoes ("photon: ts=T us=D").
+ */
+static void handle_display_line(const char *line) {
+    if (strncmp(line, "photon:", 7) == 0) {
+        handle_photon(line);
+        return;
+    }
+    if (strncmp(line, "resync:", 7) == 0) {
+        link_state.sample_sent = false;
+        return;
+    }
+    if (strncmp(line, "ack:", 4) == 0) {
+        const char *seq_text = strstr(line, " seq=");
+        const char *credits_text = strstr(line, " credits=");
+        if (!seq_text || !credits_text) {
+            return;
+        }
+        uint32_t seq = (uint32_t)strtoul(seq_text + 5, NULL, 10);
+        uint32_t last_sent = next_seq - 1;
+        if (link_state.credits == 0) {
+            link_state.acked_seq = last_sent;  // First ack opens the window from here
+        } else if ((int32_t)(seq - link_state.acked_seq) > 0 && (int32_t)(last_sent - seq) >= 0) {
+            link_state.acked_seq = seq;
+        }
+        unsigned long credits = strtoul(credits_text + 9, NULL, 10);
+        link_state.credits = credits > 0 ? (unsigned)credits : 1;
+        link_state.last_ack_ms = monotonic_ms();
+        return;
+    }
+    if (link_state.change_driven || strncmp(line, "link:", 5) != 0 || !strstr(line, " keepalive")) {
+        return;
+    }
+    const char *blank = strstr(line, "blank_timeout_ms=");
+    unsigned long blank_ms = blank ? strtoul(blank + 17, NULL, 10) : 0;
+    if (blank_ms < 1000) {
+        return;
+    }
+    link_state.change_driven = true;
+    link_state.blank_ms = (unsigned)blank_ms;
+    link_state.stream_capable = strstr(line, " stream") != NULL;
+}
+
+/**
+ * @brief Encode a full fixed-rate sample into out
+ * @return Number of bytes to send
+ */
+static size_t format_sample(const options_t *options, const struct tm *local,
+                            int load, int temp, uint8_t *out, size_t size) {
+    if (options->binary) {
+        sample_frame_payload_t payload;
+        payload.hour = (uint8_t)local->tm_hour;
+        payload.minute = (uint8_t)local->tm_min;
+        payload.second = (uint8_t)local->tm_sec;
+        payload.cpu_load = (uint8_t)load;
+        payload.cpu_temp = (int16_t)temp;
+        return sample_frame_encode(out, SAMPLE_FRAME_TYPE_SAMPLE, &payload, sizeof(payload));
+    }
+
+    char *text = (char *)out;
+    int n = snprintf(text, size, "{\"time\":\"%02d:%02d:%02d\",\"cpu_load\":%d,\"cpu_temp\":%d",
+                     local->tm_hour, local->tm_min, local->tm_sec, load, temp);
+    if (options->latency) {
+        n += snprintf(text + n, size - n, ",\"ts\":%lu", (unsigned long)sample_ts);
+    }
+    n += snprintf(text + n, size - n, "}\n");
+    return n > 0 && (size_t)n < size ? (size_t)n : 0;
+}
+
+/**
+ * @brief Encode a sequenced delta update of the given fields into out
+ *
+ * The clock is sent as "HH:MM", or "HH:MM:SS" with seconds; binary deltas
+ * list the fields in bit order (see delta_frame_header_t). The update is
+ * numbered next_seq, which send_message() only uses up once it is queued.
+ *
+ * @return Number of bytes to send
+ */
+static size_t format_delta(const options_t *options, const struct tm *local, uint16_t fields,
+                           bool seconds, int load, int temp, uint8_t *out, size_t size) {
+    uint32_t seq = next_seq;
+
+    if (options->binary) {
+        uint8_t payload[sizeof(delta_frame_header_t) + 3 + 2 * sizeof(int16_t)];
+        delta_frame_header_t header = { seq, fields };
+        memcpy(payload, &header, sizeof(header));
+        size_t n = sizeof(header);
+        if (fields & SAMPLE_DELTA_TIME) {
+            payload[n++] = (uint8_t)local->tm_hour;
+            payload[n++] = (uint8_t)local->tm_min;
+            payload[n++] = seconds ? (uint8_t)local->tm_sec : SAMPLE_FRAME_NO_SECONDS;
+        }
+        // Metric values in wire order: cpu_temp (0), then cpu_load (1)
+        int16_t values[2] = { (int16_t)temp, (int16_t)load };
+        uint16_t bits[2] = { FIELD_TEMP, FIELD_LOAD };
+        for (int i = 0; i < 2; i++) {
+            if (fields & bits[i]) {
+                payload[n++] = (uint8_t)(values[i] & 0xFF);
+                payload[n++] = (uint8_t)((uint16_t)values[i] >> 8);
+            }
+        }
+        return sample_frame_encode(out, SAMPLE_FRAME_TYPE_DELTA, payload, (uint8_t)n);
+    }
+
+    char *text = (char *)out;
+    int n = snprintf(text, size, "{\"seq\":%lu", (unsigned long)seq);
+    if (options->latency) {
+        n += snprintf(text + n, size - n, ",\"ts\":%lu", (unsigned long)sample_ts);
+    }
+    if (fields & SAMPLE_DELTA_TIME) {
+        if (seconds) {
+            n += snprintf(text + n, size - n, ",\"time\":\"%02d:%02d:%02d\"",
+                          local->tm_hour, local->tm_min, local->tm_sec);
+        } else {
+            n += snprintf(text + n, size - n, ",\"time\":\"%02d:%02d\"", local->tm_hour, local->tm_min);
+        }
+    }
+    if (fields & FIELD_LOAD) {
+        n += snprintf(text + n, size - n, ",\"cpu_load\":%d", load);
+    }
+    if (fields & FIELD_TEMP) {
+        n += snprintf(text + n, size - n, ",\"cpu_temp\":%d", temp);
+    }
+    n += snprintf(text + n, size - n, "}\n");
+    return n > 0 && (size_t)n < size ? (size_t)n : 0;
+}
+
+/**
+ * @brief Encode a keep-alive into out
+ * @return Number of bytes to send
+ */
+static size_t format_keepalive(const options_t *options, uint8_t *out) {
+    if (options->binary) {
+        return sample_frame_encode(out, SAMPLE_FRAME_TYPE_KEEPALIVE, NULL, 0);
+    }
+    memcpy(out, "keepalive\n", 10);
+    return 10;
+}
+
+/**
+ * @brief Send an encoded message
+ * @param sequenced The message is a delta update numbered next_seq
+ * @return Write result; an empty message counts as dropped
+ */
+static serial_write_result_t send_message(serial_port_t *port, const uint8_t *message, size_t length,
+                                          bool sequenced) {
+    if (length == 0) {
+        return SERIAL_WRITE_DROPPED;
+    }
+    serial_write_result_t result = serial_port_write(port, message, length);
+    if (result == SERIAL_WRITE_SENT && sequenced) {
+        next_seq++;  // A dropped update never went out, so its number is reused
+    }
+    return result;
+}
+
+/**
+ * @brief Check whether a value moved enough to be sent
+ */
+static bool value_moved(int value, int sent, unsigned deadband) {
+    int delta = value > sent ? value - sent : sent - value;
+    return (unsigned)delta >= deadband || (value == 0) != (sent == 0);
+}
+
+/**
+ * @brief Send a "link" query while the display has not answered yet
+ * @return false if the device is gone
+ */
+static bool query_link(const options_t *options, serial_port_t *port, uint64_t now_ms) {
+    if (options->fixed_rate || link_state.change_driven || link_state.queries >= LINK_QUERY_ATTEMPTS) {
+        return true;
+    }
+    if (link_state.queries > 0 && now_ms - link_state.last_query_ms < LINK_QUERY_INTERVAL_MS) {
+        return true;
+    }
+    link_state.queries++;
+    link_state.last_query_ms = now_ms;
+    return serial_port_write(port, "link\n", 5) != SERIAL_WRITE_GONE;
+}
+
+/**
+ * @brief Send a full update if the display granted credit for it
+ *
+ * The first ack is requested with "stream"; the request is repeated if
+ * the window stays closed for STREAM_ACK_TIMEOUT_MS (lost ack, display
+ * reset), which also reopens it.
+ *
+ * @return false if the device is gone
+ */
+static bool send_stream_tick(const options_t *options, serial_port_t *port, uint64_t now_ms,
+                             const struct tm *local, int load, int temp) {
+    uint32_t in_flight = (next_seq - 1) - link_state.acked_seq;
+    if (link_state.credits == 0 || in_flight >= link_state.credits) {
+        if (link_state.last_ack_ms != 0 && now_ms - link_state.last_ack_ms < STREAM_ACK_TIMEOUT_MS) {
+            return true;  // Skipped: the next update carries the latest values
+        }
+        link_state.last_ack_ms = now_ms;
+        return serial_port_write(port, "stream\n", 7) != SERIAL_WRITE_GONE;
+    }
+
+    uint8_t message[SAMPLE_FRAME_MAX_SIZE + 64];
+    size_t length = format_delta(options, local, FIELD_ALL, true, load, temp, message, sizeof(message));
+    serial_write_result_t result = send_message(port, message, length, true);
+    if (result == SERIAL_WRITE_SENT) {
+        link_state.sample_sent = true;
+        link_state.last_send_ms = now_ms;
+    }
+    return result != SERIAL_WRITE_GONE;
+}
+
+/**
+ * @brief Send what the current mode needs for this tick
+ * @return false if the device is gone
+ */
+static bool send_tick(const options_t *options, serial_port_t *port, uint64_t now_ms, int load, int temp) {
+    uint8_t message[SAMPLE_FRAME_MAX_SIZE + 64];
+    time_t now = time(NULL);
+    struct tm local;
+    localtime_r(&now, &local);
+    int minute = local.tm_hour * 60 + local.tm_min;
+
+    if (options->stream && link_state.stream_capable) {
+        return send_stream_tick(options, port, now_ms, &local, load, temp);
+    }
+
+    size_t length;
+    if (!link_state.change_driven) {
+        // Without credits, a streaming interval is too fast for the display
+        if (link_state.last_send_ms != 0 && now_ms - link_state.last_send_ms < MIN_INTERVAL_MS) {
+            return true;
+        }
+        length = format_sample(options, &local, load, temp, message, sizeof(message));
+        link_state.last_send_ms = now_ms;
+        return send_message(port, message, length, false) != SERIAL_WRITE_GONE;
+    }
+
+    uint16_t fields = 0;
+    if (!link_state.sample_sent || now_ms - link_state.last_send_ms >= link_state.blank_ms) {
+        fields = FIELD_ALL;  // New connection, resync request, or the display may have blanked
+    } else {
+        if (minute != link_state.sent_minute) fields |= SAMPLE_DELTA_TIME;
+        if (value_moved(load, link_state.sent_load, options->deadband)) fields |= FIELD_LOAD;
+        if (value_moved(temp, link_state.sent_temp, options->deadband)) fields |= FIELD_TEMP;
+    }
+
+    serial_write_result_t result;
+    if (fields) {
+        length = format_delta(options, &local, fields, false, load, temp, message, sizeof(message));
+        result = send_message(port, message, length, true);
+        if (result == SERIAL_WRITE_SENT) {
+            // A dropped update leaves the sent state alone, so it is retried next tick
+            link_state.sample_sent = true;
+            if (fields & SAMPLE_DELTA_TIME) link_state.sent_minute = minute;
+            if (fields & FIELD_LOAD) link_state.sent_load = load;
+            if (fields & FIELD_TEMP) link_state.sent_temp = temp;
+        }
+    } else {
+        unsigned heartbeat_ms = options->heartbeat_ms ? options->heartbeat_ms
+                                                      : link_state.blank_ms / HEARTBEAT_DIVISOR;
+        if (now_ms - link_state.last_send_ms < heartbeat_ms) {
+            return true;
+        }
+        length = format_keepalive(options, message);
+        result = send_message(port, message, length, false);
+    }
+
+    if (result == SERIAL_WRITE_SENT) {
+        link_state.last_send_ms = now_ms;
+    }
+    return result != SERIAL_WRITE_GONE;
+}
+
+/**
+ * @brief Advance an absolute deadline by ms
+ */
+static void advance_deadline(struct timespec *deadline, unsigned ms) {
+    deadline->tv_sec += ms / 1000;
+    deadline->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief Wait for an absolute deadline
+ *
+ * In latency mode photon echoes are handled as they arrive while waiting;
+ * otherwise the daemon just sleeps and reads the display once per tick.
+ *
+ * @return false if interrupted by a signal
+ */
+static bool wait_for_deadline(const options_t *options, serial_port_t *port, int echo_fd,
+                              const struct timespec *deadline) {
+    while (options->latency && serial_port_is_open(port)) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int64_t remaining_ms = (int64_t)(deadline->tv_sec - now.tv_sec) * 1000 +
+                               (deadline->tv_nsec - now.tv_nsec) / 1000000;
+        if (remaining_ms <= 0) {
+            return true;
+        }
+        struct pollfd fds = { port->fd, POLLIN, 0 };
+        int ready = poll(&fds, 1, (int)remaining_ms);
+        if (ready < 0) {
+            return errno != EINTR;
+        }
+        if (ready > 0 && !serial_port_drain(port, echo_fd, handle_display_line)) {
+            fprintf(stderr, "Lost %s, reconnecting\n", options->device);
+        }
+    }
+    return clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) != EINTR;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    options_t options;
+    int exit_code;
+    if (!parse_options(argc, argv, &options, &exit_code)) {
+        return exit_code;
+    }
+
+    cpu_stat_t cpu_stat;
+    if (!cpu_stat_open(&cpu_stat)) {
+        fprintf(stderr, "Cannot read /proc/stat: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    cpu_temp_t cpu_temp;
+    if (cpu_temp_open(&cpu_temp, options.temp_path)) {
+        fprintf(stderr, "Temperature sensor: %s\n", cpu_temp.path);
+    } else {
+        fprintf(stderr, "No CPU temperature sensor%s%s - sending 0\n",
+                cpu_temp.path[0] ? " at " : "", cpu_temp.path);
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    // Let the kernel batch our wakeups with others
+    prctl(PR_SET_TIMERSLACK, (unsigned long)options.interval_ms * TIMER_SLACK_PERCENT * 10000UL, 0, 0, 0);
+
+    serial_port_t port;
+    port.fd = -1;
+    bool reported_missing = false;
+    bool reported_mode = false;
+    int echo_fd = options.echo ? STDOUT_FILENO : -1;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    while (!stop_requested) {
+        advance_deadline(&deadline, options.interval_ms);
+        if (!wait_for_deadline(&options, &port, echo_fd, &deadline)) {
+            continue;
+        }
+
+        // After a suspend, restart from now instead of catching up
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (now.tv_sec > deadline.tv_sec + 1 + (time_t)(options.interval_ms / 1000)) {
+            deadline = now;
+        }
+
+        int load = cpu_stat_read_load(&cpu_stat);
+        int temp = 0;
+        if (cpu_temp.fd >= 0 && !cpu_temp_read(&cpu_temp, &temp)) {
+            temp = 0;
+        }
+        if (load < 0) {
+            continue;
+        }
+        sample_ts = monotonic_us();
+
+        if (!serial_port_is_open(&port)) {
+            if (!serial_port_open(&port, options.device)) {
+                if (!reported_missing) {
+                    fprintf(stderr, "Waiting for %s: %s\n", options.device, strerror(errno));
+                    reported_missing = true;
+                }
+                continue;
+            }
+            fprintf(stderr, "Connected to %s\n", options.device);
+            reported_missing = false;
+            reported_mode = false;
+            memset(&link_state, 0, sizeof(link_state));
+            latency_window.count = 0;
+        }
+
+        uint64_t now_ms = monotonic_ms();
+        if (!serial_port_drain(&port, echo_fd, handle_display_line) ||
+            !query_link(&options, &port, now_ms) ||
+            !send_tick(&options, &port, now_ms, load, temp)) {
+            fprintf(stderr, "Lost %s, reconnecting\n", options.device);
+            continue;
+        }
+
+        bool streaming = options.stream && link_state.stream_capable;
+        if (streaming && link_state.credits > 0 && !reported_mode) {
+            fprintf(stderr, "Streaming mode: every %u ms, %u updates in flight\n",
+                    options.interval_ms, link_state.credits);
+            reported_mode = true;
+        } else if (link_state.change_driven && !streaming && !reported_mode) {
+            if (options.stream) {
+                fprintf(stderr, "Display has no credit flow control, not streaming\n");
+            }
+            unsigned heartbeat_ms = options.heartbeat_ms ? options.heartbeat_ms
+                                                         : link_state.blank_ms / HEARTBEAT_DIVISOR;
+            fprintf(stderr, "Change-driven mode: deadband %u, keep-alive every %u ms\n",
+                    options.deadband, heartbeat_ms);
+            reported_mode = true;
+        }
+    }
+
+    if (options.stream && link_state.credits > 0 && serial_port_is_open(&port)) {
+        serial_port_write(&port, "stream off\n", 11);
+    }
+    serial_port_close(&port);
+    cpu_temp_close(&cpu_temp);
+    cpu_stat_close(&cpu_stat);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file serial_port.cpp
+ * @brief Implementation of the display serial link
+ *
+ * @author ESP32-S3 Display Project
+ * @date 2025
+ */
+
+#include "serial_port.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Check whether an errno means the device is gone
+ */
+static bool is_disconnect(int error) {
+    return error == EIO || error == ENXIO || error == ENODEV || error == EPIPE || error == EBADF;
+}
+
+/**
+ * @brief Assemble received bytes into lines and hand them to handler
+ *
+ * '\r' is dropped and overlong lines are cut at SERIAL_PORT_LINE_SIZE - 1.
+ */
+static void feed_lines(serial_port_t *port, const char *data, size_t length, serial_line_handler_t handler) {
+    for (size_t i = 0; i < length; i++) {
+        char c = data[i];
+        if (c == '\n') {
+            port->line[port->line_length] = '\0';
+            handler(port->line);
+            port->line_length = 0;
+        } else if (c != '\r' && port->line_length < sizeof(port->line) - 1) {
+            port->line[port->line_length++] = c;
+        }
+    }
+}
+
+// ============================================================================
+// SERIAL PORT FUNCTIONS
+// ============================================================================
+
+/**
+ * @brief Open and configure the device
+ */
+bool serial_port_open(serial_port_t *port, const char *device) {
+    port->line_length = 0;
+    port->line_broken = false;
+    port->fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (port->fd < 0) {
+        return false;
+    }
+
+    struct termios tio;
+    if (tcgetattr(port->fd, &tio) != 0) {
+        serial_port_close(port);
+        return false;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CRTSCTS | HUPCL);
+    if (tcsetattr(port->fd, TCSANOW, &tio) != 0) {
+        serial_port_close(port);
+        return false;
+    }
+
+    // Discard whatever the display printed before we connected
+    tcflush(port->fd, TCIFLUSH);
+    return true;
+}
+
+/**
+ * @brief Check whether the port is open
+ */
+bool serial_port_is_open(const serial_port_t *port) {
+    return port->fd >= 0;
+}
+
+/**
+ * @brief Write all bytes, waiting briefly for room in the kernel buffer
+ * @return Result; on SERIAL_WRITE_DROPPED *sent bytes went out
+ */
+static serial_write_result_t write_all(serial_port_t *port, const uint8_t *bytes, size_t length, size_t *sent) {
+    *sent = 0;
+    while (*sent < length) {
+        ssize_t written = write(port->fd, bytes + *sent, length - *sent);
+        if (written > 0) {
+            *sent += (size_t)written;
+            continue;
+        }
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0 && errno == EAGAIN) {
+            struct pollfd fds = { port->fd, POLLOUT, 0 };
+            if (poll(&fds, 1, SERIAL_PORT_WRITE_WAIT_MS) > 0) {
+                continue;
+            }
+            return SERIAL_WRITE_DROPPED;
+        }
+        if (written < 0 && is_disconnect(errno)) {
+            serial_port_close(port);
+            return SERIAL_WRITE_GONE;
+        }
+        return SERIAL_WRITE_DROPPED;
+    }
+    return SERIAL_WRITE_SENT;
+}
+
+/**
+ * @brief Write one complete message
+ */
+serial_write_result_t serial_port_write(serial_port_t *port, const void *data, size_t length) {
+    // Do not start a message the display is not reading
+    int queued = 0;
+    if (ioctl(port->fd, TIOCOUTQ, &queued) == 0 && queued > SERIAL_PORT_MAX_QUEUED) {
+        return SERIAL_WRITE_DROPPED;
+    }
+
+    size_t sent;
+    serial_write_result_t result;
+    if (port->line_broken) {
+        result = write_all(port, (const uint8_t *)"\n", 1, &sent);
+        if (result != SERIAL_WRITE_SENT) {
+            return result;
+        }
+        port->line_broken = false;
+    }
+
+    result = write_all(port, (const uint8_t *)data, length, &sent);
+    if (result == SERIAL_WRITE_DROPPED && sent > 0) {
+        port->line_broken = true;  // Terminate the fragment before the next message
+    }
+    return result;
+}
+
+/**
+ * @brief Read pending input from the display
+ */
+bool serial_port_drain(serial_port_t *port, int echo_fd, serial_line_handler_t handler) {
+    char buffer[512];
+    for (;;) {
+        ssize_t length = read(port->fd, buffer, sizeof(buffer));
+        if (length > 0) {
+            if (echo_fd >= 0 && write(echo_fd, buffer, (size_t)length) < 0) {
+                echo_fd = -1;
+            }
+            if (handler) {
+                feed_lines(port, buffer, (size_t)length, handler);
+            }
+            continue;
+        }
+        if (length < 0 && (errno == EAGAIN || errno == EINTR)) {
+            return true;
+        }
+        // EOF or a hard error: the device was unplugged
+        serial_port_close(port);
+        return false;
+    }
+}
+
+/**
+ * @brief Close the port
+ */
+void serial_port_close(serial_port_t *port) {
+    if (port->fd >= 0) {
+        close(port->fd);
+        port->fd = -1;
+    }
+}